@@ -0,0 +1,102 @@
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/RolloutRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Flies many landers over many seeds with no window, on 1 up to every hardware thread,
+// and reports the outcomes, rollouts per second and how well the rate scales with the threads.
+//
+// lander_rollouts [seeds] [rollouts per seed] [max steps]
+
+namespace
+{
+// Tilts one way or the other, burns to drift sideways off the space station, then keeps the nose
+// up and holds the descent near a speed. The rollout picks the side, the burn and the speed
+ShipInput driftAndDescend(const LanderSimulation& simulation, const size_t rollout, const int step)
+{
+    const Spaceship& ship { simulation.getShip() };
+    float angle { ship.getNoseAngle() };
+    std::int8_t side { static_cast<std::int8_t>(rollout % 2 == 0 ? 1 : -1) };
+    int burn { 20 + static_cast<int>(rollout / 2 % 16) * 5 };
+    if (step < 45)
+    {
+        return ShipInput { side, false };
+    }
+    if (step < 45 + burn)
+    {
+        return ShipInput { 0, true };
+    }
+
+    std::int8_t upright { static_cast<std::int8_t>(angle == 0.0f ? 0 : (angle < 180.0f ? -1 : 1)) };
+    float descent { 0.2f + 0.05f * static_cast<float>(rollout / 32 % 8) };
+    return ShipInput { upright, ship.getVelY() > descent };
+}
+
+double runSeconds(RolloutRunner& runner, const std::vector<unsigned int>& seeds, const int maxSteps)
+{
+    auto start { std::chrono::steady_clock::now() };
+    runner.run(seeds, maxSteps, driftAndDescend);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+int main(int argc, char* args[])
+{
+    size_t seedCount { argc > 1 ? std::strtoul(args[1], nullptr, 10) : 32 };
+    size_t rolloutsPerSeed { argc > 2 ? std::strtoul(args[2], nullptr, 10) : 64 };
+    int maxSteps { argc > 3 ? std::atoi(args[3]) : 60 * 60 };
+
+    // every world a worker generates logs to std::cout, from several threads at once. The report is printf'd
+    std::cout.setstate(std::ios_base::badbit);
+
+    TerrainGenerationConfig config { makeWorldConfig(0, static_cast<size_t>(WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+    int landingPads { WORLD_WIDTH / SCREEN_WIDTH };
+
+    // the rollouts of a seed are listed together so they share the world in a worker's cache
+    std::vector<unsigned int> seeds {};
+    for (size_t seed = 1; seed <= seedCount; seed++)
+    {
+        seeds.insert(seeds.end(), rolloutsPerSeed, static_cast<unsigned int>(seed));
+    }
+    printf("%zu rollouts over %zu seeds, at most %d steps each\n\n", seeds.size(), seedCount, maxSteps);
+
+    size_t hardwareThreads { std::max<size_t>(1, std::thread::hardware_concurrency()) };
+    std::vector<size_t> threadCounts {};
+    for (size_t threads = 1; threads < hardwareThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    // the table is printed once every run is done
+    std::vector<double> rates {};
+    std::vector<size_t> worldsGenerated {};
+    RolloutSummary summary {};
+    for (size_t threads : threadCounts)
+    {
+        RolloutRunner runner { config, landingPads, threads };
+        double seconds { runSeconds(runner, seeds, maxSteps) };
+        rates.push_back(static_cast<double>(seeds.size()) / seconds);
+        worldsGenerated.push_back(runner.getWorldsGenerated());
+        summary = runner.getSummary();
+    }
+
+    printf("\n%8s %14s %10s %11s %8s\n", "threads", "rollouts/s", "speedup", "efficiency", "worlds");
+    for (size_t i = 0; i < threadCounts.size(); i++)
+    {
+        double speedup { rates[i] / rates[0] };
+        printf("%8zu %14.1f %9.2fx %10.0f%% %8zu\n", threadCounts[i], rates[i], speedup,
+            100.0 * speedup / static_cast<double>(threadCounts[i]), worldsGenerated[i]);
+    }
+
+    size_t rollouts { std::max<size_t>(1, summary.getRollouts()) };
+    printf("\nlanded %zu, crashed %zu, timed out %zu\n", summary.landed, summary.crashed, summary.timedOut);
+    printf("mean steps %.1f, mean fuel %.3f\n", static_cast<double>(summary.steps) / static_cast<double>(rollouts),
+        summary.fuel / static_cast<double>(rollouts));
+    return 0;
+}
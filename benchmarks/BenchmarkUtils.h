@@ -0,0 +1,37 @@
+#ifndef BENCHMARKUTILS_H
+#define BENCHMARKUTILS_H
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// Keeps the optimiser from discarding work whose result is otherwise unused
+template <typename T>
+inline volatile T gBenchmarkSink {};
+
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+    gBenchmarkSink<T> = value;
+}
+
+// Runs fn the given number of times and returns the mean wall time per run in nanoseconds
+template <typename Function>
+double measureNanoseconds(Function&& fn, const size_t iterations)
+{
+    auto start { std::chrono::steady_clock::now() };
+    for (size_t i = 0; i < iterations; i++)
+    {
+        fn();
+    }
+    auto elapsed { std::chrono::steady_clock::now() - start };
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+        / static_cast<double>(iterations);
+}
+
+inline void printResult(const std::string& name, const double nanoseconds)
+{
+    printf("%-48s %14.1f ns\n", name.c_str(), nanoseconds);
+}
+
+#endif // BENCHMARKUTILS_H
@@ -0,0 +1,53 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Autopilot.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LanderSimulation.h"
+#include <algorithm>
+#include <chrono>
+
+// The autopilot flying whole flights with the game's settings, one world per seed, until it lands,
+// crashes or a minute of game time runs out. Reports how often it lands, how fast it searches, and
+// how long the slowest decision took against a 60 Hz frame
+int main()
+{
+    constexpr unsigned int SEEDS { 12 };
+    constexpr int MAX_STEPS { 60 * 60 };
+    TerrainGenerationConfig config { makeWorldConfig(0, static_cast<size_t>(WORLD_WIDTH), false) };
+    AutopilotConfig autopilotConfig { AUTOPILOT_BEAM_WIDTH, AUTOPILOT_HORIZON, AUTOPILOT_STEPS_PER_DECISION, AUTOPILOT_BUDGET_MILLISECONDS };
+
+    size_t landed { 0 };
+    size_t crashed { 0 };
+    size_t steps { 0 };
+    double slowestDecision { 0.0 };
+    AutopilotStats totals { 0, 0, 0.0, 0 };
+    for (unsigned int seed = 1; seed <= SEEDS; seed++)
+    {
+        config.seed = seed;
+        LanderSimulation simulation { SPACESHIP_WIDTH, SPACESHIP_HEIGHT, SPACESTATION_WIDTH, SPACESTATION_HEIGHT };
+        simulation.createWorld(config, WORLD_WIDTH / SCREEN_WIDTH);
+        Autopilot autopilot { SPACESHIP_WIDTH, SPACESHIP_HEIGHT, autopilotConfig };
+        for (int step = 0; step < MAX_STEPS && !simulation.isCrashed() && !simulation.isLanded(); step++)
+        {
+            double before { autopilot.getStats().seconds };
+            simulation.step(autopilot.control(simulation));
+            slowestDecision = std::max(slowestDecision, autopilot.getStats().seconds - before);
+            steps++;
+        }
+        landed += simulation.isLanded() ? 1u : 0u;
+        crashed += simulation.isCrashed() ? 1u : 0u;
+
+        const AutopilotStats& stats { autopilot.getStats() };
+        totals.decisions += stats.decisions;
+        totals.nodes += stats.nodes;
+        totals.seconds += stats.seconds;
+    }
+
+    printf("%-48s %14u of %u\n", "landed", static_cast<unsigned int>(landed), SEEDS);
+    printf("%-48s %14u of %u\n", "crashed", static_cast<unsigned int>(crashed), SEEDS);
+    printf("%-48s %14.1f\n", "mean steps to the end of a flight", static_cast<double>(steps) / SEEDS);
+    printf("%-48s %14.2f M/s\n", "search nodes", totals.getNodesPerSecond() / 1e6);
+    printResult("decision, mean", totals.seconds * 1e9 / static_cast<double>(std::max<std::uint64_t>(totals.decisions, 1)));
+    printResult("decision, slowest", slowestDecision * 1e9);
+    printResult("60 Hz frame", 1e9 / 60.0);
+    return 0;
+}
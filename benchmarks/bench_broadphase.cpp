@@ -0,0 +1,68 @@
+#include "BenchmarkUtils.h"
+#include "engine/SpatialHash.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+// One frame of body against body tests for 10 to 100k ship sized boxes drifting about a world
+// that grows with them, so the crowding stays the same: the spatial hash rebuilt and walked for pairs,
+// against testing every pair while that is still affordable
+int main()
+{
+    constexpr int BODY_SIZE { 24 };
+    constexpr int AREA_PER_BODY { 150 * 150 };
+    std::mt19937 rng { 7 };
+    std::uniform_int_distribution<int> drift(-3, 3);
+
+    for (size_t count : { 10u, 100u, 1000u, 10000u, 100000u })
+    {
+        int worldSize { static_cast<int>(std::sqrt(static_cast<double>(count) * AREA_PER_BODY)) };
+        std::uniform_int_distribution<int> position(0, worldSize);
+        std::vector<Rect> bodies(count);
+        for (Rect& body : bodies)
+        {
+            body = { position(rng), position(rng), BODY_SIZE, BODY_SIZE };
+        }
+
+        SpatialHash hash(64);
+        size_t pairs { 0 };
+        double hashNanoseconds { measureNanoseconds([&]() {
+            for (Rect& body : bodies)
+            {
+                body.x += drift(rng);
+                body.y += drift(rng);
+            }
+            hash.clear();
+            for (const Rect& body : bodies)
+            {
+                hash.add(body);
+            }
+            hash.build();
+            pairs = 0;
+            hash.forEachPair([&](const size_t, const size_t) { pairs++; });
+            doNotOptimize(pairs);
+        }, 20) };
+        char label[64];
+        snprintf(label, sizeof(label), "%zu bodies, spatial hash frame", count);
+        printResult(label, hashNanoseconds);
+        printf("%-48s %14.1f ns (%zu pairs)\n", "  per body", hashNanoseconds / static_cast<double>(count), pairs);
+
+        if (count <= 10000)
+        {
+            double bruteNanoseconds { measureNanoseconds([&]() {
+                size_t brutePairs { 0 };
+                for (size_t a = 0; a < bodies.size(); a++)
+                {
+                    for (size_t b = a + 1; b < bodies.size(); b++)
+                    {
+                        brutePairs += SpatialHash::overlaps(bodies[a], bodies[b]);
+                    }
+                }
+                doNotOptimize(brutePairs);
+            }, count <= 1000 ? 20 : 2) };
+            snprintf(label, sizeof(label), "%zu bodies, every pair", count);
+            printResult(label, bruteNanoseconds);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/ChunkManager.h"
+#include "lunar_lander/Constants.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Flies a camera across a world 100x the default width and reports the per-update cost of streaming it
+int main()
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, static_cast<size_t>(STREAMED_WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+
+    printResult("lay out pads for the whole world", measureNanoseconds([&]() {
+        ChunkManager chunks { config, STREAMED_WORLD_WIDTH / SCREEN_WIDTH, TERRAIN_CHUNK_WIDTH, TERRAIN_MAX_RESIDENT_CHUNKS };
+        doNotOptimize(chunks.getChunkCount());
+    }, 3));
+
+    ChunkManager chunks { config, STREAMED_WORLD_WIDTH / SCREEN_WIDTH, TERRAIN_CHUNK_WIDTH, TERRAIN_MAX_RESIDENT_CHUNKS };
+    TerrainGenerationConfig chunkConfig { config };
+    chunkConfig.worldWidth = TERRAIN_CHUNK_WIDTH;
+    TerrainGenerator generator { config.seed };
+    TerrainHeightmap chunkTerrain {};
+    printResult("one chunk: heights", measureNanoseconds([&]() {
+        generator.generateChunk(chunkTerrain, chunkConfig, chunks.getLandingPads(0), 0);
+        doNotOptimize(chunkTerrain.getSurface(0));
+    }, 20));
+    std::vector<std::uint32_t> pixels {};
+    printResult("one chunk: pixels", measureNanoseconds([&]() {
+        TerrainGenerator::rasterizeTerrainPixels(chunkTerrain, pixels);
+        doNotOptimize(pixels[0]);
+    }, 20));
+
+    // 10 pixels per update, the camera crossing the whole world
+    constexpr int SPEED { 10 };
+    Rect view { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+    double worstUpdate { 0.0 };
+    double totalTime { 0.0 };
+    size_t updates { 0 };
+    size_t maxResident { 0 };
+    for (; view.x + view.w <= static_cast<int>(chunks.getWidth()); view.x += SPEED, updates++)
+    {
+        double time { measureNanoseconds([&]() { chunks.update(view, static_cast<float>(SPEED)); }, 1) };
+        worstUpdate = std::max(worstUpdate, time);
+        totalTime += time;
+        maxResident = std::max(maxResident, chunks.getResidentChunkCount());
+    }
+    printResult("streaming update, mean", totalTime / static_cast<double>(updates));
+    printResult("streaming update, worst", worstUpdate);
+    printf("%-48s %14zu of %zu\n", "most resident chunks", maxResident, chunks.getChunkCount());
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LatticeNoise1D.h"
+#include "lunar_lander/PerlinNoise1D.h"
+#include "lunar_lander/PhysicsScalar.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr size_t SHIPS { 256 };
+constexpr int STEPS { 2000 };
+
+// The ship's step in either scalar: thrust along a heading from the table, gravity, then
+// a box swept along the move against the terrain. Returns the number of contacts
+template <typename Scalar>
+size_t flyShips(const TerrainQuery<TerrainHeightmap>& query, const std::vector<float>& startX)
+{
+    using Vector = BasicVector2D<Scalar>;
+    const Scalar gravity { fromFloat<Scalar>(GRAVITY) };
+    const Scalar thrust { fromFloat<Scalar>(THRUST_UNIT) };
+    const Scalar size { 32 };
+    const Scalar top { 200 };
+
+    std::vector<Vector> positions;
+    std::vector<Vector> velocities;
+    for (float x : startX)
+    {
+        positions.push_back(Vector { fromFloat<Scalar>(x), top });
+        velocities.push_back(Vector { Scalar {}, Scalar {} });
+    }
+
+    size_t contacts { 0 };
+    for (int step = 0; step < STEPS; step++)
+    {
+        for (size_t i = 0; i < SHIPS; i++)
+        {
+            Vector velocity { velocities[i] + Vector::heading((step + static_cast<int>(i)) % 360) * thrust };
+            velocity.setY(velocity.getY() + gravity);
+            BasicBoxHit<Scalar> hit { query.sweepBox(positions[i], size, size, velocity) };
+            if (hit.hit)
+            {
+                // back to the top, so every ship keeps flying
+                positions[i] = Vector { positions[i].getX(), top };
+                velocities[i] = Vector { Scalar {}, Scalar {} };
+                contacts++;
+                continue;
+            }
+            positions[i] += velocity;
+            velocities[i] = velocity;
+        }
+    }
+    return contacts;
+}
+}
+
+// The cost of the fixed point mode: the ship's integration and swept collision in float against
+// Fixed, in one binary, and the terrain's noise in double against the integer lattice noise.
+// LUNAR_LANDER_FIXED_POINT only picks which of these the game uses
+int main()
+{
+    printf("%-48s %14s\n", "physics in this build", FIXED_POINT_PHYSICS ? "fixed" : "float");
+
+    TerrainGenerationConfig config { makeWorldConfig(1, static_cast<size_t>(WORLD_WIDTH), false) };
+    TerrainHeightmap terrain {};
+    TerrainGenerator { config.seed }.generateTerrain(terrain, config, WORLD_WIDTH / SCREEN_WIDTH);
+    TerrainQuery query { terrain };
+
+    std::mt19937 rng { 5 };
+    std::uniform_real_distribution<float> xDist(100.0f, static_cast<float>(WORLD_WIDTH) - 100.0f);
+    std::vector<float> startX(SHIPS);
+    for (float& x : startX)
+    {
+        x = xDist(rng);
+    }
+
+    constexpr double SHIP_STEPS { static_cast<double>(SHIPS) * STEPS };
+    size_t floatContacts { 0 };
+    double floatNanoseconds { measureNanoseconds([&]() { floatContacts = flyShips<float>(query, startX); }, 1) };
+    size_t fixedContacts { 0 };
+    double fixedNanoseconds { measureNanoseconds([&]() { fixedContacts = flyShips<Fixed>(query, startX); }, 1) };
+    printResult("ship step with swept collision, float", floatNanoseconds / SHIP_STEPS);
+    printResult("ship step with swept collision, Fixed", fixedNanoseconds / SHIP_STEPS);
+    printf("%-48s %14zu / %zu\n", "contacts, float / Fixed", floatContacts, fixedContacts);
+
+    constexpr size_t COLUMNS { 1 << 20 };
+    PerlinNoise1D noise { config.seed };
+    LatticeNoise1D latticeNoise { config.seed };
+    double doubleNoiseNanoseconds { measureNanoseconds([&]() {
+        double sum { 0.0 };
+        for (size_t x = 0; x < COLUMNS; x++)
+        {
+            sum += noise.octaveNoise(static_cast<double>(x), PERLIN_OCTAVES, PERLIN_PERSISTENCE, PERLIN_FREQUENCY);
+        }
+        doNotOptimize(sum);
+    }, 1) };
+    double latticeNoiseNanoseconds { measureNanoseconds([&]() {
+        std::int64_t sum { 0 };
+        for (size_t x = 0; x < COLUMNS; x++)
+        {
+            sum += latticeNoise.octaveNoise(x, PERLIN_OCTAVES, PERLIN_PERSISTENCE, PERLIN_FREQUENCY);
+        }
+        doNotOptimize(sum);
+    }, 1) };
+    printResult("terrain noise per column, double", doubleNoiseNanoseconds / COLUMNS);
+    printResult("terrain noise per column, lattice", latticeNoiseNanoseconds / COLUMNS);
+    return 0;
+}
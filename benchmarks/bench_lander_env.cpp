@@ -0,0 +1,70 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LanderEnv.h"
+#include <random>
+#include <vector>
+
+// Environment steps for training, one LanderEnv at a time and a VectorEnv of many, with random
+// actions over a few worlds. Finished episodes start over in the same world, as VectorEnv does
+int main()
+{
+    constexpr size_t ENVS { 64 };
+    constexpr size_t STEPS { 2000 };
+    constexpr int MAX_STEPS { 60 * 60 };
+    TerrainGenerationConfig config { makeWorldConfig(0, static_cast<size_t>(WORLD_WIDTH), false) };
+    int landingPads { WORLD_WIDTH / SCREEN_WIDTH };
+
+    // the actions are drawn up front so the timings are of the environments alone
+    std::mt19937 rng { 3 };
+    std::vector<int> actions(ENVS * STEPS);
+    for (int& action : actions)
+    {
+        action = static_cast<int>(rng() % LanderEnv::ACTION_COUNT);
+    }
+
+    LanderEnv env { config, landingPads, MAX_STEPS };
+    float observation[LanderEnv::OBSERVATION_SIZE] {};
+    env.reset(1, observation);
+    size_t episodes { 0 };
+    double single { measureNanoseconds([&]() {
+        bool done { false };
+        for (size_t step = 0; step < ENVS * STEPS; step++)
+        {
+            float reward { env.step(actions[step], observation, done) };
+            doNotOptimize(reward);
+            if (done)
+            {
+                env.reset(1, observation);
+                episodes++;
+            }
+        }
+    }, 1) };
+
+    VectorEnv vector { ENVS, config, landingPads, MAX_STEPS };
+    std::vector<unsigned int> seeds(ENVS);
+    for (size_t i = 0; i < ENVS; i++)
+    {
+        seeds[i] = static_cast<unsigned int>(1 + i % 4);
+    }
+    vector.reset(seeds.data());
+    size_t vectorEpisodes { 0 };
+    double batched { measureNanoseconds([&]() {
+        for (size_t step = 0; step < STEPS; step++)
+        {
+            vector.step(actions.data() + step * ENVS);
+            for (size_t i = 0; i < ENVS; i++)
+            {
+                vectorEpisodes += vector.getDones()[i];
+            }
+        }
+        doNotOptimize(vector.getObservations()[0]);
+    }, 1) };
+
+    double steps { static_cast<double>(ENVS * STEPS) };
+    printResult("LanderEnv step", single / steps);
+    printResult("VectorEnv step, per environment", batched / steps);
+    printf("%-48s %14.2f M/s\n", "LanderEnv steps", steps / single * 1e3);
+    printf("%-48s %14.2f M/s\n", "VectorEnv steps", steps / batched * 1e3);
+    printf("%-48s %14zu and %zu\n", "episodes finished", episodes, vectorEpisodes);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LanderSimulation.h"
+#include <random>
+
+// Whole flights through the headless simulation: random pilots over one world until they crash
+// or a minute of game time at 60 steps a second runs out. Links the simulation core only
+int main()
+{
+    constexpr size_t FLIGHTS { 2000 };
+    constexpr int MAX_STEPS { 60 * 60 };
+    TerrainGenerationConfig config { makeWorldConfig(1, static_cast<size_t>(WORLD_WIDTH), false) };
+    TerrainGenerator generator { config.seed };
+    TerrainHeightmap terrain {};
+    generator.generateTerrain(terrain, config, WORLD_WIDTH / SCREEN_WIDTH);
+    std::vector<TerrainGenerator::PadInterval> pads { generator.getLandingPads() };
+
+    LanderSimulation simulation { 32, 32, 64, 16 };
+    std::mt19937 rng { 3 };
+    size_t steps { 0 };
+    size_t crashes { 0 };
+    double nanoseconds { measureNanoseconds([&]() {
+        for (size_t flight = 0; flight < FLIGHTS; flight++)
+        {
+            simulation.createWorld(config, TerrainHeightmap { terrain }, pads);
+            ShipInput input { 0, false };
+            for (int step = 0; step < MAX_STEPS && !simulation.isCrashed(); step++)
+            {
+                // a pilot holding each choice for a quarter of a second
+                if (step % 15 == 0)
+                {
+                    input = ShipInput { static_cast<std::int8_t>(static_cast<int>(rng() % 3) - 1), rng() % 3 != 0 };
+                }
+                crashes += simulation.step(input) ? 1u : 0u;
+                steps++;
+            }
+        }
+        doNotOptimize(simulation.getShip().getPosX());
+    }, 1) };
+
+    printResult("simulation step", nanoseconds / static_cast<double>(steps));
+    printResult("flight, including the world reset", nanoseconds / static_cast<double>(FLIGHTS));
+    printf("%-48s %14.1f M/hour\n", "flights", 3600e9 / (nanoseconds / static_cast<double>(FLIGHTS)) / 1e6);
+    printf("%-48s %14zu of %zu\n", "crashed", crashes, FLIGHTS);
+
+    // rollback and search go back to a snapshot and fly a few steps on from it, over and over
+    constexpr size_t CYCLES { 1000000 };
+    simulation.createWorld(config, TerrainHeightmap { terrain }, pads);
+    LanderSimulation::Snapshot snapshot { simulation.saveState() };
+    double saveNanoseconds { measureNanoseconds([&]() {
+        for (size_t cycle = 0; cycle < CYCLES; cycle++)
+        {
+            snapshot = simulation.saveState();
+            doNotOptimize(snapshot.tick);
+        }
+    }, 1) };
+    double restoreNanoseconds { measureNanoseconds([&]() {
+        for (size_t cycle = 0; cycle < CYCLES; cycle++)
+        {
+            simulation.restoreState(snapshot);
+            simulation.step(ShipInput { static_cast<std::int8_t>(static_cast<int>(cycle % 3) - 1), cycle % 2 == 0 });
+        }
+        doNotOptimize(simulation.getShip().getPosX());
+    }, 1) };
+    printf("%-48s %14zu bytes\n", "snapshot", sizeof(LanderSimulation::Snapshot));
+    printResult("save", saveNanoseconds / CYCLES);
+    printResult("restore and one step", restoreNanoseconds / CYCLES);
+    return 0;
+}
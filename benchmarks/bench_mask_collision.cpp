@@ -0,0 +1,77 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/Spaceship.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Per-frame collision cost of the fixed box against the rotated sprite mask, for ships at random
+// angles near the surface of the default world. The sprite is a 30 x 31 ellipse like the real ship
+int main()
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, static_cast<size_t>(WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+    TerrainHeightmap heightmap {};
+    TerrainGenerator { config.seed }.generateTerrain(heightmap, config, WORLD_WIDTH / SCREEN_WIDTH);
+    TerrainGrid grid {};
+    heightmap.rasterize(grid);
+
+    constexpr int WIDTH { 30 };
+    constexpr int HEIGHT { 31 };
+    std::vector<std::uint8_t> opacity(WIDTH * HEIGHT);
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        for (int x = 0; x < WIDTH; x++)
+        {
+            float dx { (static_cast<float>(x) + 0.5f - WIDTH / 2.0f) / (WIDTH / 2.0f) };
+            float dy { (static_cast<float>(y) + 0.5f - HEIGHT / 2.0f) / (HEIGHT / 2.0f) };
+            opacity[static_cast<size_t>(y * WIDTH + x)] = dx * dx + dy * dy <= 1.0f;
+        }
+    }
+    SpriteMask mask {};
+    double buildNanoseconds { measureNanoseconds([&]() { mask = SpriteMask(opacity.data(), WIDTH, HEIGHT); }, 3) };
+    printf("%-48s %14.1f us\n", "build 360 mask frames", buildNanoseconds / 1000.0);
+
+    // ships straddling the surface, where the terrain has to be looked at
+    constexpr size_t SHIPS { 100000 };
+    std::mt19937 rng { 7 };
+    std::uniform_int_distribution<int> xDist(0, WORLD_WIDTH - WIDTH);
+    std::uniform_int_distribution<int> yDist(-HEIGHT, 0);
+    std::uniform_real_distribution<float> angle(0.0f, 359.0f);
+    std::vector<Spaceship> boxShips {};
+    std::vector<Spaceship> maskShips {};
+    for (size_t i = 0; i < SHIPS; i++)
+    {
+        int x { xDist(rng) };
+        Spaceship ship(x, heightmap.getSurface(static_cast<size_t>(x + WIDTH / 2)) + yDist(rng), WIDTH, HEIGHT, 0.0f, THRUST_UNIT, MAX_THRUST);
+        ship.rotate(angle(rng));
+        boxShips.push_back(ship);
+        ship.setCollisionMask(&mask);
+        maskShips.push_back(ship);
+    }
+
+    for (const auto& [name, ships] : { std::pair { "box", &boxShips }, std::pair { "mask", &maskShips } })
+    {
+        size_t crashes { 0 };
+        double gridNanoseconds { measureNanoseconds([&]() {
+            crashes = 0;
+            for (Spaceship& ship : *ships)
+            {
+                crashes += ship.handleTerrainCollision(grid);
+            }
+            doNotOptimize(crashes);
+        }, 3) / SHIPS };
+        printResult(std::string { "TerrainGrid " } + name, gridNanoseconds);
+        printf("%-48s %14zu of %zu\n", "  crashes", crashes, SHIPS);
+
+        printResult(std::string { "TerrainHeightmap " } + name, measureNanoseconds([&]() {
+            crashes = 0;
+            for (Spaceship& ship : *ships)
+            {
+                crashes += ship.handleTerrainCollision(heightmap);
+            }
+            doNotOptimize(crashes);
+        }, 3) / SHIPS);
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/PerlinNoise1D.h"
+#include <vector>
+
+// Throughput of the scalar and batched octave noise paths, in noise samples per second
+int main()
+{
+#if defined(__AVX2__)
+    printf("Batch path: AVX2\n");
+#else
+    printf("Batch path: portable\n");
+#endif
+
+    PerlinNoise1D noise { 42 };
+    constexpr size_t SAMPLES { 1 << 20 };
+    constexpr size_t ITERATIONS { 10 };
+    std::vector<double> xs(SAMPLES);
+    std::vector<double> out(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; i++)
+    {
+        xs[i] = static_cast<double>(i);
+    }
+
+    double scalarNs { measureNanoseconds([&]() {
+        for (size_t i = 0; i < SAMPLES; i++)
+        {
+            out[i] = noise.octaveNoise(xs[i], PERLIN_OCTAVES, PERLIN_PERSISTENCE, PERLIN_FREQUENCY);
+        }
+        doNotOptimize(out[SAMPLES / 2]);
+    }, ITERATIONS) };
+    double batchNs { measureNanoseconds([&]() {
+        noise.octaveNoiseBatch(xs.data(), out.data(), SAMPLES, PERLIN_OCTAVES, PERLIN_PERSISTENCE, PERLIN_FREQUENCY);
+        doNotOptimize(out[SAMPLES / 2]);
+    }, ITERATIONS) };
+
+    printf("%-48s %14.3e samples/s\n", "octaveNoise (scalar)", static_cast<double>(SAMPLES) * 1e9 / scalarNs);
+    printf("%-48s %14.3e samples/s\n", "octaveNoiseBatch", static_cast<double>(SAMPLES) * 1e9 / batchNs);
+    printf("%-48s %14.2fx\n", "Speedup", scalarNs / batchNs);
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/ShipBatch.h"
+#include "lunar_lander/Spaceship.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int STEPS { 100 };
+
+// fire the engine while falling, turning slowly back and forth, which keeps most ships in the air
+ShipInput hover(const float velocityY, const int step)
+{
+    return { static_cast<std::int8_t>((step / 32) % 2 == 0 ? 1 : -1), velocityY > 0.0f };
+}
+
+void printShipSteps(const char* name, const size_t ships, const double nanoseconds)
+{
+    printf("%-48s %14.1f M ship-steps/s\n", name, static_cast<double>(ships) * STEPS * 1e3 / nanoseconds);
+}
+}
+
+// 1k to 100k landers flown for STEPS steps, as one ShipBatch against as many Spaceships,
+// in free flight and swept against the default world
+int main()
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, static_cast<size_t>(WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+    TerrainHeightmap terrain {};
+    TerrainGenerator { config.seed }.generateTerrain(terrain, config, WORLD_WIDTH / SCREEN_WIDTH);
+    TerrainQuery query { terrain };
+
+    for (size_t count : { 1000u, 10000u, 100000u })
+    {
+        // above the highest terrain, close enough to reach it
+        std::mt19937 rng { 7 };
+        std::uniform_int_distribution<int> xDist(0, WORLD_WIDTH - 32);
+        std::uniform_int_distribution<int> yDist(0, terrain.getMinSurface() - 40);
+        std::vector<std::pair<int, int>> spawns(count);
+        for (auto& spawn : spawns)
+        {
+            spawn = { xDist(rng), yDist(rng) };
+        }
+        printf("%zu ships\n", count);
+
+        // the SIMD part on its own, no pilot and nothing to hit
+        ShipBatch physicsOnly(32, 32, GRAVITY, THRUST_UNIT, MAX_THRUST, ROTATION_SPEED);
+        for (const auto& [x, y] : spawns)
+        {
+            physicsOnly.add(static_cast<float>(x), static_cast<float>(y));
+        }
+        printShipSteps("  ShipBatch::updatePhysics alone", count, measureNanoseconds([&]() {
+            for (int step = 0; step < STEPS; step++)
+            {
+                physicsOnly.updatePhysics();
+            }
+            doNotOptimize(physicsOnly.getPosY(0));
+        }, 3));
+
+        for (bool withTerrain : { false, true })
+        {
+            ShipBatch batch(32, 32, GRAVITY, THRUST_UNIT, MAX_THRUST, ROTATION_SPEED);
+            std::vector<ShipInput> inputs(count);
+            printShipSteps(withTerrain ? "  ShipBatch against terrain" : "  ShipBatch", count, measureNanoseconds([&]() {
+                batch.clear();
+                for (const auto& [x, y] : spawns)
+                {
+                    batch.add(static_cast<float>(x), static_cast<float>(y));
+                }
+                for (int step = 0; step < STEPS; step++)
+                {
+                    for (size_t ship = 0; ship < count; ship++)
+                    {
+                        inputs[ship] = hover(batch.getVelY(ship), step);
+                    }
+                    batch.control(inputs.data());
+                    if (withTerrain)
+                    {
+                        doNotOptimize(batch.updatePhysics(query));
+                    }
+                    else
+                    {
+                        batch.updatePhysics();
+                    }
+                }
+                doNotOptimize(batch.getPosY(0));
+            }, 3));
+
+            std::vector<Spaceship> ships {};
+            printShipSteps(withTerrain ? "  Spaceships against terrain" : "  Spaceships", count, measureNanoseconds([&]() {
+                ships.clear();
+                for (const auto& [x, y] : spawns)
+                {
+                    ships.emplace_back(x, y, 32, 32, GRAVITY, THRUST_UNIT, MAX_THRUST);
+                }
+                std::vector<bool> crashed(count, false);
+                for (int step = 0; step < STEPS; step++)
+                {
+                    for (size_t ship = 0; ship < count; ship++)
+                    {
+                        if (crashed[ship])
+                        {
+                            continue;
+                        }
+                        Spaceship& spaceship { ships[ship] };
+                        ShipInput input { hover(spaceship.getVelY(), step) };
+                        spaceship.rotate(input.turn > 0 ? ROTATION_SPEED : -ROTATION_SPEED);
+                        if (input.thrust)
+                        {
+                            spaceship.thrustIncrease();
+                        }
+                        else
+                        {
+                            spaceship.thrustDecay();
+                        }
+                        if (withTerrain)
+                        {
+                            crashed[ship] = spaceship.updatePhysics(query);
+                        }
+                        else
+                        {
+                            spaceship.updatePhysics();
+                        }
+                    }
+                }
+                doNotOptimize(ships[0].getPosY());
+            }, 3));
+        }
+    }
+    return 0;
+}
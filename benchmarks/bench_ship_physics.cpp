@@ -0,0 +1,91 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/Spaceship.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr float PI { 3.14159265358979323846f };
+
+// setMagnitude as it was, through the angle and back
+void rescaleThroughAngle(Vector2D& vector, const float magnitude)
+{
+    float radians { std::atan2(vector.getX(), -vector.getY()) };
+    vector.setX(magnitude * std::sin(radians));
+    vector.setY(-magnitude * std::cos(radians));
+}
+
+// rotateTo as rotate() used to call it
+void headingThroughTrig(Vector2D& vector, const float degrees)
+{
+    float magnitude { vector.getMagnitude() };
+    float radians { degrees * PI / 180.0f };
+    vector.setX(magnitude * std::sin(radians));
+    vector.setY(-magnitude * std::cos(radians));
+}
+}
+
+// The per-step work of flying the ship: turning, thrusting and integrating, without the terrain
+int main()
+{
+    constexpr size_t CALLS { 10000000 };
+    std::vector<Vector2D> vectors {};
+    for (size_t i = 0; i < 1024; i++)
+    {
+        vectors.push_back(Vector2D::heading(static_cast<int>(i % 360)) * (1.0f + static_cast<float>(i % 7)));
+    }
+
+    printResult("rescale through the angle", measureNanoseconds([&]() {
+        for (size_t i = 0; i < CALLS; i++)
+        {
+            rescaleThroughAngle(vectors[i % vectors.size()], 1.0f + static_cast<float>(i % 5));
+        }
+        doNotOptimize(vectors[0].getX());
+    }, 1) / static_cast<double>(CALLS));
+
+    printResult("setMagnitude", measureNanoseconds([&]() {
+        for (size_t i = 0; i < CALLS; i++)
+        {
+            vectors[i % vectors.size()].setMagnitude(1.0f + static_cast<float>(i % 5));
+        }
+        doNotOptimize(vectors[0].getX());
+    }, 1) / static_cast<double>(CALLS));
+
+    printResult("heading through sin and cos", measureNanoseconds([&]() {
+        for (size_t i = 0; i < CALLS; i++)
+        {
+            headingThroughTrig(vectors[i % vectors.size()], static_cast<float>(i % 360));
+        }
+        doNotOptimize(vectors[0].getX());
+    }, 1) / static_cast<double>(CALLS));
+
+    printResult("heading from the table", measureNanoseconds([&]() {
+        for (size_t i = 0; i < CALLS; i++)
+        {
+            Vector2D& vector { vectors[i % vectors.size()] };
+            vector = Vector2D::heading(static_cast<int>(i % 360)) * vector.getMagnitude();
+        }
+        doNotOptimize(vectors[0].getX());
+    }, 1) / static_cast<double>(CALLS));
+
+    // a pilot turning and pulsing the engine every step
+    Spaceship ship(0, 0, 32, 32, GRAVITY, THRUST_UNIT, MAX_THRUST);
+    printResult("ship step", measureNanoseconds([&]() {
+        for (size_t i = 0; i < CALLS; i++)
+        {
+            ship.rotate((i / 64) % 2 == 0 ? ROTATION_SPEED : -ROTATION_SPEED);
+            if ((i / 16) % 3 == 0)
+            {
+                ship.thrustDecay();
+            }
+            else
+            {
+                ship.thrustIncrease();
+            }
+            ship.updatePhysics();
+        }
+        doNotOptimize(ship.getPosX());
+    }, 1) / static_cast<double>(CALLS));
+    return 0;
+}
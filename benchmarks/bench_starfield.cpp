@@ -0,0 +1,32 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/NoiseTable.h"
+#include "lunar_lander/StarfieldGenerator.h"
+
+// Starfield generation time with exact noise and with NoiseTables, plus the error the tables introduce
+int main()
+{
+    int width { static_cast<int>(SCREEN_WIDTH * (1 + STARFIELD_PARALLAX_RATIO)) };
+    int height { static_cast<int>(SCREEN_HEIGHT * (1 + STARFIELD_PARALLAX_RATIO)) };
+    constexpr size_t ITERATIONS { 20 };
+
+    for (size_t stars : { 1500u, 20000u })
+    {
+        StarfieldGenerator generator {};
+        std::string suffix { " (" + std::to_string(stars) + " stars)" };
+        double exactNs { measureNanoseconds([&]() { generator.generateStarfield(width, height, stars, false); }, ITERATIONS) };
+        double tableNs { measureNanoseconds([&]() { generator.generateStarfield(width, height, stars, true); }, ITERATIONS) };
+        printResult("exact noise" + suffix, exactNs);
+        printResult("noise tables" + suffix, tableNs);
+        printf("%-48s %14.2e\n", "noise table error bound", generator.getNoiseTableErrorBound());
+    }
+
+    // the interpolation error against table resolution, for the galactic plane term
+    PerlinNoise1D noise { 42 };
+    for (double samplesPerCell : { 2.0, 4.0, 8.0, 16.0, 32.0 })
+    {
+        NoiseTable table { noise, 3, 0.5, 1.0, 0.0, width * 0.003, samplesPerCell };
+        printf("%5.0f samples per cell: %6zu entries, error bound %.2e\n", samplesPerCell, table.getSize(), table.getErrorBound());
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float BOX_SIZE { 24.0f };
+
+// the discrete check the ship used to do once per step, with the same notion of overlap as the sweep
+bool boxOverlaps(const TerrainHeightmap& terrain, const Vector2D& position)
+{
+    int startX { std::max(0, static_cast<int>(std::floor(position.getX()))) };
+    int endX { std::min(static_cast<int>(terrain.getWidth()), static_cast<int>(std::ceil(position.getX() + BOX_SIZE))) };
+    float bottom { position.getY() + BOX_SIZE };
+    if (position.getY() >= static_cast<float>(terrain.getHeight()))
+    {
+        return false;
+    }
+    const int* surface { terrain.surfaceData() };
+    for (int x = startX; x < endX; x++)
+    {
+        if (static_cast<float>(surface[x]) < bottom)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// first substep that overlaps, or N + 1 when none does
+int substepContact(const TerrainHeightmap& terrain, const Vector2D& origin, const Vector2D& displacement, const int substeps)
+{
+    for (int k = 1; k <= substeps; k++)
+    {
+        if (boxOverlaps(terrain, origin + displacement * (static_cast<float>(k) / static_cast<float>(substeps))))
+        {
+            return k;
+        }
+    }
+    return substeps + 1;
+}
+}
+
+// A million single-frame moves of a ship-sized box near the surface of the default world,
+// swept exactly against stepping it N times and checking for overlap after each step
+int main()
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, static_cast<size_t>(WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+    TerrainHeightmap terrain {};
+    TerrainGenerator { config.seed }.generateTerrain(terrain, config, WORLD_WIDTH / SCREEN_WIDTH);
+    TerrainQuery query { terrain };
+
+    // start clear of the ground, up to a fast descent per frame
+    constexpr size_t MOVES { 1000000 };
+    std::mt19937 rng { 7 };
+    std::uniform_real_distribution<float> xDist(0.0f, static_cast<float>(WORLD_WIDTH) - BOX_SIZE);
+    std::uniform_real_distribution<float> yDist(static_cast<float>(terrain.getMinSurface()) - 200.0f, static_cast<float>(WORLD_HEIGHT));
+    std::uniform_real_distribution<float> step(-60.0f, 60.0f);
+    std::vector<Vector2D> origins {};
+    std::vector<Vector2D> displacements {};
+    origins.reserve(MOVES);
+    displacements.reserve(MOVES);
+    while (origins.size() < MOVES)
+    {
+        Vector2D origin { xDist(rng), yDist(rng) };
+        if (!boxOverlaps(terrain, origin))
+        {
+            origins.push_back(origin);
+            displacements.push_back({ step(rng), step(rng) });
+        }
+    }
+
+    std::vector<bool> sweptHits(MOVES);
+    size_t hits { 0 };
+    printResult("swept box", measureNanoseconds([&]() {
+        hits = 0;
+        for (size_t i = 0; i < MOVES; i++)
+        {
+            sweptHits[i] = query.sweepBox(origins[i], BOX_SIZE, BOX_SIZE, displacements[i]).hit;
+            hits += sweptHits[i];
+        }
+        doNotOptimize(hits);
+    }, 3) / static_cast<double>(MOVES));
+
+    for (int substeps : { 1, 4, 16 })
+    {
+        size_t substepHits { 0 };
+        char label[48];
+        snprintf(label, sizeof(label), "%d substep%s", substeps, substeps == 1 ? "" : "s");
+        printResult(label, measureNanoseconds([&]() {
+            substepHits = 0;
+            for (size_t i = 0; i < MOVES; i++)
+            {
+                substepHits += substepContact(terrain, origins[i], displacements[i], substeps) <= substeps;
+            }
+            doNotOptimize(substepHits);
+        }, 3) / static_cast<double>(MOVES));
+
+        // contacts the substeps stepped over entirely
+        size_t tunneled { 0 };
+        for (size_t i = 0; i < MOVES; i++)
+        {
+            tunneled += sweptHits[i] && substepContact(terrain, origins[i], displacements[i], substeps) > substeps;
+        }
+        printf("%-48s %14zu of %zu contacts\n", "  tunneled through", tunneled, hits);
+    }
+    return 0;
+}
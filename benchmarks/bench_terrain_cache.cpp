@@ -0,0 +1,32 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainCache.h"
+#include <filesystem>
+#include <vector>
+
+// Replaying a known seed: generating the world against mapping it back from the terrain cache
+int main()
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, static_cast<size_t>(WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+    const int landingPads { WORLD_WIDTH / SCREEN_WIDTH };
+    std::string directory { (std::filesystem::temp_directory_path() / "bench_terrain_cache").string() };
+    TerrainCache cache { directory };
+    TerrainHeightmap terrain {};
+    std::vector<TerrainGenerator::PadInterval> pads {};
+    constexpr size_t ITERATIONS { 20 };
+
+    printResult("generate", measureNanoseconds([&]() {
+        TerrainGenerator generator { config.seed };
+        generator.generateTerrain(terrain, config, landingPads);
+        doNotOptimize(terrain.getSurface(0));
+    }, ITERATIONS));
+
+    cache.loadOrGenerate(config, landingPads, terrain, pads);
+    printResult("load from cache", measureNanoseconds([&]() {
+        cache.load(config, landingPads, terrain, pads);
+        doNotOptimize(terrain.getSurface(0));
+    }, ITERATIONS));
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// The original single pass generator, filling one column at a time down through the row vectors
+void generateLegacyTerrain(std::vector<std::vector<int>>& terrain, const TerrainGenerationConfig& config, const int averageNumberOfLandingPads, const unsigned int seed)
+{
+    PerlinNoise1D noise { seed };
+    std::mt19937 rng { seed };
+    double padProbability { static_cast<double>(averageNumberOfLandingPads) / static_cast<double>(config.worldWidth) };
+    terrain.assign(config.worldHeight, std::vector<int>(config.worldWidth, TERRAIN_VACUUM));
+
+    auto fillColumn = [&](const int height, const size_t xPos, const int value) {
+        for (size_t y = config.worldHeight - 1; y > config.worldHeight - static_cast<size_t>(height); y--)
+        {
+            terrain[y][xPos] = value;
+        }
+    };
+
+    size_t noiseX { 0 };
+    size_t terrainX { 0 };
+    int terrainHeight { config.startHeight };
+    while (terrainX < config.worldWidth)
+    {
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        if (chance(rng) < padProbability && terrainX + MAX_LANDING_PAD_WIDTH < config.worldWidth)
+        {
+            std::uniform_int_distribution<int> widthDist(MIN_LANDING_PAD_WIDTH, MAX_LANDING_PAD_WIDTH);
+            size_t padWidth { static_cast<size_t>(widthDist(rng)) };
+            for (size_t i = 0; i != padWidth; i++)
+            {
+                fillColumn(terrainHeight, terrainX + i, TERRAIN_LANDING_PAD);
+            }
+            terrainX += padWidth;
+        }
+        else
+        {
+            double noiseValue { noise.octaveNoise(static_cast<double>(noiseX), config.octaves, config.persistence, config.scale) };
+            terrainHeight = config.startHeight + static_cast<int>(noiseValue * config.heightVariation);
+            fillColumn(terrainHeight, terrainX, TERRAIN_ROCK);
+            terrainX++;
+            noiseX++;
+        }
+    }
+}
+
+void runAtWidth(const size_t worldWidth)
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, worldWidth, TERRAIN_USE_NOISE_TABLE) };
+    int pads { static_cast<int>(worldWidth / SCREEN_WIDTH) };
+    std::string suffix { " (" + std::to_string(worldWidth) + " wide)" };
+    constexpr size_t ITERATIONS { 3 };
+
+    std::vector<std::vector<int>> legacy {};
+    printResult("before: column-major nested vector fill" + suffix, measureNanoseconds([&]() {
+        generateLegacyTerrain(legacy, config, pads, config.seed);
+    }, ITERATIONS));
+
+    TerrainHeightmap heightmap {};
+    printResult("after: column heights only" + suffix, measureNanoseconds([&]() {
+        TerrainGenerator generator { config.seed };
+        generator.generateTerrain(heightmap, config, pads);
+    }, ITERATIONS));
+
+    TerrainGrid grid {};
+    printResult("after: column heights + row-major grid" + suffix, measureNanoseconds([&]() {
+        TerrainGenerator generator { config.seed };
+        generator.generateTerrain(grid, config, pads);
+    }, ITERATIONS));
+}
+}
+
+// Times generateTerrain against the original column-major fill, at the default world width and 10x that
+int main()
+{
+    printf("Hardware threads: %u\n", std::thread::hardware_concurrency());
+    runAtWidth(static_cast<size_t>(WORLD_WIDTH));
+    runAtWidth(static_cast<size_t>(WORLD_WIDTH) * 10);
+    return 0;
+}
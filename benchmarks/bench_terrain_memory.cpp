@@ -0,0 +1,106 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Compares the column heightmap and the packed TerrainGrid against the nested std::vector<std::vector<int>> they replaced
+int main()
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, static_cast<size_t>(WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+    TerrainHeightmap heightmap {};
+    TerrainGenerator generator { config.seed };
+    generator.generateTerrain(heightmap, config, WORLD_WIDTH / SCREEN_WIDTH);
+    TerrainGrid grid {};
+    heightmap.rasterize(grid);
+
+    // the legacy layout, one heap allocation per row
+    std::vector<std::vector<int>> legacy(grid.getHeight(), std::vector<int>(grid.getWidth(), TERRAIN_VACUUM));
+    for (size_t y = 0; y < grid.getHeight(); y++)
+    {
+        for (size_t x = 0; x < grid.getWidth(); x++)
+        {
+            legacy[y][x] = grid.at(x, y);
+        }
+    }
+
+    size_t legacyBytes { sizeof(legacy) + legacy.size() * (sizeof(std::vector<int>) + grid.getWidth() * sizeof(int)) };
+    size_t gridBytes { sizeof(grid) + grid.getMemoryFootprint() };
+    size_t heightmapBytes { sizeof(heightmap) + heightmap.getMemoryFootprint() };
+    printf("World %zu x %zu\n", grid.getWidth(), grid.getHeight());
+    printf("%-48s %14zu bytes\n", "std::vector<std::vector<int>> footprint", legacyBytes);
+    printf("%-48s %14zu bytes\n", "TerrainGrid footprint", gridBytes);
+    printf("%-48s %14zu bytes\n", "TerrainHeightmap footprint", heightmapBytes);
+    printf("%-48s %14.1fx\n", "TerrainGrid reduction", static_cast<double>(legacyBytes) / static_cast<double>(gridBytes));
+    printf("%-48s %14.1fx\n", "TerrainHeightmap reduction", static_cast<double>(legacyBytes) / static_cast<double>(heightmapBytes));
+
+    // column-major walk of the whole world, as the texture build does
+    printResult("legacy full column walk", measureNanoseconds([&]() {
+        size_t solid { 0 };
+        for (size_t x = 0; x < legacy[0].size(); x++)
+            for (size_t y = 0; y < legacy.size(); y++)
+                solid += legacy[y][x] != TERRAIN_VACUUM;
+        doNotOptimize(solid);
+    }, 5));
+    printResult("TerrainGrid full column walk", measureNanoseconds([&]() {
+        size_t solid { 0 };
+        for (size_t x = 0; x < grid.getWidth(); x++)
+            for (size_t y = 0; y < grid.getHeight(); y++)
+                solid += grid.at(x, y) != TERRAIN_VACUUM;
+        doNotOptimize(solid);
+    }, 5));
+
+    // a collision box sized scan at random positions, as Spaceship::handleTerrainCollision does
+    constexpr size_t BOX { 24 };
+    constexpr size_t SCANS { 100000 };
+    std::mt19937 rng { 7 };
+    std::uniform_int_distribution<size_t> xDist(0, grid.getWidth() - BOX);
+    std::uniform_int_distribution<size_t> yDist(0, grid.getHeight() - BOX);
+    std::vector<std::pair<size_t, size_t>> positions(SCANS);
+    for (auto& position : positions)
+    {
+        position = { xDist(rng), yDist(rng) };
+    }
+    printResult("legacy 24x24 collision scan", measureNanoseconds([&]() {
+        size_t solid { 0 };
+        for (const auto& [px, py] : positions)
+            for (size_t y = py; y < py + BOX; y++)
+                for (size_t x = px; x < px + BOX; x++)
+                    solid += legacy[y][x] != TERRAIN_VACUUM;
+        doNotOptimize(solid);
+    }, 1) / SCANS);
+    printResult("TerrainGrid 24x24 collision scan", measureNanoseconds([&]() {
+        size_t solid { 0 };
+        for (const auto& [px, py] : positions)
+            for (size_t y = py; y < py + BOX; y++)
+                for (size_t x = px; x < px + BOX; x++)
+                    solid += grid.at(x, y) != TERRAIN_VACUUM;
+        doNotOptimize(solid);
+    }, 1) / SCANS);
+    printResult("TerrainGrid 24x24 pyramid first collision scan", measureNanoseconds([&]() {
+        size_t solid { 0 };
+        for (const auto& [px, py] : positions)
+        {
+            if (grid.isVacuum(px, py, BOX, BOX))
+                continue;
+            for (size_t y = py; y < py + BOX; y++)
+                for (size_t x = px; x < px + BOX; x++)
+                    solid += grid.at(x, y) != TERRAIN_VACUUM;
+        }
+        doNotOptimize(solid);
+    }, 1) / SCANS);
+    printResult("TerrainHeightmap 24 column collision check", measureNanoseconds([&]() {
+        size_t solid { 0 };
+        for (const auto& [px, py] : positions)
+        {
+            int minSurface { static_cast<int>(py + BOX) };
+            for (size_t x = px; x < px + BOX; x++)
+                minSurface = std::min(minSurface, heightmap.getSurface(x));
+            solid += minSurface < static_cast<int>(py + BOX);
+        }
+        doNotOptimize(solid);
+    }, 1) / SCANS);
+
+    return 0;
+}
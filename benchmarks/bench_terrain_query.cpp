@@ -0,0 +1,78 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+// A million rays from random points in the sky of the default world, in random directions,
+// and a million skimming along just above the ground
+int main()
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, static_cast<size_t>(WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+    TerrainHeightmap terrain {};
+    TerrainGenerator { config.seed }.generateTerrain(terrain, config, WORLD_WIDTH / SCREEN_WIDTH);
+    TerrainQuery query { terrain };
+
+    constexpr size_t RAYS { 1000000 };
+    constexpr float MAX_DISTANCE { 1000.0f };
+    std::mt19937 rng { 7 };
+    std::uniform_real_distribution<float> xDist(0.0f, static_cast<float>(WORLD_WIDTH));
+    std::uniform_real_distribution<float> yDist(0.0f, static_cast<float>(WORLD_HEIGHT) * (1.0f - TERRAIN_START_HEIGHT - TERRAIN_HEIGHT_VARIATION));
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<Vector2D> origins {};
+    std::vector<Vector2D> directions {};
+    origins.reserve(RAYS);
+    directions.reserve(RAYS);
+    for (size_t i = 0; i < RAYS; i++)
+    {
+        float theta { angle(rng) };
+        origins.push_back({ xDist(rng), yDist(rng) });
+        directions.push_back({ std::cos(theta), std::sin(theta) });
+    }
+
+    size_t hits { 0 };
+    double rayNanoseconds { measureNanoseconds([&]() {
+        hits = 0;
+        for (size_t i = 0; i < RAYS; i++)
+        {
+            hits += query.raycast(origins[i], directions[i], MAX_DISTANCE).hit;
+        }
+        doNotOptimize(hits);
+    }, 3) / static_cast<double>(RAYS) };
+    printResult("raycast, up to 1000 px", rayNanoseconds);
+    printf("%-48s %14.0f rays/s (%zu%% hit)\n", "raycast throughput", 1e9 / rayNanoseconds, hits * 100 / RAYS);
+
+    // shallow rays skimming along the ground, which cross the most columns before hitting
+    std::uniform_real_distribution<float> shallow(-0.05f, 0.05f);
+    std::vector<Vector2D> skimOrigins {};
+    std::vector<Vector2D> skimDirections {};
+    for (size_t i = 0; i < RAYS; i++)
+    {
+        float x { xDist(rng) };
+        float theta { shallow(rng) + (i % 2 == 0 ? 0.0f : 3.14159265f) };
+        skimOrigins.push_back({ x, static_cast<float>(terrain.getSurface(static_cast<size_t>(x))) - 40.0f });
+        skimDirections.push_back({ std::cos(theta), std::sin(theta) });
+    }
+    double skimNanoseconds { measureNanoseconds([&]() {
+        hits = 0;
+        for (size_t i = 0; i < RAYS; i++)
+        {
+            hits += query.raycast(skimOrigins[i], skimDirections[i], MAX_DISTANCE).hit;
+        }
+        doNotOptimize(hits);
+    }, 3) / static_cast<double>(RAYS) };
+    printResult("raycast skimming the ground", skimNanoseconds);
+    printf("%-48s %14.0f rays/s (%zu%% hit)\n", "skimming throughput", 1e9 / skimNanoseconds, hits * 100 / RAYS);
+
+    printResult("altitude", measureNanoseconds([&]() {
+        float sum { 0.0f };
+        for (size_t i = 0; i < RAYS; i++)
+        {
+            sum += query.altitude(origins[i].getX(), origins[i].getY());
+        }
+        doNotOptimize(sum);
+    }, 3) / static_cast<double>(RAYS));
+    return 0;
+}
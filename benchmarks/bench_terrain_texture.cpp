@@ -0,0 +1,48 @@
+#include "BenchmarkUtils.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+// CPU side of the terrain texture build: the old SDL_Point lists against the direct pixel buffer
+int main()
+{
+    TerrainGenerationConfig config { makeWorldConfig(42, static_cast<size_t>(WORLD_WIDTH), TERRAIN_USE_NOISE_TABLE) };
+    TerrainHeightmap terrain {};
+    TerrainGenerator { config.seed }.generateTerrain(terrain, config, WORLD_WIDTH / SCREEN_WIDTH);
+    constexpr size_t ITERATIONS { 10 };
+
+    // what createTerrainTexture used to hand to SDL_RenderDrawPoints
+    printResult("SDL_Point lists", measureNanoseconds([&]() {
+        std::vector<SDL_Point> foregroundPoints {};
+        std::vector<SDL_Point> terrainPoints {};
+        for (size_t x = 0; x < terrain.getWidth(); x++)
+        {
+            size_t surface { static_cast<size_t>(terrain.getSurface(x)) };
+            if (surface >= terrain.getHeight())
+            {
+                continue;
+            }
+            terrainPoints.push_back({ static_cast<int>(x), static_cast<int>(surface) });
+            size_t foregroundStart { surface + 1 };
+            if (terrain.isLandingPad(x) && surface + 1 < terrain.getHeight() && x % 2 == 0)
+            {
+                terrainPoints.push_back({ static_cast<int>(x), static_cast<int>(surface + 1) });
+                foregroundStart++;
+            }
+            for (size_t y = foregroundStart; y < terrain.getHeight(); y++)
+            {
+                foregroundPoints.push_back({ static_cast<int>(x), static_cast<int>(y) });
+            }
+        }
+        doNotOptimize(foregroundPoints.size() + terrainPoints.size());
+    }, ITERATIONS));
+
+    std::vector<std::uint32_t> pixels {};
+    printResult("RGBA pixel buffer", measureNanoseconds([&]() {
+        TerrainGenerator::rasterizeTerrainPixels(terrain, pixels);
+        doNotOptimize(pixels[pixels.size() / 2]);
+    }, ITERATIONS));
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+// Allocator for std::vector storage that starts on an Alignment byte boundary,
+// so SIMD loops can use aligned loads from the first element
+template <typename T, size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) { }
+
+    T* allocate(const size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t { Alignment }));
+    }
+
+    void deallocate(T* pointer, const size_t)
+    {
+        ::operator delete(pointer, std::align_val_t { Alignment });
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+#endif // ALIGNEDALLOCATOR_H
@@ -1,16 +1,21 @@
 #ifndef BASEENGINE_H
 #define BASEENGINE_H
 
+#include "engine/FixedTimestep.h"
 #include "engine/Texture.h"
 #include "engine/Timer.h"
 #include <memory>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
 
 inline constexpr SDL_Color BACKGROUND_COLOUR { 250, 250, 250, 255 };
 inline constexpr SDL_Color TEXT_COLOUR { 0, 0, 0, 255 };
 inline constexpr int BOTTOM_BAR_HEIGHT { 24 };
 inline constexpr int FONT_SIZE = 18;
 constexpr std::string_view FONT_ARIAL { "Arial.ttf" };
+inline constexpr int SIMULATION_STEPS_PER_SECOND { 60 }; // update() runs at this rate whatever the frame rate
+inline constexpr int MAX_CATCH_UP_STEPS { 5 };            // updates a single frame can run before the simulation slows down instead
 
 // Custom deleters for SDL resources
 struct SDLWindowDeleter
@@ -96,6 +101,9 @@ protected:
     Uint32 mFrameCount;
     Uint32 mScore;
     int mFps;
+
+    // Fraction of a step the frame being rendered is past the last update, for drawing between steps
+    float mInterpolation;
 };
 
 #endif
\ No newline at end of file
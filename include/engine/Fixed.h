@@ -0,0 +1,178 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// A signed fixed point number, 24 of its 64 bits after the binary point.
+//
+// Every operation is integer arithmetic, so results are the same bits on any compiler, flags or CPU,
+// which floats do not promise. Sums hold up to 2^39, far wider than any world. Products, and the
+// dividends of quotients, hold while they stay under 2^15: speeds, times and distances across a
+// step, not positions multiplied together
+class Fixed
+{
+public:
+    static constexpr int FRACTION_BITS { 24 };
+    static constexpr std::int64_t ONE { std::int64_t { 1 } << FRACTION_BITS };
+
+    constexpr Fixed()
+        : mRaw { 0 }
+    {
+    }
+
+    // whole numbers convert exactly, so they need no cast
+    template <typename Integer, std::enable_if_t<std::is_integral_v<Integer> && std::is_signed_v<Integer>, int> = 0>
+    constexpr Fixed(const Integer value)
+        : mRaw { ONE * value }
+    {
+    }
+
+    // rounded to the nearest 2^-24, the same on every machine since only the exact scaling happens in floating point
+    explicit constexpr Fixed(const double value)
+        : mRaw { static_cast<std::int64_t>(value * static_cast<double>(ONE) + (value < 0.0 ? -0.5 : 0.5)) }
+    {
+    }
+
+    static constexpr Fixed fromRaw(const std::int64_t raw)
+    {
+        Fixed result {};
+        result.mRaw = raw;
+        return result;
+    }
+
+    constexpr std::int64_t getRaw() const { return mRaw; }
+    constexpr float toFloat() const { return static_cast<float>(mRaw) / static_cast<float>(ONE); }
+
+    constexpr Fixed& operator+=(const Fixed other)
+    {
+        mRaw += other.mRaw;
+        return *this;
+    }
+
+    constexpr Fixed& operator-=(const Fixed other)
+    {
+        mRaw -= other.mRaw;
+        return *this;
+    }
+
+    // the shifts are arithmetic, rounding towards negative infinity
+    constexpr Fixed& operator*=(const Fixed other)
+    {
+        mRaw = (mRaw * other.mRaw) >> FRACTION_BITS;
+        return *this;
+    }
+
+    // rounds towards zero
+    constexpr Fixed& operator/=(const Fixed other)
+    {
+        mRaw = mRaw * ONE / other.mRaw;
+        return *this;
+    }
+
+    constexpr Fixed operator-() const { return fromRaw(-mRaw); }
+
+    friend constexpr Fixed operator+(Fixed left, const Fixed right) { return left += right; }
+    friend constexpr Fixed operator-(Fixed left, const Fixed right) { return left -= right; }
+    friend constexpr Fixed operator*(Fixed left, const Fixed right) { return left *= right; }
+    friend constexpr Fixed operator/(Fixed left, const Fixed right) { return left /= right; }
+
+    friend constexpr bool operator==(const Fixed left, const Fixed right) { return left.mRaw == right.mRaw; }
+    friend constexpr bool operator!=(const Fixed left, const Fixed right) { return left.mRaw != right.mRaw; }
+    friend constexpr bool operator<(const Fixed left, const Fixed right) { return left.mRaw < right.mRaw; }
+    friend constexpr bool operator<=(const Fixed left, const Fixed right) { return left.mRaw <= right.mRaw; }
+    friend constexpr bool operator>(const Fixed left, const Fixed right) { return left.mRaw > right.mRaw; }
+    friend constexpr bool operator>=(const Fixed left, const Fixed right) { return left.mRaw >= right.mRaw; }
+
+private:
+    std::int64_t mRaw; // the value times ONE
+};
+
+// Square root rounded down to 2^-24, by the bit by bit integer method. Zero for negative values
+constexpr Fixed sqrt(const Fixed value)
+{
+    if (value.getRaw() <= 0)
+    {
+        return Fixed {};
+    }
+    // sqrt(raw / ONE) * ONE is sqrt(raw * ONE), which fits while the value is below 2^16
+    std::uint64_t remainder { static_cast<std::uint64_t>(value.getRaw()) << Fixed::FRACTION_BITS };
+    std::uint64_t root { 0 };
+    std::uint64_t bit { std::uint64_t { 1 } << 62 };
+    while (bit > remainder)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (remainder >= root + bit)
+        {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return Fixed::fromRaw(static_cast<std::int64_t>(root));
+}
+
+constexpr Fixed abs(const Fixed value)
+{
+    return value.getRaw() < 0 ? -value : value;
+}
+
+// The conversions templates need, overloaded for float as well so code reads the same over either scalar
+constexpr float toFloat(const float value) { return value; }
+constexpr float toFloat(const Fixed value) { return value.toFloat(); }
+
+template <typename Scalar>
+constexpr Scalar fromFloat(const float value)
+{
+    if constexpr (std::is_same_v<Scalar, float>)
+    {
+        return value;
+    }
+    else
+    {
+        return Scalar { static_cast<double>(value) };
+    }
+}
+
+// truncates towards zero like a cast of a float
+inline int toInt(const float value) { return static_cast<int>(value); }
+constexpr int toInt(const Fixed value)
+{
+    std::int64_t raw { value.getRaw() };
+    return static_cast<int>(raw < 0 ? -(-raw >> Fixed::FRACTION_BITS) : raw >> Fixed::FRACTION_BITS);
+}
+
+inline long floorToLong(const float value) { return static_cast<long>(std::floor(value)); }
+constexpr long floorToLong(const Fixed value) { return value.getRaw() >> Fixed::FRACTION_BITS; }
+
+inline long ceilToLong(const float value) { return static_cast<long>(std::ceil(value)); }
+constexpr long ceilToLong(const Fixed value) { return (value.getRaw() + Fixed::ONE - 1) >> Fixed::FRACTION_BITS; }
+
+namespace std
+{
+// Integer style, as the value is an integer count of steps: min() is the most negative value like lowest(),
+// not the smallest positive one. epsilon() is one step, the gap between 1 and the next value up
+template <>
+struct numeric_limits<Fixed>
+{
+    static constexpr bool is_specialized { true };
+    static constexpr bool is_signed { true };
+    static constexpr bool is_exact { true };
+    static constexpr bool has_infinity { false };
+    static constexpr Fixed min() { return lowest(); }
+    static constexpr Fixed max() { return Fixed::fromRaw(std::numeric_limits<std::int64_t>::max()); }
+    static constexpr Fixed lowest() { return Fixed::fromRaw(std::numeric_limits<std::int64_t>::min()); }
+    static constexpr Fixed epsilon() { return Fixed::fromRaw(1); }
+};
+}
+
+#endif // FIXED_H
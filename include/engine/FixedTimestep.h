@@ -0,0 +1,56 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <SDL.h>
+#include <algorithm>
+
+// Decouples the simulation rate from the frame rate.
+//
+// Each frame adds the elapsed time, in performance counter ticks, to an accumulator and runs
+// one simulation step per whole step length it holds. What is left over is how far the frame
+// is past the last step, which rendering uses to draw between the last two steps.
+// A frame that falls far behind runs at most maxStepsPerFrame steps and drops the rest,
+// so a slow step cannot make every following frame slower still
+class FixedTimestep
+{
+public:
+    FixedTimestep(const Uint64 frequency, const int stepsPerSecond, const int maxStepsPerFrame)
+        : mStepLength { std::max(frequency / static_cast<Uint64>(stepsPerSecond), Uint64 { 1 }) }
+        , mMaxSteps { static_cast<Uint64>(maxStepsPerFrame) }
+        , mAccumulator { 0 }
+    {
+    }
+
+    Uint64 getStepLength() const { return mStepLength; };
+
+    // Adds the time since the last frame and returns how many steps to run for it
+    int advance(const Uint64 elapsed)
+    {
+        mAccumulator += elapsed;
+        Uint64 steps { mAccumulator / mStepLength };
+        if (steps > mMaxSteps)
+        {
+            // keep the fraction of a step so interpolation carries on smoothly
+            steps = mMaxSteps;
+            mAccumulator %= mStepLength;
+        }
+        else
+        {
+            mAccumulator -= steps * mStepLength;
+        }
+        return static_cast<int>(steps);
+    }
+
+    // Fraction of a step, from 0 up to 1, the frame is past the last step
+    float getAlpha() const
+    {
+        return static_cast<float>(mAccumulator) / static_cast<float>(mStepLength);
+    }
+
+private:
+    Uint64 mStepLength; // in counter ticks
+    Uint64 mMaxSteps;
+    Uint64 mAccumulator;
+};
+
+#endif // FIXEDTIMESTEP_H
@@ -0,0 +1,39 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file
+// Memory-mapped on POSIX systems, elsewhere the file is read into a buffer
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // We dont support copy constructor, copy assignment, move constructor, move assignment
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    // Maps the file at path, replacing any file already open. Empty files fail to open
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return mData != nullptr; };
+    const std::uint8_t* data() const { return mData; };
+    size_t size() const { return mSize; };
+
+private:
+    const std::uint8_t* mData;
+    size_t mSize;
+#ifdef _WIN32
+    std::vector<std::uint8_t> mBuffer;
+#endif
+};
+
+#endif // MAPPEDFILE_H
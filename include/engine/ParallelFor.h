@@ -0,0 +1,71 @@
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Set on a thread that already runs alongside one thread per core, such as a parallelFor block or a
+// WorkStealingPool worker. Starting another thread per core from each of them would oversubscribe the machine
+inline thread_local bool tParallelForInline { false };
+
+// Makes parallelFor run inline on the constructing thread until it goes out of scope
+class ScopedInlineParallelFor
+{
+public:
+    explicit ScopedInlineParallelFor(const bool enable = true)
+        : mPrevious { tParallelForInline }
+    {
+        tParallelForInline = mPrevious || enable;
+    }
+    ~ScopedInlineParallelFor() { tParallelForInline = mPrevious; }
+    ScopedInlineParallelFor(const ScopedInlineParallelFor&) = delete;
+    ScopedInlineParallelFor& operator=(const ScopedInlineParallelFor&) = delete;
+
+private:
+    bool mPrevious;
+};
+
+// Splits [begin, end) into one contiguous block per hardware thread and calls fn(blockBegin, blockEnd) for each.
+// The calling thread works on the first block. Small ranges, under minBlockSize per thread, run inline,
+// as does everything called from inside a block or under a ScopedInlineParallelFor
+template <typename Function>
+void parallelFor(const size_t begin, const size_t end, Function&& fn, const size_t minBlockSize = 1024)
+{
+    size_t count { end > begin ? end - begin : 0 };
+    if (count == 0)
+    {
+        return;
+    }
+
+    size_t threads { tParallelForInline ? 1 : std::max<size_t>(1, std::thread::hardware_concurrency()) };
+    size_t blocks { std::min(threads, std::max<size_t>(1, count / std::max<size_t>(1, minBlockSize))) };
+    if (blocks == 1)
+    {
+        fn(begin, end);
+        return;
+    }
+
+    size_t blockSize { (count + blocks - 1) / blocks };
+    std::vector<std::thread> workers {};
+    workers.reserve(blocks - 1);
+    for (size_t blockBegin = begin + blockSize; blockBegin < end; blockBegin += blockSize)
+    {
+        workers.emplace_back([&fn, blockBegin, blockEnd = std::min(end, blockBegin + blockSize)]() {
+            ScopedInlineParallelFor nested {};
+            fn(blockBegin, blockEnd);
+        });
+    }
+    {
+        ScopedInlineParallelFor nested {};
+        fn(begin, std::min(end, begin + blockSize));
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+#endif // PARALLELFOR_H
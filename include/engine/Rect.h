@@ -0,0 +1,14 @@
+#ifndef RECT_H
+#define RECT_H
+
+// An axis-aligned box in whole pixels, laid out as SDL_Rect so the game can draw with it
+// while the simulation stays free of SDL
+struct Rect
+{
+    int x;
+    int y;
+    int w;
+    int h;
+};
+
+#endif // RECT_H
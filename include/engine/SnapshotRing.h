@@ -0,0 +1,66 @@
+#ifndef SNAPSHOTRING_H
+#define SNAPSHOTRING_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// The last capacity snapshots pushed, oldest overwritten first.
+//
+// The storage is allocated once when the ring is made, so a push every step is a copy and nothing more.
+// Snapshots are read back by age, 0 being the newest, and dropNewest forgets the ones after a rollback
+template <typename Snapshot>
+class SnapshotRing
+{
+public:
+    static_assert(std::is_trivially_copyable_v<Snapshot>, "snapshots are copied as plain values");
+
+    explicit SnapshotRing(const size_t capacity)
+        : mSnapshots(capacity)
+        , mNext { 0 }
+        , mSize { 0 }
+    {
+        assert(capacity > 0);
+    }
+
+    size_t size() const { return mSize; };
+    size_t capacity() const { return mSnapshots.size(); };
+    bool empty() const { return mSize == 0; };
+
+    void push(const Snapshot& snapshot)
+    {
+        mSnapshots[mNext] = snapshot;
+        mNext = mNext + 1 == mSnapshots.size() ? 0 : mNext + 1;
+        mSize = mSize < mSnapshots.size() ? mSize + 1 : mSize;
+    }
+
+    // age 0 is the newest, size() - 1 the oldest
+    const Snapshot& newest(const size_t age = 0) const
+    {
+        assert(age < mSize);
+        size_t index { mNext + mSnapshots.size() - 1 - age };
+        return mSnapshots[index >= mSnapshots.size() ? index - mSnapshots.size() : index];
+    }
+
+    // Forgets the count newest snapshots, so newest(0) is the one that was newest(count)
+    void dropNewest(const size_t count)
+    {
+        assert(count <= mSize);
+        mNext = (mNext + mSnapshots.size() - count) % mSnapshots.size();
+        mSize -= count;
+    }
+
+    void clear()
+    {
+        mNext = 0;
+        mSize = 0;
+    }
+
+private:
+    std::vector<Snapshot> mSnapshots;
+    size_t mNext; // where the next push goes
+    size_t mSize;
+};
+
+#endif // SNAPSHOTRING_H
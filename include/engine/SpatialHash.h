@@ -0,0 +1,178 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include "engine/Rect.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid broadphase for axis-aligned boxes, rebuilt from scratch every frame.
+//
+// Bodies are added with add(), which hands out ids 0, 1, 2... in order, then build() buckets
+// every cell a box touches into one flat array with a counting sort. The grid is unbounded,
+// cells are hashed into a table sized to the number of entries, so the world size does not matter.
+// A body spanning several cells is reported once: only from the top left cell it shares with the other box
+class SpatialHash
+{
+public:
+    explicit SpatialHash(const int cellSize)
+        : mCellSize { cellSize }
+        , mBoxes {}
+        , mEntries {}
+        , mBucketStarts {}
+        , mBuckets {}
+    {
+    }
+
+    int getCellSize() const { return mCellSize; };
+    size_t size() const { return mBoxes.size(); };
+    const Rect& getBox(const size_t id) const { return mBoxes[id]; };
+
+    // Forgets every body, keeping the storage for the next frame
+    void clear()
+    {
+        mBoxes.clear();
+        mEntries.clear();
+    }
+
+    // Boxes without area are never reported
+    size_t add(const Rect& box)
+    {
+        size_t id { mBoxes.size() };
+        mBoxes.push_back(box);
+        if (box.w > 0 && box.h > 0)
+        {
+            forEachCell(box, [&](const int cellX, const int cellY) {
+                mEntries.push_back({ static_cast<std::uint32_t>(id), cellX, cellY });
+            });
+        }
+        return id;
+    }
+
+    // Buckets the entries added since clear(), call before querying
+    void build()
+    {
+        size_t bucketCount { 1 };
+        while (bucketCount < mEntries.size() * 2)
+        {
+            bucketCount *= 2;
+        }
+        mBucketStarts.assign(bucketCount + 1, 0);
+        for (const Entry& entry : mEntries)
+        {
+            mBucketStarts[bucketOf(entry.cellX, entry.cellY) + 1]++;
+        }
+        for (size_t bucket = 0; bucket < bucketCount; bucket++)
+        {
+            mBucketStarts[bucket + 1] += mBucketStarts[bucket];
+        }
+        mBuckets.resize(mEntries.size());
+        std::vector<std::uint32_t> next(mBucketStarts.begin(), mBucketStarts.end() - 1);
+        for (const Entry& entry : mEntries)
+        {
+            mBuckets[next[bucketOf(entry.cellX, entry.cellY)]++] = entry;
+        }
+    }
+
+    // Calls fn(id) once for every body overlapping box
+    template <typename Function>
+    void query(const Rect& box, Function&& fn) const
+    {
+        if (box.w <= 0 || box.h <= 0 || mBuckets.empty())
+        {
+            return;
+        }
+        forEachCell(box, [&](const int cellX, const int cellY) {
+            size_t bucket { bucketOf(cellX, cellY) };
+            for (std::uint32_t i = mBucketStarts[bucket]; i != mBucketStarts[bucket + 1]; i++)
+            {
+                const Entry& entry { mBuckets[i] };
+                const Rect& other { mBoxes[entry.id] };
+                if (entry.cellX == cellX && entry.cellY == cellY && overlaps(box, other) && isFirstSharedCell(box, other, cellX, cellY))
+                {
+                    fn(static_cast<size_t>(entry.id));
+                }
+            }
+        });
+    }
+
+    // Calls fn(a, b) once for every pair of overlapping bodies, with a < b
+    template <typename Function>
+    void forEachPair(Function&& fn) const
+    {
+        for (size_t bucket = 0; bucket + 1 < mBucketStarts.size(); bucket++)
+        {
+            std::uint32_t end { mBucketStarts[bucket + 1] };
+            for (std::uint32_t i = mBucketStarts[bucket]; i != end; i++)
+            {
+                const Entry& first { mBuckets[i] };
+                for (std::uint32_t j = i + 1; j != end; j++)
+                {
+                    const Entry& second { mBuckets[j] };
+                    const Rect& a { mBoxes[first.id] };
+                    const Rect& b { mBoxes[second.id] };
+                    if (first.cellX == second.cellX && first.cellY == second.cellY && overlaps(a, b)
+                        && isFirstSharedCell(a, b, first.cellX, first.cellY))
+                    {
+                        fn(static_cast<size_t>(std::min(first.id, second.id)), static_cast<size_t>(std::max(first.id, second.id)));
+                    }
+                }
+            }
+        }
+    }
+
+    // Boxes without area overlap nothing, matching what add() and query() do with them
+    static bool overlaps(const Rect& a, const Rect& b)
+    {
+        return a.w > 0 && a.h > 0 && b.w > 0 && b.h > 0 && a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+    }
+
+private:
+    struct Entry
+    {
+        std::uint32_t id;
+        int cellX;
+        int cellY;
+    };
+
+    int mCellSize;
+    std::vector<Rect> mBoxes;
+    std::vector<Entry> mEntries;
+    std::vector<std::uint32_t> mBucketStarts;
+    std::vector<Entry> mBuckets;
+
+    // rounds towards negative infinity, the grid carries on past the origin
+    int cellOf(const int coordinate) const
+    {
+        return coordinate >= 0 ? coordinate / mCellSize : -((-coordinate - 1) / mCellSize) - 1;
+    }
+
+    size_t bucketOf(const int cellX, const int cellY) const
+    {
+        std::uint32_t hash { static_cast<std::uint32_t>(cellX) * 73856093u ^ static_cast<std::uint32_t>(cellY) * 19349663u };
+        return static_cast<size_t>(hash) & (mBucketStarts.size() - 2);
+    }
+
+    template <typename Function>
+    void forEachCell(const Rect& box, Function&& fn) const
+    {
+        int lastX { cellOf(box.x + box.w - 1) };
+        int lastY { cellOf(box.y + box.h - 1) };
+        for (int cellY = cellOf(box.y); cellY <= lastY; cellY++)
+        {
+            for (int cellX = cellOf(box.x); cellX <= lastX; cellX++)
+            {
+                fn(cellX, cellY);
+            }
+        }
+    }
+
+    // the cell holding the top left corner of the overlap is the one place a pair is reported from
+    bool isFirstSharedCell(const Rect& a, const Rect& b, const int cellX, const int cellY) const
+    {
+        return cellX == cellOf(std::max(a.x, b.x)) && cellY == cellOf(std::max(a.y, b.y));
+    }
+};
+
+#endif // SPATIALHASH_H
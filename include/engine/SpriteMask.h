@@ -0,0 +1,66 @@
+#ifndef SPRITEMASK_H
+#define SPRITEMASK_H
+
+#include "engine/Rect.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Opaque rows top <= y < bottom of one column of a mask frame, empty when top == bottom
+struct MaskColumn
+{
+    int top;
+    int bottom;
+};
+
+// Bitmasks of a sprite's opaque pixels at every whole degree of rotation, as SDL_RenderCopyEx
+// draws it turned clockwise about its centre.
+//
+// Every frame is the same square, centred on the sprite and large enough to hold it at any angle.
+// Frame pixel x, y lies over sprite pixel x + getOffsetX(), y + getOffsetY(). Each frame row is
+// getWordsPerRow() 64-bit words with bit x % 64 of word x / 64 set when pixel x is opaque
+class SpriteMask
+{
+public:
+    static constexpr int ANGLES { 360 };
+
+    SpriteMask();
+    // opacity holds width * height bytes, non-zero where the sprite is opaque
+    SpriteMask(const std::uint8_t* opacity, const int width, const int height);
+
+    bool isEmpty() const { return mRows.empty(); };
+    int getFrameSize() const { return mFrameSize; };
+    int getOffsetX() const { return mOffsetX; };
+    int getOffsetY() const { return mOffsetY; };
+    size_t getWordsPerRow() const { return mWordsPerRow; };
+
+    // The frame drawn for a nose angle in degrees, the nearest whole degree
+    static int angleIndex(const float degrees);
+
+    const std::uint64_t* rowData(const int angle, const int y) const
+    {
+        return mRows.data() + (static_cast<size_t>(angle) * static_cast<size_t>(mFrameSize) + static_cast<size_t>(y)) * mWordsPerRow;
+    };
+    // getFrameSize() columns of the frame
+    const MaskColumn* columnData(const int angle) const
+    {
+        return mColumns.data() + static_cast<size_t>(angle) * static_cast<size_t>(mFrameSize);
+    };
+    // The smallest rectangle holding the opaque pixels of a frame, in sprite coordinates
+    const Rect& getBounds(const int angle) const { return mBounds[static_cast<size_t>(angle)]; };
+
+    bool isOpaque(const int angle, const int x, const int y) const;
+
+private:
+    int mFrameSize;
+    int mOffsetX;
+    int mOffsetY;
+    size_t mWordsPerRow;
+    std::vector<std::uint64_t> mRows;
+    std::vector<MaskColumn> mColumns;
+    std::vector<Rect> mBounds;
+
+    void buildFrame(const std::uint8_t* opacity, const int width, const int height, const int angle);
+};
+
+#endif // SPRITEMASK_H
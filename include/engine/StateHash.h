@@ -0,0 +1,36 @@
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// FNV-1a over the raw bytes of values added one at a time.
+//
+// Adding fields one by one rather than whole structs keeps padding out of the hash, so two states
+// hash the same exactly when their fields hold the same bits. Cheap enough to take every step
+class StateHash
+{
+public:
+    template <typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only plain values are hashed by their bytes");
+        const unsigned char* bytes { reinterpret_cast<const unsigned char*>(&value) };
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            mValue ^= bytes[i];
+            mValue *= PRIME;
+        }
+    }
+
+    std::uint64_t getValue() const { return mValue; };
+
+private:
+    static constexpr std::uint64_t OFFSET_BASIS { 14695981039346656037ull };
+    static constexpr std::uint64_t PRIME { 1099511628211ull };
+
+    std::uint64_t mValue { OFFSET_BASIS };
+};
+
+#endif // STATEHASH_H
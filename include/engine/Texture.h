@@ -4,7 +4,10 @@
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 // Custom deleters for SDL resources
 struct SDLTextureDeleter
@@ -29,6 +32,8 @@ public:
 
     int getWidth() const { return mWidth; };
     int getHeight() const { return mHeight; };
+    // One byte per pixel, non-zero where the image is opaque. Only kept for images loaded from file
+    const std::vector<std::uint8_t>& getOpacity() const { return mOpacity; };
 
     // Set Texture to the passed value
     void setTexture(SDL_Texture *, const int, const int);
@@ -42,6 +47,9 @@ public:
     // Have SDL draw directly to the encapsulated Texture
     void setAsRenderingTarget();
 
+    // Uploads a full image of RGBA8888 pixels, pitch is the length of one row in bytes
+    bool updatePixels(const void* pixels, const int pitch);
+
     // Deallocates texture
     void reset();
 
@@ -57,6 +65,10 @@ private:
     // Image dimensions
     int mWidth;
     int mHeight;
+
+    std::vector<std::uint8_t> mOpacity;
+
+    void readOpacity(SDL_Surface*);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef TILEDTEXTURE_H
+#define TILEDTEXTURE_H
+
+#include "engine/Texture.h"
+#include <memory>
+#include <vector>
+
+// One tile's share of a view: the part of the tile to copy and where it lands relative to the view
+struct TileBlit
+{
+    size_t tile;
+    SDL_Rect source;      // in tile coordinates
+    SDL_Rect destination; // in view coordinates
+};
+
+// A large image split into fixed-size static texture pages, laid out row-major.
+// Only the pages under the view are drawn, so neither the image size nor the per-frame fill
+// cost is bounded by the renderer's maximum texture size
+class TiledTexture
+{
+public:
+    static constexpr int DEFAULT_TILE_SIZE { 1024 };
+
+    TiledTexture(SDL_Renderer*, const int tileSize = DEFAULT_TILE_SIZE);
+
+    int getWidth() const { return mWidth; };
+    int getHeight() const { return mHeight; };
+    int getTileSize() const { return mTileSize; };
+    size_t getTileCount() const { return mTiles.size(); };
+
+    // Allocates the pages covering a width x height image. The tile size is reduced
+    // to fit the renderer's maximum texture size if needed
+    bool create(const int width, const int height);
+
+    // Uploads a full image of RGBA8888 pixels, pitch is the length of one row in bytes
+    bool updatePixels(const void* pixels, const int pitch);
+
+    // Renders the part of the image under view with the view's top left corner at x, y.
+    // Returns the number of tiles drawn
+    size_t render(const SDL_Rect& view, const int x = 0, const int y = 0);
+
+    // Clips view against a width x height image cut into tileSize pages
+    static void clipToTiles(const SDL_Rect& view, const int width, const int height, const int tileSize, std::vector<TileBlit>& blits);
+
+private:
+    SDL_Renderer* mRenderer;
+    int mTileSize;
+    int mWidth;
+    int mHeight;
+    int mColumns;
+    std::vector<std::unique_ptr<Texture>> mTiles;
+    std::vector<TileBlit> mBlits; // reused between frames
+};
+
+#endif
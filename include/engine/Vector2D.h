@@ -1,58 +1,237 @@
 #ifndef VECTOR2D_H
 #define VECTOR2D_H
 
-class Vector2D
+#include "engine/Fixed.h"
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Angles are in degrees clockwise from straight up, screen y grows downwards.
+//
+// Scalar is float, or Fixed where results must be bit-exact across machines. The angle
+// functions other than heading need the maths library, so they are for floating point only
+template <typename Scalar>
+class BasicVector2D
 {
 public:
 
-    Vector2D(const float x, const float y);
+    // the zero vector, so arrays of vectors and of structs holding them can be made up front
+    constexpr BasicVector2D()
+        : mX {}
+        , mY {}
+    {
+    }
+
+    constexpr BasicVector2D(const Scalar x, const Scalar y)
+        : mX { x }
+        , mY { y }
+    {
+    }
+
+    constexpr Scalar getX() const { return mX; }
+    constexpr Scalar getY() const { return mY; }
+    constexpr Scalar getMagnitudeSquared() const { return mX * mX + mY * mY; }
+    inline Scalar getMagnitude() const;
+    inline Scalar getAngleDegrees() const;
+
+    constexpr void setX(const Scalar x) { mX = x; };
+    constexpr void setY(const Scalar y) { mY = y; };
+    inline void setMagnitude(Scalar magnitude);
+    inline void rotateTo(Scalar degrees);
+
+    // Unit vector for a whole number of degrees from 0 to 359, the direction rotateTo gives,
+    // read from a table computed at compile time
+    static inline const BasicVector2D& heading(const int degrees);
 
-    float getX() const { return mX; }
-    float getY() const { return mY; }
-    float getMagnitude() const;
-    float getAngleDegrees() const;
+    constexpr BasicVector2D& operator+=(const BasicVector2D& other)
+    {
+        mX += other.mX;
+        mY += other.mY;
+        return *this;
+    }
 
-    void setX(const float x) { mX = x; };
-    void setY(const float y) { mY = y; };
-    void setMagnitude(float magnitude);
-    void rotateTo(float degrees);
-    
-    Vector2D& operator+=(const Vector2D&);
-    Vector2D& operator-=(const Vector2D&);
-    Vector2D& operator*=(const float);
-    Vector2D& operator/=(const float);
+    constexpr BasicVector2D& operator-=(const BasicVector2D& other)
+    {
+        mX -= other.mX;
+        mY -= other.mY;
+        return *this;
+    }
+
+    constexpr BasicVector2D& operator*=(const Scalar scalar)
+    {
+        mX *= scalar;
+        mY *= scalar;
+        return *this;
+    }
+
+    constexpr BasicVector2D& operator/=(const Scalar scalar)
+    {
+        mX /= scalar;
+        mY /= scalar;
+        return *this;
+    }
 
 private:
-    float mX;
-    float mY;
+    Scalar mX;
+    Scalar mY;
+
+    static constexpr Scalar PI { static_cast<Scalar>(3.14159265358979323846) };
 };
 
-inline Vector2D operator+(const Vector2D& left, const Vector2D& right)
+using Vector2D = BasicVector2D<float>;
+using FixedVector2D = BasicVector2D<Fixed>;
+
+template <typename Scalar>
+constexpr BasicVector2D<Scalar> operator+(const BasicVector2D<Scalar>& left, const BasicVector2D<Scalar>& right)
 {
-    Vector2D result { left };
+    BasicVector2D<Scalar> result { left };
     result += right;
     return result;
 }
 
-inline Vector2D operator-(const Vector2D& left, const Vector2D& right)
+template <typename Scalar>
+constexpr BasicVector2D<Scalar> operator-(const BasicVector2D<Scalar>& left, const BasicVector2D<Scalar>& right)
 {
-    Vector2D result { left };
+    BasicVector2D<Scalar> result { left };
     result -= right;
     return result;
 }
 
-inline Vector2D operator*(const Vector2D& left, const float scalar)
+template <typename Scalar>
+constexpr BasicVector2D<Scalar> operator*(const BasicVector2D<Scalar>& left, const Scalar scalar)
 {
-    Vector2D result { left };
+    BasicVector2D<Scalar> result { left };
     result *= scalar;
     return result;
 }
 
-inline Vector2D operator/(const Vector2D& left, const float scalar)
+template <typename Scalar>
+constexpr BasicVector2D<Scalar> operator/(const BasicVector2D<Scalar>& left, const Scalar scalar)
 {
-    Vector2D result { left };
+    BasicVector2D<Scalar> result { left };
     result /= scalar;
     return result;
 }
 
-#endif // VECTOR2D_H
\ No newline at end of file
+// The same vector in another scalar, a copy when the scalar is unchanged
+template <typename To, typename From>
+constexpr BasicVector2D<To> vectorCast(const BasicVector2D<From>& vector)
+{
+    if constexpr (std::is_same_v<To, From>)
+    {
+        return vector;
+    }
+    else if constexpr (std::is_same_v<To, float>)
+    {
+        return { toFloat(vector.getX()), toFloat(vector.getY()) };
+    }
+    else
+    {
+        return { fromFloat<To>(toFloat(vector.getX())), fromFloat<To>(toFloat(vector.getY())) };
+    }
+}
+
+template <typename Scalar>
+Scalar BasicVector2D<Scalar>::getMagnitude() const
+{
+    // Fixed has its own sqrt, found by argument dependent lookup
+    using std::sqrt;
+    return sqrt(getMagnitudeSquared());
+}
+
+template <typename Scalar>
+void BasicVector2D<Scalar>::setMagnitude(Scalar magnitude)
+{
+    assert(magnitude >= Scalar { 0 });
+    Scalar currentMagnitude = getMagnitude();
+    if (currentMagnitude > Scalar { 0 })
+    {
+        // the direction is unchanged, so scaling is enough
+        *this *= magnitude / currentMagnitude;
+    }
+    // if the vector is currently length zero, we do not know what angle it should be pointing
+    // in this case, set the magnitude to point at 0 degrees
+    else
+    {
+        mX = Scalar { 0 };
+        mY = -magnitude;
+    }
+}
+
+template <typename Scalar>
+void BasicVector2D<Scalar>::rotateTo(Scalar degrees)
+{
+    static_assert(std::is_floating_point_v<Scalar>, "rotateTo needs the maths library, use heading for exact angles");
+    Scalar magnitude = getMagnitude();
+    Scalar radians = degrees * PI / 180.0f;
+    mX = magnitude * std::sin(radians);
+    mY = -magnitude * std::cos(radians);
+}
+
+template <typename Scalar>
+Scalar BasicVector2D<Scalar>::getAngleDegrees() const
+{
+    static_assert(std::is_floating_point_v<Scalar>, "getAngleDegrees needs the maths library");
+    Scalar radians = std::atan2(mX, -mY);
+    Scalar degrees = radians * 180.0f / PI;
+    return degrees >= 0.0f ? degrees : degrees + 360.0f;
+}
+
+namespace vector2d_detail
+{
+// sine and cosine of 0 to 90 degrees from their Taylor series, in double so the float result is exact
+constexpr std::pair<double, double> sinCosQuarterTurn(const int degrees)
+{
+    double x { degrees * 3.14159265358979323846 / 180.0 };
+    double sine { 0.0 };
+    double cosine { 0.0 };
+    double term { 1.0 }; // x^n / n!
+    for (int n = 0; n < 30; n++)
+    {
+        switch (n % 4)
+        {
+        case 0: cosine += term; break;
+        case 1: sine += term; break;
+        case 2: cosine -= term; break;
+        default: sine -= term; break;
+        }
+        term *= x / (n + 1);
+    }
+    return { sine, cosine };
+}
+
+template <typename Scalar>
+constexpr BasicVector2D<Scalar> makeHeading(const int degrees)
+{
+    // whole quarter turns swap and negate the components exactly, so 90, 180 and 270 are exact
+    auto [sine, cosine] = sinCosQuarterTurn(degrees % 90);
+    switch (degrees / 90)
+    {
+    case 0: return { static_cast<Scalar>(sine), static_cast<Scalar>(-cosine) };
+    case 1: return { static_cast<Scalar>(cosine), static_cast<Scalar>(sine) };
+    case 2: return { static_cast<Scalar>(-sine), static_cast<Scalar>(cosine) };
+    default: return { static_cast<Scalar>(-cosine), static_cast<Scalar>(-sine) };
+    }
+}
+
+template <typename Scalar, size_t... Degrees>
+constexpr std::array<BasicVector2D<Scalar>, sizeof...(Degrees)> makeHeadings(std::index_sequence<Degrees...>)
+{
+    return { makeHeading<Scalar>(static_cast<int>(Degrees))... };
+}
+
+template <typename Scalar>
+inline constexpr std::array<BasicVector2D<Scalar>, 360> HEADINGS { makeHeadings<Scalar>(std::make_index_sequence<360> {}) };
+}
+
+template <typename Scalar>
+const BasicVector2D<Scalar>& BasicVector2D<Scalar>::heading(const int degrees)
+{
+    assert(degrees >= 0 && degrees < 360);
+    return vector2d_detail::HEADINGS<Scalar>[static_cast<size_t>(degrees)];
+}
+
+#endif // VECTOR2D_H
@@ -0,0 +1,69 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads that are kept between runs of an index range. Each worker starts on its own
+// contiguous share, and once that is done it steals the back half of another worker's share,
+// so uneven items still keep every worker busy. The calling thread is worker 0.
+//
+// A share is a begin and end index packed into one atomic, so taking or stealing is a single
+// compare and swap and the workers never lock while items remain. A count of the items not yet
+// taken tells a worker that finds every share empty whether stolen items are still on their way
+// to the thief's share, or the run is out of work
+class WorkStealingPool
+{
+public:
+    // threads includes the caller, 0 is one per hardware thread
+    explicit WorkStealingPool(const size_t threads = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t size() const { return mThreads.size() + 1; };
+    // Items taken from another worker's share during the last run
+    size_t getStealCount() const { return mSteals.load(std::memory_order_relaxed); };
+
+    // Calls fn(index, worker) once for each index in [0, count) with worker < size(), returns when all have returned.
+    // Calls with the same worker never overlap, so per-worker state needs no locking
+    void run(const size_t count, const std::function<void(size_t, size_t)>& fn);
+
+private:
+    struct alignas(64) Share
+    {
+        std::atomic<std::uint64_t> range; // begin in the low half, end in the high half
+    };
+
+    static std::uint64_t pack(const std::uint64_t begin, const std::uint64_t end) { return begin | (end << 32); };
+    static std::uint64_t beginOf(const std::uint64_t range) { return range & 0xffffffffu; };
+    static std::uint64_t endOf(const std::uint64_t range) { return range >> 32; };
+
+    void work(const size_t worker);
+    bool take(const size_t worker, size_t& index);
+    bool steal(const size_t thief);
+    void workerLoop(const size_t worker);
+
+    std::vector<std::thread> mThreads;
+    std::unique_ptr<Share[]> mShares;
+    std::atomic<size_t> mSteals;
+    std::atomic<size_t> mUntaken; // items of this run no worker has taken yet, in a share or being moved to one
+
+    // only touched when a run starts and ends
+    std::mutex mMutex;
+    std::condition_variable mStart;
+    std::condition_variable mDone;
+    const std::function<void(size_t, size_t)>* mJob;
+    std::uint64_t mGeneration;
+    size_t mBusy;
+    bool mStop;
+};
+
+#endif // WORKSTEALINGPOOL_H
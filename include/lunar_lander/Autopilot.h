@@ -0,0 +1,96 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LanderSimulation.h"
+#include "lunar_lander/ShipBatch.h"
+#include "lunar_lander/ShipInput.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct AutopilotConfig
+{
+    size_t beamWidth;        // candidates kept from one decision to the next
+    int horizon;             // decisions looked ahead
+    int stepsPerDecision;    // simulation steps each input is held for
+    double budgetMilliseconds; // search time allowed for one decision
+};
+
+struct AutopilotStats
+{
+    std::uint64_t decisions;
+    std::uint64_t nodes;  // candidates flown forward one decision
+    double seconds;       // spent searching
+    int lastDepth;        // decisions the last search looked ahead before it finished or ran out of time
+
+    double getNodesPerSecond() const { return seconds > 0.0 ? static_cast<double>(nodes) / seconds : 0.0; };
+};
+
+// Flies the simulation's ship with a beam search over its inputs.
+//
+// At each decision every candidate is branched over the six combinations of turning and thrust,
+// the children are flown stepsPerDecision steps together in a ShipBatch, and the beamWidth best
+// are kept: landed above all, crashed below all, otherwise nearest to a glide slope down onto the
+// nearest pad, slow enough to brake in time and clear of the terrain below and ahead. The search
+// goes deeper until the horizon or the time budget is reached, then the first input of the best
+// candidate is flown until the next decision.
+//
+// The batch flies the box collision in float and knows nothing of the world's edges, so
+// plans are approximate and are made again at every decision. Nothing is allocated once the
+// batches have grown to the beam's size.
+//
+// Landing is not guaranteed. The space station is only a penalty in the score, and where it stands
+// over the nearest pad the ship can come to rest on or against it and wait there until the flight
+// runs out of time
+class Autopilot
+{
+public:
+    static constexpr int ACTION_COUNT { 6 };
+
+    // width and height are the ship sprite's, as for LanderSimulation
+    Autopilot(const int shipWidth, const int shipHeight, const AutopilotConfig&);
+
+    const AutopilotConfig& getConfig() const { return mConfig; };
+    const AutopilotStats& getStats() const { return mStats; };
+    void resetStats();
+    // Drops the held input so the next control() decides again, for when the ship was flown by something
+    // else in between or the flight was rewound
+    void reset();
+
+    // The input for this step, searching again every stepsPerDecision steps and holding the last plan's between
+    ShipInput control(const LanderSimulation&);
+    // Searches from the ship as it is now and returns the first input of the best plan
+    ShipInput decide(const LanderSimulation&);
+
+private:
+    static constexpr std::array<ShipInput, ACTION_COUNT> ACTIONS { {
+        { -1, false }, { -1, true }, { 0, false }, { 0, true }, { 1, false }, { 1, true }
+    } };
+    // LanderSimulation::step brings the nose back towards vertical when the turn is 0, ShipBatch::control
+    // holds the angle. The plans flown in the batch are only the ship's flights while that alignment is off
+    static_assert(ALIGNMENT_SPEED == 0.0f, "ShipBatch does not model alignVertical");
+
+    template <typename Terrain>
+    int search(const LanderSimulation&, const TerrainQuery<Terrain>&);
+    template <typename Terrain>
+    float score(const LanderSimulation&, const TerrainQuery<Terrain>&, const size_t child) const;
+    bool isLanded(const LanderSimulation&, const ShipBatch&, const size_t ship) const;
+
+    AutopilotConfig mConfig;
+    float mShipWidth;
+    float mShipHeight;
+    ShipBatch mBeam;
+    ShipBatch mChildren;
+    std::vector<std::uint8_t> mBeamActions;  // the first action of each candidate's plan
+    std::vector<std::uint8_t> mChildActions;
+    std::vector<ShipInput> mInputs;
+    std::vector<float> mScores;
+    std::vector<size_t> mOrder;
+    ShipInput mHeld;
+    int mStepsUntilDecision;
+    AutopilotStats mStats;
+};
+
+#endif // AUTOPILOT_H
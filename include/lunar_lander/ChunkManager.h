@@ -0,0 +1,101 @@
+#ifndef CHUNKMANAGER_H
+#define CHUNKMANAGER_H
+
+#include "engine/Rect.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include "lunar_lander/TerrainHeightmap.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// A generated slice of the world, chunkWidth columns wide
+struct TerrainChunk
+{
+    size_t index;
+    TerrainHeightmap terrain;
+    std::uint64_t lastUsed; // update() stamp of the last time the chunk was wanted
+};
+
+// Streams a world that is too wide to hold at once as fixed-width chunks
+//
+// Each chunk's landing pads come from its own seeded generator, and its rock columns continue
+// the noise where the previous chunk left off, so a chunk is the same whenever and in whatever
+// order it is generated. Chunks under the view are generated immediately, one more per update
+// is generated ahead of the direction of travel, and the least recently wanted chunks are
+// evicted once more than maxResidentChunks are resident
+class ChunkManager
+{
+public:
+    // config.worldWidth is the full world width. The last chunk is generated whole, but its columns
+    // past the world's edge read as empty and hold no landing pads
+    ChunkManager(const TerrainGenerationConfig&, const int averageNumberOfLandingPads, const size_t chunkWidth, const size_t maxResidentChunks);
+
+    size_t getWidth() const { return mConfig.worldWidth; };
+    size_t getHeight() const { return mConfig.worldHeight; };
+    size_t getChunkWidth() const { return mChunkWidth; };
+    size_t getChunkCount() const { return mChunkCount; };
+    size_t getResidentChunkCount() const { return mChunks.size(); };
+    size_t getGeneratedChunkCount() const { return mGeneratedChunkCount; };
+
+    // Makes the chunks under view resident, prefetches along velocityX (pixels per update) and evicts
+    void update(const Rect& view, const float velocityX);
+
+    // Generates a chunk if it is not resident, and marks it as in use
+    const TerrainChunk& requireChunk(const size_t index);
+
+    // Resident chunk or null
+    const TerrainChunk* findChunk(const size_t index) const;
+
+    // Landing pads of a chunk in chunk coordinates, known for every chunk whether resident or not
+    const std::vector<TerrainGenerator::PadInterval>& getLandingPads(const size_t index) const { return mLandingPads[index]; };
+
+    // Every pad in the world in world coordinates, whether its chunk is resident or not
+    const LandingPadIndex& getLandingPadIndex() const { return mLandingPadIndex; };
+
+    // No chunk generated so far has a surface above this row
+    int getMinSurface() const { return mMinSurface; };
+    // Highest surface row of the columns [begin, end) that are resident
+    int getMinSurface(const size_t begin, const size_t end) const;
+
+    // Columns of chunks that are not resident, or past the world's edge, read as empty
+    int getSurface(const size_t x) const;
+    bool isLandingPad(const size_t x) const;
+
+    // Calls visit with every resident chunk, in no particular order
+    template <typename Visit>
+    void forEachResidentChunk(Visit&& visit) const
+    {
+        for (const auto& chunk : mChunks)
+        {
+            const TerrainChunk& resident { *chunk.second };
+            visit(resident);
+        }
+    }
+
+private:
+    static constexpr float PREFETCH_UPDATES { 120.0f }; // how far ahead of the ship to look, in updates at its current velocity
+
+    void generateChunk(TerrainChunk&);
+    void evict();
+
+    TerrainGenerationConfig mConfig;
+    TerrainGenerationConfig mChunkConfig; // as mConfig, one chunk wide
+    size_t mChunkWidth;
+    size_t mChunkCount;
+    size_t mMaxResidentChunks;
+    TerrainGenerator mGenerator;
+
+    // per chunk, for every chunk in the world
+    std::vector<std::vector<TerrainGenerator::PadInterval>> mLandingPads;
+    std::vector<size_t> mNoiseOrigin;
+    std::vector<size_t> mFirstPad; // into mLandingPadIndex
+    LandingPadIndex mLandingPadIndex;
+
+    std::unordered_map<size_t, std::unique_ptr<TerrainChunk>> mChunks;
+    int mMinSurface;
+    std::uint64_t mUpdateCount;
+    size_t mGeneratedChunkCount;
+};
+
+#endif // CHUNKMANAGER_H
@@ -1,6 +1,7 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <cstdint>
 #include <string>
 
 // Screen/Viewport dimensions (what player sees)
@@ -26,11 +27,26 @@ constexpr float TERRAIN_HEIGHT_VARIATION { 0.35f };   // fraction of WORLD_HEIGH
 constexpr int PERLIN_OCTAVES { 4 };                  // Perlin Noise 1D parameter
 constexpr double PERLIN_PERSISTENCE { 0.5 };         // Perlin Noise 1D parameter 
 constexpr double PERLIN_FREQUENCY { 0.0025 };        // Perlin Noise 1D parameter
+constexpr bool TERRAIN_USE_NOISE_TABLE { false };    // interpolate terrain noise from a NoiseTable instead of exact noise
+constexpr bool STARFIELD_USE_NOISE_TABLES { false }; // opt-in: interpolate starfield noise from NoiseTables, which draws a slightly different sky
+constexpr const char* TERRAIN_SEED_VARIABLE { "LUNAR_LANDER_SEED" }; // environment variable fixing the terrain seed
+const std::string TERRAIN_CACHE_DIRECTORY { "terrain_cache" };       // fixed seed worlds are cached here
+constexpr bool TERRAIN_STREAM_CHUNKS { false };      // opt-in: generate a wider world in chunks around the camera instead of all up front
+constexpr int STREAMED_WORLD_WIDTH { WORLD_WIDTH * 100 }; // world width when streaming chunks
+constexpr size_t TERRAIN_CHUNK_WIDTH { 1024 };       // columns per streamed chunk
+constexpr size_t TERRAIN_MAX_RESIDENT_CHUNKS { 12 }; // a chunk count, not bytes: each chunk's texture is about 5.5 MB of pixels
+constexpr int BROADPHASE_CELL_SIZE { 64 };           // spatial hash cell for body against body tests, about two ships across
+constexpr size_t REWIND_HISTORY_STEPS { 600 };       // snapshots kept for rewinding, ten seconds of steps
+constexpr size_t REWIND_STEPS { 120 };               // how far back B goes after a crash
+constexpr size_t AUTOPILOT_BEAM_WIDTH { 32 };        // candidates the autopilot keeps at each decision
+constexpr int AUTOPILOT_HORIZON { 20 };              // decisions it looks ahead
+constexpr int AUTOPILOT_STEPS_PER_DECISION { 10 };   // steps each of its inputs is held for, a sixth of a second
+constexpr double AUTOPILOT_BUDGET_MILLISECONDS { 8.0 }; // search time for a decision, half of a frame at 60 Hz
 
 // Terrain values
-constexpr int TERRAIN_VACUUM { 0 };
-constexpr int TERRAIN_ROCK { 1 };
-constexpr int TERRAIN_LANDING_PAD { 2 };
+constexpr std::uint8_t TERRAIN_VACUUM { 0 };
+constexpr std::uint8_t TERRAIN_ROCK { 1 };
+constexpr std::uint8_t TERRAIN_LANDING_PAD { 2 };
 
 // Landing pads
 constexpr unsigned int MIN_LANDING_PAD_WIDTH { 50 };
@@ -40,4 +56,10 @@ constexpr unsigned int MAX_LANDING_PAD_WIDTH { 100 };
 constexpr std::string_view SPACESHIP_TEXTURE { "spaceship.bmp" };
 constexpr std::string_view SPACESTATION_TEXTURE { "spacestation.bmp" };
 
+// Sprite sizes of those textures, for simulations that run without loading them
+constexpr int SPACESHIP_WIDTH { 30 };
+constexpr int SPACESHIP_HEIGHT { 31 };
+constexpr int SPACESTATION_WIDTH { 115 };
+constexpr int SPACESTATION_HEIGHT { 85 };
+
 #endif // CONSTANTS_H
@@ -11,6 +11,10 @@ struct FlightStats
     float xAccel;
     float yAccel;
     float thrustUnits;
+    float padOffset; // to the nearest landing pad, negative when it is to the left, NaN if there are none
+    float radarAltitude; // from the bottom of the ship straight down to the terrain, NaN if unknown
+    float autopilotNodesPerSecond; // the autopilot's search speed, NaN when it is not flying the ship
+    float autopilotDepth; // decisions the autopilot's last search looked ahead, NaN when it is not flying the ship
 };
 
 #endif  // FLIGHTSTATS_H
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "lunar_lander/FlightStats.h"
 #include <engine/Texture.h>
+#include <array>
 #include <memory>
 #include <vector>
 #include <string>
@@ -33,6 +34,10 @@ private:
         X_VEL,
         Y_VEL,
         THRUST_UNITS,
+        PAD_OFFSET,
+        RADAR_ALTITUDE,
+        AUTOPILOT_SPEED,
+        AUTOPILOT_DEPTH,
         TOTAL
     };
 
@@ -43,7 +48,11 @@ private:
         "Y Pos: ",
         "X Vel: ",
         "Y Vel: ",
-        "Thrust: "
+        "Thrust: ",
+        "Pad: ",
+        "Alt: ",
+        "Search: ",
+        "Ahead: "
     };
     // the length of the longest display name, plus some chars for the dynamic data
     // multiplied by an estimate of the number of pixels used per char
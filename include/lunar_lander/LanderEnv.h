@@ -0,0 +1,110 @@
+#ifndef LANDERENV_H
+#define LANDERENV_H
+
+#include "lunar_lander/LanderSimulation.h"
+#include "lunar_lander/ShipInput.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The lander as a reinforcement learning environment: reset(seed) starts an episode, step(action) flies it.
+//
+// An observation is a fixed array of floats, the ship's state from FlightStats scaled to around one,
+// then the distances along rays fanned out below the ship to the terrain. Actions are the six
+// combinations of turning and thrust. The reward is a shaping term for getting closer to a pad
+// and slowing down, less the thrust used, with a bonus for landing and a penalty for crashing.
+// An episode is done when the ship lands or crashes, or after maxSteps.
+//
+// Nothing is allocated after a world is created, and reset keeps the world when the seed is unchanged
+class LanderEnv
+{
+public:
+    enum ObservationIndex : size_t
+    {
+        NOSE_SINE,
+        NOSE_COSINE,
+        VELOCITY_X,
+        VELOCITY_Y,
+        THRUST,
+        PAD_OFFSET,
+        ALTITUDE,
+        FIRST_RAY
+    };
+    static constexpr size_t RAY_COUNT { 7 };                // every 30 degrees from pointing right, round underneath, to pointing left
+    static constexpr size_t OBSERVATION_SIZE { FIRST_RAY + RAY_COUNT };
+    static constexpr int ACTION_COUNT { 6 };                // (turn + 1) * 2 + thrust
+    static constexpr float RAY_LENGTH { 256.0f };           // a ray that reaches nothing reads 1
+    static constexpr float DISTANCE_SCALE { 1.0f / 1000.0f }; // pixels to observation units
+    static constexpr float LANDING_REWARD { 100.0f };
+    static constexpr float CRASH_REWARD { -100.0f };
+    static constexpr float FUEL_COST { 0.03f };             // per step at full thrust
+
+    using Observation = std::array<float, OBSERVATION_SIZE>;
+
+    struct Transition
+    {
+        Observation observation;
+        float reward;
+        bool done;
+    };
+
+    LanderEnv(const TerrainGenerationConfig&, const int landingPads, const int maxSteps);
+
+    static ShipInput decodeAction(const int action);
+
+    Observation reset(const unsigned int seed);
+    Transition step(const int action);
+
+    // As above, writing the observation to OBSERVATION_SIZE floats at observation
+    void reset(const unsigned int seed, float* observation);
+    float step(const int action, float* observation, bool& done);
+
+    const LanderSimulation& getSimulation() const { return mSimulation; };
+    int getStepCount() const { return mSteps; };
+
+private:
+    void observe(float* observation) const;
+    static float potential(const float* observation);
+
+    TerrainGenerationConfig mConfig;
+    int mLandingPads;
+    int mMaxSteps;
+    bool mHasWorld;
+    LanderSimulation mSimulation;
+    int mSteps;
+    float mPotential;
+};
+
+// Many LanderEnvs stepped in one call, reading one action per environment and writing
+// into contiguous buffers that are allocated once: a row of OBSERVATION_SIZE floats,
+// a reward and a done flag per environment.
+//
+// An environment that finishes is reset straight away in the same world, so its row then holds
+// the first observation of the next episode while its reward and done flag are the last step's
+class VectorEnv
+{
+public:
+    VectorEnv(const size_t count, const TerrainGenerationConfig&, const int landingPads, const int maxSteps);
+
+    size_t size() const { return mEnvs.size(); };
+
+    // Environment i starts on seeds[i]
+    void reset(const unsigned int* seeds);
+    void step(const int* actions);
+
+    const float* getObservations() const { return mObservations.data(); };
+    const float* getRewards() const { return mRewards.data(); };
+    const std::uint8_t* getDones() const { return mDones.data(); };
+    const LanderEnv& getEnv(const size_t i) const { return mEnvs[i]; };
+
+private:
+    std::vector<LanderEnv> mEnvs;
+    std::vector<unsigned int> mSeeds;
+    std::vector<float> mObservations;
+    std::vector<float> mRewards;
+    std::vector<std::uint8_t> mDones;
+};
+
+#endif // LANDERENV_H
@@ -0,0 +1,113 @@
+#ifndef LANDERSIMULATION_H
+#define LANDERSIMULATION_H
+
+#include "engine/Rect.h"
+#include "engine/SpatialHash.h"
+#include "engine/SpriteMask.h"
+#include "lunar_lander/ChunkManager.h"
+#include "lunar_lander/FlightStats.h"
+#include "lunar_lander/LandingPadIndex.h"
+#include "lunar_lander/ShipInput.h"
+#include "lunar_lander/Spaceship.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include "lunar_lander/TerrainHeightmap.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// The world, the player's ship and the step that moves it, with no window, renderer or keyboard.
+//
+// Inputs come in as ShipInput and sprites are only their sizes, so flights can be run without a display.
+// LunarLanderEngine draws one of these and feeds it the keyboard
+class LanderSimulation
+{
+public:
+    // The state of a flight as plain values, 80 bytes or 136 in fixed point. The world is not copied,
+    // only its handle, so a snapshot restores into the simulation it came from while that world lasts
+    struct Snapshot
+    {
+        std::uint32_t world;
+        std::uint64_t tick;
+        Spaceship::State ship;
+    };
+
+    LanderSimulation();
+    LanderSimulation(const int shipWidth, const int shipHeight, const int stationWidth, const int stationHeight);
+
+    // Generates the whole world up front, then places the station and a ship at rest in the middle
+    void createWorld(const TerrainGenerationConfig&, const int landingPads);
+    // As above with terrain that was already generated, e.g. read from a TerrainCache
+    void createWorld(const TerrainGenerationConfig&, TerrainHeightmap&&, const std::vector<TerrainGenerator::PadInterval>&);
+    // Streams the world as chunks around a viewWidth x viewHeight view that follows the ship
+    void createStreamedWorld(const TerrainGenerationConfig&, const int landingPads, const size_t chunkWidth, const size_t maxResidentChunks,
+        const int viewWidth, const int viewHeight);
+
+    // A new ship at rest in the middle of the current world, which is kept as it is
+    void respawn();
+
+    Snapshot saveState() const;
+    // Puts the flight back as it was when the snapshot was saved. Returns false, changing nothing,
+    // when the snapshot is from another world. Streamed chunks follow the ship on the next step
+    bool restoreState(const Snapshot&);
+
+    // Collide using the sprite's opaque pixels, the mask must outlive the simulation, nullptr goes back to the box
+    void setCollisionMask(const SpriteMask*);
+
+    // One fixed step of the controls, physics and collisions. Returns true if the ship crashed during it,
+    // after which the ship is destroyed and further steps leave it where it is
+    bool step(const ShipInput&);
+
+    bool isCrashed() const { return mShip.isDestroyed(); };
+    // Steps flown since the world was created or the ship respawned
+    std::uint64_t getTick() const { return mTick; };
+    // At rest on a landing pad
+    bool isLanded() const;
+    // The same test for any ship in this world, e.g. an Autopilot's candidates: not crashed, at rest, and
+    // over a pad less than a pixel above it. x and bottom are the middle of the bottom of its collision box
+    bool isLanded(const bool crashed, const float velocityX, const float velocityY, const float x, const float bottom) const;
+    const Spaceship& getShip() const { return mShip; };
+    const Rect& getSpacestation() const { return mSpacestation; };
+    int getWorldWidth() const { return mWorldWidth; };
+    int getWorldHeight() const { return mWorldHeight; };
+    // Null unless the world is streamed, then getTerrain is empty
+    const ChunkManager* getTerrainChunks() const { return mTerrainChunks.get(); };
+    const TerrainHeightmap& getTerrain() const { return mTerrain; };
+    // the highest terrain surface, to build a TerrainQuery over getTerrain without a scan
+    int getTerrainTop() const { return mTerrainTop; };
+    const LandingPadIndex& getLandingPadIndex() const;
+    FlightStats getFlightStats() const;
+    // Hash of everything a step changes, to take every step and compare between runs or machines.
+    // Fixed point builds give the same sequence everywhere, the first step that differs is where two runs diverged
+    std::uint64_t getStateHash() const;
+
+    // A width x height view centred on the ship as drawn alpha of the way through the last step,
+    // clamped to the world
+    Rect getView(const int width, const int height, const float alpha) const;
+
+private:
+    void placeSpacestation();
+    void spawnShip();
+    void handleBodyCollisions();
+
+    int mShipWidth;
+    int mShipHeight;
+    int mStationWidth;
+    int mStationHeight;
+    int mWorldWidth;
+    int mWorldHeight;
+    int mViewWidth;  // streamed chunks are kept resident under this view
+    int mViewHeight;
+    std::uint32_t mWorld; // handle of the current world, new for every world created
+    std::uint64_t mTick;
+
+    TerrainHeightmap mTerrain;
+    int mTerrainTop; // mTerrain's getMinSurface, the scan is kept out of the step
+    std::unique_ptr<ChunkManager> mTerrainChunks; // replaces mTerrain when streaming chunks
+    LandingPadIndex mLandingPadIndex;
+    Spaceship mShip;
+    const SpriteMask* mCollisionMask;
+    Rect mSpacestation; // a static body, in world coordinates
+    SpatialHash mBodies;    // the static bodies, built with the world
+};
+
+#endif // LANDERSIMULATION_H
@@ -0,0 +1,66 @@
+#ifndef LANDINGPADINDEX_H
+#define LANDINGPADINDEX_H
+
+#include "lunar_lander/TerrainHeightmap.h"
+#include <cstddef>
+#include <vector>
+
+struct LandingPad
+{
+    size_t start;
+    size_t width;
+    int surface; // row of the pad's top, as TerrainHeightmap::getSurface
+
+    size_t end() const { return start + width; };
+};
+
+// Landing pads of a world sorted by x, with binary search queries
+// Pads never overlap, so sorting by start also sorts them by end
+class LandingPadIndex
+{
+public:
+    LandingPadIndex();
+    explicit LandingPadIndex(std::vector<LandingPad> pads);
+
+    // Reads each pad's surface from the terrain
+    template <typename Interval>
+    static LandingPadIndex fromIntervals(const TerrainHeightmap&, const std::vector<Interval>&);
+
+    size_t size() const { return mPads.size(); };
+    bool isEmpty() const { return mPads.empty(); };
+    const LandingPad& operator[](const size_t i) const { return mPads[i]; };
+    const std::vector<LandingPad>& getPads() const { return mPads; };
+    void setSurface(const size_t i, const int surface) { mPads[i].surface = surface; };
+
+    // Pad covering column x, or null
+    const LandingPad* padAt(const float x) const;
+
+    // Pad with the least horizontal distance to x, ties going left, or null if there are none
+    const LandingPad* nearest(const float x) const;
+
+    // First pad starting right of x, or null
+    const LandingPad* next(const float x) const;
+
+    // Horizontal distance from x to the pad: 0 over it, negative when the pad is to the left
+    static float offsetTo(const LandingPad&, const float x);
+
+private:
+    // index of the first pad starting right of x
+    size_t upperBound(const float x) const;
+
+    std::vector<LandingPad> mPads;
+};
+
+template <typename Interval>
+LandingPadIndex LandingPadIndex::fromIntervals(const TerrainHeightmap& terrain, const std::vector<Interval>& intervals)
+{
+    std::vector<LandingPad> pads {};
+    pads.reserve(intervals.size());
+    for (const auto& interval : intervals)
+    {
+        pads.push_back({ interval.start, interval.width, terrain.getSurface(interval.start) });
+    }
+    return LandingPadIndex(std::move(pads));
+}
+
+#endif // LANDINGPADINDEX_H
@@ -0,0 +1,98 @@
+#ifndef LATTICE_NOISE_1D_H
+#define LATTICE_NOISE_1D_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+
+// PerlinNoise1D's octave noise at whole number coordinates, in integers only.
+//
+// Positions along the lattice carry 32 fractional bits and the noise 16, so the result is the same
+// on every compiler and CPU, where the double version depends on rounding, contraction and the
+// standard library. The permutation is shuffled by hand from the raw engine output, since
+// std::shuffle is free to differ between standard libraries. Close to PerlinNoise1D's terrain,
+// but not the same, the permutation differs
+class LatticeNoise1D
+{
+public:
+    static constexpr int FRACTION_BITS { 16 };
+    static constexpr std::int64_t ONE { std::int64_t { 1 } << FRACTION_BITS };
+
+    inline explicit LatticeNoise1D(unsigned int seed);
+
+    // octaveNoise(x, ...) of PerlinNoise1D in 1/65536ths, in about [-65536, 65536].
+    // persistence and frequency are rounded to 1/65536 and 1/2^32 first, which is exact for the same inputs everywhere
+    inline std::int64_t octaveNoise(std::uint64_t x, int octaves, double persistence, double frequency) const;
+
+private:
+    static constexpr size_t PERMUTATION_SIZE { 256 };
+    static constexpr int POSITION_FRACTION_BITS { 32 };
+    std::array<std::uint8_t, PERMUTATION_SIZE * 2> mPermutation;
+
+    // One octave, position in lattice cells with POSITION_FRACTION_BITS after the point
+    inline std::int64_t noise(std::uint64_t position) const;
+
+    // 6t^5 - 15t^4 + 10t^3 on t in [0, ONE)
+    inline static std::int64_t fade(std::int64_t t);
+};
+
+LatticeNoise1D::LatticeNoise1D(unsigned int seed)
+{
+    std::array<std::uint8_t, PERMUTATION_SIZE> p;
+    std::iota(p.begin(), p.end(), std::uint8_t { 0 });
+
+    // Fisher-Yates from the engine's output, which the standard does fix
+    std::mt19937 generator(seed);
+    for (size_t i = PERMUTATION_SIZE - 1; i > 0; --i)
+    {
+        std::swap(p[i], p[generator() % (i + 1)]);
+    }
+
+    for (size_t i = 0; i < PERMUTATION_SIZE; ++i)
+    {
+        mPermutation[i] = p[i];
+        mPermutation[i + PERMUTATION_SIZE] = p[i];
+    }
+}
+
+std::int64_t LatticeNoise1D::fade(std::int64_t t)
+{
+    std::int64_t inner { ((t * (6 * t - 15 * ONE)) >> FRACTION_BITS) + 10 * ONE };
+    std::int64_t cube { (((t * t) >> FRACTION_BITS) * t) >> FRACTION_BITS };
+    return (cube * inner) >> FRACTION_BITS;
+}
+
+std::int64_t LatticeNoise1D::noise(std::uint64_t position) const
+{
+    size_t cell { (position >> POSITION_FRACTION_BITS) & (PERMUTATION_SIZE - 1) };
+    std::int64_t t { static_cast<std::int64_t>((position >> (POSITION_FRACTION_BITS - FRACTION_BITS)) & (ONE - 1)) };
+
+    // the gradient is +1 or -1 by the low bit of the hash, as in PerlinNoise1D
+    std::int64_t a { (mPermutation[cell] & 1) ? t : -t };
+    std::int64_t b { (mPermutation[cell + 1] & 1) ? t - ONE : ONE - t };
+    return a + ((fade(t) * (b - a)) >> FRACTION_BITS);
+}
+
+std::int64_t LatticeNoise1D::octaveNoise(std::uint64_t x, int octaves, double persistence, double frequency) const
+{
+    std::uint64_t step { static_cast<std::uint64_t>(frequency * 4294967296.0 + 0.5) };
+    std::int64_t falloff { static_cast<std::int64_t>(persistence * static_cast<double>(ONE) + 0.5) };
+    std::int64_t value { 0 };
+    std::int64_t amplitude { ONE };
+    std::int64_t maxValue { 0 };
+
+    for (int i = 0; i < octaves; ++i)
+    {
+        value += (noise(x * step) * amplitude) >> FRACTION_BITS;
+        maxValue += amplitude;
+        amplitude = (amplitude * falloff) >> FRACTION_BITS;
+        step *= 2;
+    }
+
+    return maxValue == 0 ? 0 : value * ONE / maxValue;
+}
+
+#endif // LATTICE_NOISE_1D_H
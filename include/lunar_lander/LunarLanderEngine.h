@@ -2,11 +2,14 @@
 #define LUNARLANDERENGINE_H
 
 #include "engine/BaseEngine.h"
+#include "engine/SnapshotRing.h"
 #include "engine/Timer.h"
+#include "lunar_lander/Autopilot.h"
 #include "lunar_lander/Constants.h"
-#include "lunar_lander/Spaceship.h"
+#include "lunar_lander/LanderSimulation.h"
 #include "lunar_lander/StarfieldGenerator.h"
-#include "lunar_lander/TerrainGenerator.h"
+#include "lunar_lander/TerrainCache.h"
+#include "lunar_lander/TerrainTextures.h"
 #include "lunar_lander/HeadsUpDisplay.h"
 
 enum class GameState {
@@ -14,6 +17,7 @@ enum class GameState {
     DEATH
 };
 
+// Draws a LanderSimulation and steps it with the keyboard
 class LunarLanderEngine : public BaseEngine
 {
 public:
@@ -25,20 +29,29 @@ private:
     bool update() override;
     bool render() override;
     
-    void generateTerrain();
+    void generateWorld();
     void generateBackground();
-    void spawnPlayer();
     void createHeadsUpDisplay();
+    FlightStats getFlightStats() const;
+    Rect getCameraView(const float) const;
+    ShipInput readInput() const;
     
     bool updatePlaying();
     bool updateDeath();
+    void rewind();
 
-    std::vector<std::vector<int>> mTerrain;     // for collision physics
-    Spaceship mPlayer;
-    TerrainGenerator mTerrainGenerator;
+    const int mWorldWidth { TERRAIN_STREAM_CHUNKS ? STREAMED_WORLD_WIDTH : WORLD_WIDTH };
+    LanderSimulation mSimulation;  // the world and the player's ship
+    SpriteMask mSpaceshipMask;     // per-angle opaque pixels of the spaceship for collision
+    TerrainTextures mTerrainTextures;
+    TerrainCache mTerrainCache { TERRAIN_CACHE_DIRECTORY };
     StarfieldGenerator mStarfieldGenerator;
     HeadsUpDisplay mHeadsUpDisplay;
     Timer mHudUpdateTimer{500};  // Update HUD every 500ms
+    SnapshotRing<LanderSimulation::Snapshot> mHistory { REWIND_HISTORY_STEPS }; // the flight before each recent step
+    Autopilot mAutopilot { SPACESHIP_WIDTH, SPACESHIP_HEIGHT,
+        AutopilotConfig { AUTOPILOT_BEAM_WIDTH, AUTOPILOT_HORIZON, AUTOPILOT_STEPS_PER_DECISION, AUTOPILOT_BUDGET_MILLISECONDS } };
+    bool mAutopilotEngaged = false; // flies the ship instead of the keyboard
     
     GameState mCurrentState = GameState::PLAYING;
 };
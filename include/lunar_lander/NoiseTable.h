@@ -0,0 +1,95 @@
+#ifndef NOISE_TABLE_H
+#define NOISE_TABLE_H
+
+#include "PerlinNoise1D.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Pre-sampled octave noise over a fixed domain, answered by linear interpolation
+// Trades a one-off batch of octaveNoise calls for a couple of loads per query
+class NoiseTable
+{
+public:
+    NoiseTable();
+
+    // Samples noise.octaveNoise(x, octaves, persistence, frequency) over [xMin, xMax]
+    // samplesPerCell: table entries per lattice cell of the highest frequency octave
+    // Queries outside the domain are clamped to its ends
+    inline NoiseTable(const PerlinNoise1D& noise, int octaves, double persistence, double frequency,
+        double xMin, double xMax, double samplesPerCell = 16.0);
+
+    inline double sample(double x) const;
+
+    // Largest difference from the exact noise any query inside the domain can have, from the
+    // interpolation error bound spacing^2 / 8 * max |f''|
+    double getErrorBound() const { return mErrorBound; }
+    size_t getSize() const { return mSamples.size(); }
+    bool isEmpty() const { return mSamples.empty(); }
+
+private:
+    double mXMin;
+    double mSpacing;
+    double mInverseSpacing;
+    double mErrorBound;
+    std::vector<double> mSamples;
+};
+
+inline NoiseTable::NoiseTable()
+    : mXMin { 0.0 }
+    , mSpacing { 1.0 }
+    , mInverseSpacing { 1.0 }
+    , mErrorBound { 0.0 }
+    , mSamples {}
+{
+}
+
+NoiseTable::NoiseTable(const PerlinNoise1D& noise, int octaves, double persistence, double frequency,
+    double xMin, double xMax, double samplesPerCell)
+    : NoiseTable()
+{
+    // the highest octave runs at frequency * 2^(octaves - 1) lattice cells per unit of x
+    double highestFrequency { frequency * std::pow(2.0, std::max(0, octaves - 1)) };
+    double domain { std::max(xMax - xMin, 0.0) };
+    size_t intervals { std::max<size_t>(1, static_cast<size_t>(std::ceil(domain * highestFrequency * samplesPerCell))) };
+
+    mXMin = xMin;
+    mSpacing = std::max(domain, 1e-9) / static_cast<double>(intervals);
+    mInverseSpacing = 1.0 / mSpacing;
+
+    std::vector<double> xs(intervals + 1);
+    for (size_t i = 0; i <= intervals; ++i)
+    {
+        xs[i] = xMin + static_cast<double>(i) * mSpacing;
+    }
+    mSamples.resize(xs.size());
+    noise.octaveNoiseBatch(xs.data(), mSamples.data(), xs.size(), octaves, persistence, frequency);
+
+    // One octave's second derivative is at most 7.5, at the middle of a cell whose corner gradients
+    // differ, times the square of its frequency. The sum is normalised like octaveNoise
+    double curvature { 0.0 };
+    double amplitude { 1.0 };
+    double maxValue { 0.0 };
+    double octaveFrequency { frequency };
+    for (int i = 0; i < octaves; ++i)
+    {
+        curvature += std::fabs(amplitude) * 7.5 * octaveFrequency * octaveFrequency;
+        maxValue += amplitude;
+        amplitude *= persistence;
+        octaveFrequency *= 2.0;
+    }
+    if (maxValue != 0.0)
+    {
+        mErrorBound = mSpacing * mSpacing / 8.0 * curvature / std::fabs(maxValue);
+    }
+}
+
+double NoiseTable::sample(double x) const
+{
+    double position { std::clamp((x - mXMin) * mInverseSpacing, 0.0, static_cast<double>(mSamples.size() - 1)) };
+    size_t index { std::min(static_cast<size_t>(position), mSamples.size() - 2) };
+    double t { position - static_cast<double>(index) };
+    return mSamples[index] + t * (mSamples[index + 1] - mSamples[index]);
+}
+
+#endif // NOISE_TABLE_H
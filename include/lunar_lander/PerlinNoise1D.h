@@ -1,10 +1,17 @@
 #ifndef PERLIN_NOISE_1D_H
 #define PERLIN_NOISE_1D_H
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <random>
 #include <iostream>
+#include <numeric>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 class PerlinNoise1D
 {
@@ -22,9 +29,18 @@ public:
     // frequency: frequency multiplier for input (higher = more compressed)
     inline double octaveNoise(double x, int octaves, double persistence = 0.5, double frequency = 1.0) const;
 
+    // Batched octaveNoise: out[i] = octaveNoise(xs[i], ...) for i in [0, n)
+    // Uses AVX2 when the build targets it, otherwise the same arithmetic one sample at a time
+    inline void octaveNoiseBatch(const double* xs, double* out, size_t n, int octaves, double persistence = 0.5, double frequency = 1.0) const;
+
 private:
     static constexpr int PERMUTATION_SIZE = 256;
+    static constexpr size_t BATCH_BLOCK_SIZE = 8;
     std::array<int, PERMUTATION_SIZE * 2> mPermutation;
+
+    // The 1D gradient only depends on the low bit of the hash, so the batch path
+    // gathers +1.0 / -1.0 directly from this table instead of branching on the hash
+    std::array<double, PERMUTATION_SIZE * 2> mGradientSign;
     
     // Initialize permutation table with given seed
     inline void initializePermutation(unsigned int seed);
@@ -37,6 +53,9 @@ private:
     
     // Gradient function for 1D noise
     inline static double grad(int hash, double x);
+
+    // Adds amplitude * noise(x * frequency) for one octave of a block of samples
+    inline void accumulateOctaveBlock(const double* xs, double* values, size_t count, double frequency, double amplitude) const;
 };
 
 PerlinNoise1D::PerlinNoise1D(unsigned int seed)
@@ -61,6 +80,10 @@ void PerlinNoise1D::initializePermutation(unsigned int seed)
         mPermutation[i] = p[i];
         mPermutation[i + PERMUTATION_SIZE] = p[i];
     }
+    for (size_t i = 0; i < mGradientSign.size(); ++i)
+    {
+        mGradientSign[i] = grad(mPermutation[i], 1.0);
+    }
 }
 
 double PerlinNoise1D::fade(double t)
@@ -116,4 +139,81 @@ double PerlinNoise1D::octaveNoise(double x, int octaves, double persistence, dou
     return value / maxValue;
 }
 
+void PerlinNoise1D::octaveNoiseBatch(const double* xs, double* out, size_t n, int octaves, double persistence, double frequency) const
+{
+    for (size_t start = 0; start < n; start += BATCH_BLOCK_SIZE)
+    {
+        size_t count = std::min(BATCH_BLOCK_SIZE, n - start);
+        std::array<double, BATCH_BLOCK_SIZE> values {};
+        double amplitude = 1.0;
+        double maxValue = 0.0;
+        double octaveFrequency = frequency;
+
+        // same octave order and arithmetic as octaveNoise, so each lane matches the scalar result
+        for (int i = 0; i < octaves; ++i)
+        {
+            accumulateOctaveBlock(xs + start, values.data(), count, octaveFrequency, amplitude);
+            maxValue += amplitude;
+            amplitude *= persistence;
+            octaveFrequency *= 2.0;
+        }
+
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            out[start + lane] = values[lane] / maxValue;
+        }
+    }
+}
+
+void PerlinNoise1D::accumulateOctaveBlock(const double* xs, double* values, size_t count, double frequency, double amplitude) const
+{
+    size_t lane = 0;
+
+#if defined(__AVX2__)
+    const __m256d frequencies = _mm256_set1_pd(frequency);
+    const __m256d amplitudes = _mm256_set1_pd(amplitude);
+    const __m256d ones = _mm256_set1_pd(1.0);
+    const __m256d sixes = _mm256_set1_pd(6.0);
+    const __m256d fifteens = _mm256_set1_pd(15.0);
+    const __m256d tens = _mm256_set1_pd(10.0);
+    const __m256d cellCount = _mm256_set1_pd(PERMUTATION_SIZE);
+    const __m256d inverseCellCount = _mm256_set1_pd(1.0 / PERMUTATION_SIZE);
+    const __m256d gatherAll = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    for (; lane + 4 <= count; lane += 4)
+    {
+        __m256d x = _mm256_mul_pd(_mm256_loadu_pd(xs + lane), frequencies);
+        __m256d cell = _mm256_floor_pd(x);
+        // wrapped to [0, 256) while still a double, as the conversion to int32 saturates from 2^31 on.
+        // Every step is exact, so this is the scalar path's cell & 255 for any x
+        __m256d wrapped = _mm256_sub_pd(cell, _mm256_mul_pd(_mm256_floor_pd(_mm256_mul_pd(cell, inverseCellCount)), cellCount));
+        __m128i A = _mm256_cvttpd_epi32(wrapped);
+        __m128i B = _mm_add_epi32(A, _mm_set1_epi32(1));
+        __m256d signA = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), mGradientSign.data(), A, gatherAll, 8);
+        __m256d signB = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), mGradientSign.data(), B, gatherAll, 8);
+
+        __m256d t = _mm256_sub_pd(x, cell);
+        __m256d u = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(t, t), t),
+            _mm256_add_pd(_mm256_mul_pd(t, _mm256_sub_pd(_mm256_mul_pd(t, sixes), fifteens)), tens));
+        __m256d a = _mm256_mul_pd(signA, t);
+        __m256d b = _mm256_mul_pd(signB, _mm256_sub_pd(t, ones));
+        __m256d noise = _mm256_add_pd(a, _mm256_mul_pd(u, _mm256_sub_pd(b, a)));
+
+        __m256d accumulated = _mm256_loadu_pd(values + lane);
+        _mm256_storeu_pd(values + lane, _mm256_add_pd(accumulated, _mm256_mul_pd(noise, amplitudes)));
+    }
+#endif
+
+    // portable path, and the tail of the AVX2 path
+    for (; lane < count; ++lane)
+    {
+        double x = xs[lane] * frequency;
+        double cell = std::floor(x);
+        size_t A = static_cast<size_t>(static_cast<long long>(cell)) & (PERMUTATION_SIZE - 1);
+        double t = x - cell;
+        double a = mGradientSign[A] * t;
+        double b = mGradientSign[A + 1] * (t - 1.0);
+        values[lane] += lerp(a, b, fade(t)) * amplitude;
+    }
+}
+
 #endif // PERLIN_NOISE_1D_H
\ No newline at end of file
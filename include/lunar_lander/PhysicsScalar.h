@@ -0,0 +1,20 @@
+#ifndef PHYSICSSCALAR_H
+#define PHYSICSSCALAR_H
+
+#include "engine/Fixed.h"
+#include "engine/Vector2D.h"
+
+// The number the ship's physics is done in. Float unless the build defines LUNAR_LANDER_FIXED_POINT,
+// then Fixed, and a flight from the same world and inputs is the same bits on every machine.
+// The terrain follows it onto LatticeNoise1D and draws of its own from the random engine
+#ifdef LUNAR_LANDER_FIXED_POINT
+using PhysicsScalar = Fixed;
+constexpr bool FIXED_POINT_PHYSICS { true };
+#else
+using PhysicsScalar = float;
+constexpr bool FIXED_POINT_PHYSICS { false };
+#endif
+
+using PhysicsVector = BasicVector2D<PhysicsScalar>;
+
+#endif // PHYSICSSCALAR_H
@@ -0,0 +1,94 @@
+#ifndef ROLLOUTRUNNER_H
+#define ROLLOUTRUNNER_H
+
+#include "engine/WorkStealingPool.h"
+#include "lunar_lander/LanderSimulation.h"
+#include "lunar_lander/ShipInput.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+enum class RolloutOutcome : std::uint8_t
+{
+    LANDED,
+    CRASHED,
+    TIMED_OUT
+};
+
+struct RolloutResult
+{
+    unsigned int seed;
+    RolloutOutcome outcome;
+    int steps;  // simulation steps flown, the game time at the fixed step rate
+    float fuel; // thrust summed over the steps, standing in for the fuel burnt
+};
+
+struct RolloutSummary
+{
+    size_t landed;
+    size_t crashed;
+    size_t timedOut;
+    size_t steps;
+    double fuel;
+
+    void add(const RolloutResult&);
+    void add(const RolloutSummary&);
+    size_t getRollouts() const { return landed + crashed + timedOut; };
+};
+
+// Flies a controller through many independent simulations on a work-stealing pool.
+//
+// Each worker keeps the last few worlds it generated and respawns the ship in them, so rollouts
+// that share a seed only generate the terrain once per worker; listing the seeds grouped together
+// keeps them on the same worker. Every rollout writes its own result and every worker its own
+// totals, which are merged once the run is over, so nothing is locked while flying
+class RolloutRunner
+{
+public:
+    // Called from several workers at once, each time for a different rollout
+    using Controller = std::function<ShipInput(const LanderSimulation&, const size_t rollout, const int step)>;
+
+    static constexpr size_t WORLD_CACHE_SIZE { 4 }; // worlds kept by each worker
+
+    // config.seed is replaced by each rollout's, threads includes the caller and 0 is one per hardware thread
+    RolloutRunner(const TerrainGenerationConfig& config, const int landingPads, const size_t threads = 0);
+
+    size_t getThreadCount() const { return mPool.size(); };
+
+    // One rollout per seed, each flown from a ship at rest until it lands, crashes or maxSteps run out.
+    // Results are in the order of the seeds
+    std::vector<RolloutResult> run(const std::vector<unsigned int>& seeds, const int maxSteps, const Controller&);
+
+    // Totals of the last run
+    const RolloutSummary& getSummary() const { return mSummary; };
+    // Worlds generated during the last run, the rest were reused from the worker caches
+    size_t getWorldsGenerated() const { return mWorldsGenerated; };
+
+private:
+    struct CachedWorld
+    {
+        unsigned int seed;
+        std::uint64_t lastUsed;
+        LanderSimulation simulation;
+    };
+
+    struct alignas(64) Worker
+    {
+        std::vector<CachedWorld> worlds;
+        std::uint64_t clock;
+        RolloutSummary summary;
+        size_t worldsGenerated;
+    };
+
+    LanderSimulation& findWorld(Worker&, const unsigned int seed);
+
+    TerrainGenerationConfig mConfig;
+    int mLandingPads;
+    WorkStealingPool mPool;
+    std::vector<Worker> mWorkers;
+    RolloutSummary mSummary;
+    size_t mWorldsGenerated;
+};
+
+#endif // ROLLOUTRUNNER_H
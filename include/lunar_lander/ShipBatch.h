@@ -0,0 +1,120 @@
+#ifndef SHIPBATCH_H
+#define SHIPBATCH_H
+
+#include "engine/AlignedAllocator.h"
+#include "engine/Vector2D.h"
+#include "lunar_lander/ShipInput.h"
+#include "lunar_lander/Spaceship.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <cstdint>
+#include <vector>
+
+// Many landers flown together, one aligned array per component, so a physics step is a loop
+// over several ships at a time (AVX2 when the build targets it, otherwise blocks the compiler can vectorise).
+//
+// Each ship steps exactly as a Spaceship of the same size and parameters does with the box collision:
+// control() is rotate followed by thrustIncrease or thrustDecay, and updatePhysics is
+// Spaceship::updatePhysics, using the same float operations in the same order so the results
+// match bit for bit. The batch stays in float when a fixed point build moves Spaceship to Fixed. A ship that crashes stays where it touched and sits out later steps.
+// The world edges are left to the caller, as handleBoundaryCollision is for the player
+class ShipBatch
+{
+public:
+    static constexpr size_t BATCH_BLOCK_SIZE { 8 }; // ships per SIMD block, one AVX register of floats
+
+    ShipBatch(const int width, const int height, const float gravity, const float thrustUnit, const float maxThrust, const float rotationSpeed);
+
+    size_t size() const { return mCount; };
+    // Adds a ship at rest with its nose up, returns its index
+    size_t add(const float x, const float y);
+    // Adds a ship flying as the given one is, returns its index
+    size_t add(const Spaceship&);
+    // Adds a copy of a ship of another batch made with the same parameters, returns its index
+    size_t add(const ShipBatch&, const size_t ship);
+    void clear();
+
+    float getPosX(const size_t ship) const { return mPosX[ship]; };
+    float getPosY(const size_t ship) const { return mPosY[ship]; };
+    float getVelX(const size_t ship) const { return mVelX[ship]; };
+    float getVelY(const size_t ship) const { return mVelY[ship]; };
+    float getNoseAngle(const size_t ship) const { return mNoseAngle[ship]; };
+    float getThrust(const size_t ship) const { return mThrust[ship]; };
+    bool isCrashed(const size_t ship) const { return mCrashed[ship] != 0; };
+
+    // Applies one input per ship
+    void control(const ShipInput*);
+    // Gravity, thrust and integration with nothing to hit
+    void updatePhysics();
+    // Swept against the terrain like Spaceship::updatePhysics, returns how many ships crashed this step
+    template <typename Terrain>
+    size_t updatePhysics(const TerrainQuery<Terrain>&);
+
+private:
+    using Floats = std::vector<float, AlignedAllocator<float, 32>>;
+
+    float mCollisionWidth;
+    float mCollisionHeight;
+    float mGravity;
+    float mThrustUnit;
+    float mMaxThrust;
+    float mRotationSpeed;
+    size_t mCount;
+
+    // padded to whole blocks with ships that have no gravity, so stay at rest
+    Floats mPosX;
+    Floats mPosY;
+    Floats mVelX;
+    Floats mVelY;
+    Floats mHeadingX;
+    Floats mHeadingY;
+    Floats mThrust; // magnitude, along the heading
+    Floats mNoseAngle;
+    Floats mGravityY; // zero once crashed, with no thrust or velocity a crashed ship then stays put
+    std::vector<std::uint8_t> mCrashed;
+
+    // a new ship's slot, zeroed, with the arrays grown by a block when they are full
+    size_t append();
+    // velocity += gravity + thrust for every ship
+    void accelerate();
+    void crash(const size_t);
+};
+
+template <typename Terrain>
+size_t ShipBatch::updatePhysics(const TerrainQuery<Terrain>& terrain)
+{
+    accelerate();
+
+    // each sweep walks different columns, so the moves are one ship at a time
+    size_t crashes { 0 };
+    for (size_t ship = 0; ship < size(); ship++)
+    {
+        if (mCrashed[ship] != 0)
+        {
+            continue;
+        }
+        Vector2D collisionOrigin { Vector2D { mPosX[ship], mPosY[ship] } + Vector2D { COLLISION_BOX_MARGIN, COLLISION_BOX_MARGIN } };
+        Vector2D velocity { mVelX[ship], mVelY[ship] };
+        BoxHit contact { terrain.sweepBox(collisionOrigin, mCollisionWidth, mCollisionHeight, velocity) };
+        if (!contact.hit)
+        {
+            mPosX[ship] += mVelX[ship];
+            mPosY[ship] += mVelY[ship];
+            continue;
+        }
+
+        // as moveUntilContact, at rest touching the terrain
+        Vector2D travelled { velocity * contact.time };
+        mPosX[ship] += travelled.getX();
+        mPosY[ship] += travelled.getY();
+        mVelX[ship] = 0;
+        mVelY[ship] = 0;
+        if (!contact.landingPad)
+        {
+            crash(ship);
+            crashes++;
+        }
+    }
+    return crashes;
+}
+
+#endif // SHIPBATCH_H
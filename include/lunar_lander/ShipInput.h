@@ -0,0 +1,13 @@
+#ifndef SHIPINPUT_H
+#define SHIPINPUT_H
+
+#include <cstdint>
+
+// One ship's controls for one step, as the keyboard gives them to the player's ship
+struct ShipInput
+{
+    std::int8_t turn; // -1 anticlockwise, 1 clockwise, by the rotation speed, 0 holds the angle
+    bool thrust;      // thrustIncrease when held, thrustDecay otherwise
+};
+
+#endif // SHIPINPUT_H
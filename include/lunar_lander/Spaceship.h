@@ -1,57 +1,170 @@
 #ifndef SPACESHIP_H
 #define SPACESHIP_H
 
+#include "engine/Rect.h"
+#include "engine/SpriteMask.h"
+#include "engine/StateHash.h"
 #include "engine/Vector2D.h"
+#include "lunar_lander/ChunkManager.h"
 #include "lunar_lander/FlightStats.h"
-#include <SDL.h>
-#include <engine/Texture.h>
+#include "lunar_lander/PhysicsScalar.h"
+#include "lunar_lander/TerrainGrid.h"
+#include "lunar_lander/TerrainHeightmap.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <limits>
 #include <vector>
 
 const int COLLISION_BOX_MARGIN { 4 };
 
+// The player's ship. Its physics is done in PhysicsScalar, everything it reports is float
 class Spaceship
 {
 public:
+    // Everything a step changes, copied by value. The size, thrust limits and collision mask are fixed
+    // when the ship is made, so a State restores into the ship it was saved from or one made the same way
+    struct State
+    {
+        float noseAngle;
+        PhysicsScalar thrustMagnitude;
+        PhysicsVector position;
+        PhysicsVector previousPosition;
+        PhysicsVector velocity;
+        PhysicsVector acceleration;
+        PhysicsVector heading;
+        PhysicsVector thrust;
+        bool isDestroyed;
+    };
+
     Spaceship();
-    Spaceship(int x, int y, Texture* texture, float gravity, float thrustUnit, float maxThrust);
+    // width and height are the sprite's, the ship is drawn and collides within that box
+    Spaceship(int x, int y, int width, int height, float gravity, float thrustUnit, float maxThrust);
 
-    float getPosX() const { return mPosition.getX(); };
-    float getPosY() const { return mPosition.getY(); };
-    float getVelX() const { return mVelocity.getX(); };
-    float getVelY() const { return mVelocity.getY(); };
+    float getPosX() const { return toFloat(mPosition.getX()); };
+    float getPosY() const { return toFloat(mPosition.getY()); };
+    float getVelX() const { return toFloat(mVelocity.getX()); };
+    float getVelY() const { return toFloat(mVelocity.getY()); };
     float getNoseAngle() const { return mNoseAngle; };
+    float getThrust() const { return toFloat(mThrustMagnitude); };
+    // Position alpha of the way from before the last physics step to after it
+    Vector2D getDrawPosition(const float alpha) const;
+    // Unit vector along a nose angle from 0 up to 360
+    static Vector2D headingFor(const float);
+    // As the ship steers by it, in fixed point builds whole degrees from the table and linear between them
+    static PhysicsVector physicsHeadingFor(const float);
 
     FlightStats getFlightStats() const;
     void rotate(const float);
     void alignVertical(const float);
     void thrustIncrease();
     void thrustDecay();
+    // Collide using the sprite's opaque pixels at the current angle instead of the fixed box.
+    // The mask must outlive the ship, nullptr goes back to the box
+    void setCollisionMask(const SpriteMask*);
+
     void updatePhysics();
-    SDL_Rect getDrawBounds() const;
-    SDL_Rect getCollisionBounds() const;
+    // updatePhysics that stops the ship where it first touches the terrain during the step,
+    // so a fast ship cannot pass through thin terrain. Returns true on a crash
+    template <typename Terrain>
+    bool updatePhysics(const TerrainQuery<Terrain>&);
+    Rect getDrawBounds() const;
+    Rect getCollisionBounds() const;
     bool handleBoundaryCollision(int, int);
-    bool handleTerrainCollision(std::vector<std::vector<int>>&);
-    void render(const int, const int) const;
+    bool handleTerrainCollision(const TerrainGrid&);
+    bool handleTerrainCollision(const TerrainHeightmap&);
+    bool handleTerrainCollision(const ChunkManager&);
+    // Solid bodies such as the space station stop the ship without destroying it
+    void handleBodyCollision();
     
     void destroy();
     bool isDestroyed() const;
 
+    State saveState() const;
+    void restoreState(const State&);
+    // Adds every field that a step reads or writes, by its bits
+    void hashState(StateHash&) const;
+
 private:
-    float mNoseAngle;
-    float mThrustUnit; // this is Jerk - time derivative of acceleration
-    float mMaxThrust;
+    float mNoseAngle; // whole degrees in play, where float adds and subtracts exactly
+    PhysicsScalar mThrustUnit; // this is Jerk - time derivative of acceleration
+    PhysicsScalar mMaxThrust;
     // int mMass { 1 };
 
-    Vector2D mPosition;
-    Vector2D mVelocity;
-    Vector2D mAcceleration;
-    Vector2D mThrust;
-    Vector2D mGravity;
+    PhysicsVector mPosition;
+    PhysicsVector mPreviousPosition; // before the last physics step
+    PhysicsVector mVelocity;
+    PhysicsVector mAcceleration;
+    PhysicsVector mHeading; // unit vector along the nose
+    PhysicsScalar mThrustMagnitude; // kept apart so thrust changes never rescale mThrust
+    PhysicsVector mThrust;
+    PhysicsVector mGravity;
 
-    Texture* mTexture;
+    int mWidth;
+    int mHeight;
+    const SpriteMask* mCollisionMask;
     bool mIsDestroyed = false;
     
+    void accelerate();
+    bool moveUntilContact(const BasicBoxHit<PhysicsScalar>&);
+    PhysicsScalar getCollisionWidth() const;
+    PhysicsScalar getCollisionHeight() const;
+    template <typename Terrain>
+    BasicBoxHit<PhysicsScalar> sweepMaskColumns(const TerrainQuery<Terrain>&, const int) const;
+    bool handleMaskCollision(const TerrainGrid&);
+    template <typename Terrain>
+    bool handleMaskCollision(const Terrain&);
     void resetVelocity();
+    static bool isVacuum(const TerrainGrid&, const int, const int, const int, const int);
+    static void findMinSurfaces(const TerrainHeightmap&, const int, const int, int&, int&);
+    bool resolveTerrainCollision(const int, const int, const int);
+    bool resolveTerrainCollision(const bool, const bool);
 };
 
+template <typename Terrain>
+bool Spaceship::updatePhysics(const TerrainQuery<Terrain>& terrain)
+{
+    accelerate();
+    if (mCollisionMask == nullptr)
+    {
+        PhysicsVector collisionOrigin { mPosition + PhysicsVector { COLLISION_BOX_MARGIN, COLLISION_BOX_MARGIN } };
+        return moveUntilContact(terrain.sweepBox(collisionOrigin, getCollisionWidth(), getCollisionHeight(), mVelocity));
+    }
+
+    // the box round the opaque pixels rules out most moves, only then is each pixel column swept
+    int angle { SpriteMask::angleIndex(mNoseAngle) };
+    const Rect& bounds { mCollisionMask->getBounds(angle) };
+    PhysicsVector boundsOrigin { mPosition + PhysicsVector { static_cast<PhysicsScalar>(bounds.x), static_cast<PhysicsScalar>(bounds.y) } };
+    BasicBoxHit<PhysicsScalar> contact { terrain.sweepBox(boundsOrigin, static_cast<PhysicsScalar>(bounds.w), static_cast<PhysicsScalar>(bounds.h), mVelocity) };
+    if (contact.hit)
+    {
+        contact = sweepMaskColumns(terrain, angle);
+    }
+    return moveUntilContact(contact);
+}
+
+template <typename Terrain>
+BasicBoxHit<PhysicsScalar> Spaceship::sweepMaskColumns(const TerrainQuery<Terrain>& terrain, const int angle) const
+{
+    // terrain is solid from the surface down, so the span from the top to the bottom opaque pixel
+    // of a column touches it exactly when the column's pixels do
+    const MaskColumn* columns { mCollisionMask->columnData(angle) };
+    BasicBoxHit<PhysicsScalar> contact { false, noContactTime<PhysicsScalar>(), 0, false };
+    for (int column = 0; column < mCollisionMask->getFrameSize(); column++)
+    {
+        const MaskColumn& span { columns[column] };
+        if (span.top == span.bottom)
+        {
+            continue;
+        }
+        PhysicsVector origin { mPosition + PhysicsVector {
+            static_cast<PhysicsScalar>(mCollisionMask->getOffsetX() + column),
+            static_cast<PhysicsScalar>(mCollisionMask->getOffsetY() + span.top) } };
+        BasicBoxHit<PhysicsScalar> hit { terrain.sweepBox(origin, PhysicsScalar { 1 }, static_cast<PhysicsScalar>(span.bottom - span.top), mVelocity) };
+        if (hit.hit && (hit.time < contact.time || (hit.time == contact.time && contact.landingPad && !hit.landingPad)))
+        {
+            contact = hit;
+        }
+    }
+    return contact;
+}
+
 #endif // SPACESHIP_H
\ No newline at end of file
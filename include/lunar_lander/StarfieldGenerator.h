@@ -1,6 +1,7 @@
 #ifndef STARFIELD_GENERATOR_H
 #define STARFIELD_GENERATOR_H
 
+#include "NoiseTable.h"
 #include "PerlinNoise1D.h"
 #include "engine/Texture.h"
 #include <cmath>
@@ -19,9 +20,14 @@ public:
     };
 
     StarfieldGenerator();
-    void generateStarfield(int width, int height, size_t targetStars = 2000);
+    // useNoiseTables: answer the per candidate noise terms from pre-sampled NoiseTables
+    void generateStarfield(int width, int height, size_t targetStars = 2000, bool useNoiseTables = false);
     void createStarfieldTexture(SDL_Renderer* renderer, Texture* targetTexture);
 
+    // Bound on the interpolation error of the noise tables used by the last generation, 0 without tables
+    double getNoiseTableErrorBound() const;
+    size_t getStarCount() const { return mStars.size(); }
+
 private:
     // Astronomical structure generators
     void generateGalacticPlane(size_t starCount);   // Horizontal Milky Way band
@@ -34,6 +40,8 @@ private:
     double calculateGalacticPlaneDistance(int y) const; // Distance from galactic plane
     double calculateDistanceFromCenter(int x, int y) const; // Distance from galactic center
     void addStar(int x, int y, double intensity, double baseSize = 1.0);
+    void buildNoiseTables();
+    double sampleNoise(const PerlinNoise1D& noise, const NoiseTable& table, double x, int octaves = 1, double persistence = 0.5) const;
 
     // Configuration (set during generation)
     int mWidth, mHeight;
@@ -46,6 +54,14 @@ private:
     PerlinNoise1D mSmallScaleNoise;     // Local clusters
     PerlinNoise1D mVariationNoise;      // Fine-scale variation
 
+    // Optional tables of the noise terms evaluated for every candidate star
+    bool mUseNoiseTables;
+    NoiseTable mGalacticPlaneTable;     // large scale noise along x
+    NoiseTable mVariationTable;         // variation noise, shared by the plane and background
+    NoiseTable mGalacticCenterTable;    // medium scale noise by distance from center
+    NoiseTable mSpiralArmTable;         // medium scale noise by spiral radius
+    NoiseTable mSpiralLocalTable;       // small scale noise by spiral radius
+
     // Random number generation
     std::mt19937 mGenerator;
 
@@ -0,0 +1,63 @@
+#ifndef TERRAINCACHE_H
+#define TERRAINCACHE_H
+
+#include "lunar_lander/TerrainGenerator.h"
+#include "lunar_lander/TerrainHeightmap.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Directory of previously generated worlds, one file per (config, landing pad count) pair.
+//
+// File layout, native byte order:
+//   Header      magic "LLTC", format version, config hash, width, height, pad count
+//   uint16      surface row of every column
+//   PadRecord   start and width of every landing pad, 4 byte aligned
+// Files are memory-mapped on load, so replaying a known seed costs a copy of the columns
+// instead of a noise evaluation per column
+class TerrainCache
+{
+public:
+    static constexpr std::uint32_t FORMAT_VERSION { 1 };
+
+    explicit TerrainCache(const std::string& directory);
+
+    // Identifies everything that affects the generated world
+    static std::uint64_t configHash(const TerrainGenerationConfig&, const int averageNumberOfLandingPads);
+
+    std::string pathFor(const TerrainGenerationConfig&, const int averageNumberOfLandingPads) const;
+
+    // Fills terrain and pads from the cached world, false if there is no valid file for this config
+    bool load(const TerrainGenerationConfig&, const int, TerrainHeightmap&, std::vector<TerrainGenerator::PadInterval>&) const;
+
+    // Writes the world, replacing any cached copy. Worlds taller than 65535 rows are not cached
+    bool save(const TerrainGenerationConfig&, const int, const TerrainHeightmap&, const std::vector<TerrainGenerator::PadInterval>&) const;
+
+    // Loads the world if it is cached, otherwise generates it from config.seed and caches it.
+    // Returns true on a cache hit
+    bool loadOrGenerate(const TerrainGenerationConfig&, const int, TerrainHeightmap&, std::vector<TerrainGenerator::PadInterval>&) const;
+
+private:
+    struct Header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t configHash;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t padCount;
+        std::uint32_t reserved;
+    };
+
+    struct PadRecord
+    {
+        std::uint32_t start;
+        std::uint32_t width;
+    };
+
+    static size_t padOffset(const size_t width);
+
+    std::string mDirectory;
+};
+
+#endif // TERRAINCACHE_H
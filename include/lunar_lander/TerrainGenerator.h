@@ -1,13 +1,17 @@
 #ifndef TERRAINGENERATOR_H
 #define TERRAINGENERATOR_H
 
+#include "LandingPadIndex.h"
+#include "LatticeNoise1D.h"
+#include "NoiseTable.h"
 #include "PerlinNoise1D.h"
-#include "engine/Texture.h"
-#include <SDL.h>
+#include "TerrainHeightmap.h"
+#include <cstdint>
 #include <vector>
 
 struct TerrainGenerationConfig
 {
+    unsigned int seed;      // the seed the TerrainGenerator is constructed with, identifies the world
     size_t worldWidth;
     size_t worldHeight;
     int heightVariation;
@@ -15,25 +19,69 @@ struct TerrainGenerationConfig
     int octaves;
     double persistence;
     double scale;
+    bool useNoiseTable;     // sample a NoiseTable rather than the exact noise, the terrain is then approximate. Ignored in fixed point builds
 };
 
+// The game's terrain settings from Constants.h, for a world of the given seed and width
+TerrainGenerationConfig makeWorldConfig(const unsigned int seed, const size_t worldWidth, const bool useNoiseTable);
+
 class TerrainGenerator
 {
 public:
+    struct PadInterval
+    {
+        size_t start;
+        size_t width;
+    };
+
     TerrainGenerator(const unsigned int seed);
 
-    void generateTerrain(std::vector<std::vector<int>>&, const TerrainGenerationConfig &, const int);
-    void createTerrainTexture(SDL_Renderer* renderer, Texture* targetTexture, const std::vector<std::vector<int>>& terrain) const;
+    // Computes the surface height of every column, including landing pads
+    void generateTerrain(TerrainHeightmap&, const TerrainGenerationConfig &, const int);
+
+    // Two passes: the column heights, then a row by row rasterization into the dense grid
+    void generateTerrain(TerrainGrid&, const TerrainGenerationConfig &, const int);
+
+    // One chunk of a wider world, config.worldWidth being the chunk width. Rock columns take consecutive
+    // noise coordinates from noiseOrigin, so neighbouring chunks join up when each one's origin is the
+    // previous origin plus the previous chunk's rock column count
+    void generateChunk(TerrainHeightmap&, const TerrainGenerationConfig &, const std::vector<PadInterval>&, const size_t noiseOrigin) const;
+
+    // Landing pad layout of a chunk, a function of the seed and chunk index only
+    static std::vector<PadInterval> placeChunkLandingPads(const TerrainGenerationConfig &, const size_t chunkIndex, const double landingPadProbability);
+
+    // Landing pads placed by the last generateTerrain call, left to right
+    const std::vector<PadInterval>& getLandingPads() const { return mLandingPads; };
+    const LandingPadIndex& getLandingPadIndex() const { return mLandingPadIndex; };
+
+    // Surface row of a rock column at the given noise coordinate, computed from the exact noise
+    int rockSurface(const TerrainGenerationConfig &, const size_t noiseCoordinate) const;
+
+    // Fills pixels with the RGBA8888 terrain image, one 32-bit word per cell in row-major order
+    static void rasterizeTerrainPixels(const TerrainHeightmap& terrain, std::vector<std::uint32_t>& pixels);
+
+    static constexpr std::uint32_t PIXEL_TRANSPARENT { 0x00000000 };
+    static constexpr std::uint32_t PIXEL_FOREGROUND { 0x000000FF }; // opaque black
+    static constexpr std::uint32_t PIXEL_HORIZON { 0xFFFFFFFF }; // opaque white
 
 private:
-    void resizeTerrain(std::vector<std::vector<int>>&, const TerrainGenerationConfig &) const;
-    int addLandingPad(std::vector<std::vector<int>>&, const TerrainGenerationConfig &, const int, const size_t);
-    void fillTerrainUpToHeight(std::vector<std::vector<int>>&, const TerrainGenerationConfig &, const int, const size_t, const int);
+    // Noise coordinate of a column that is part of a landing pad
+    static constexpr size_t PAD_COLUMN { static_cast<size_t>(-1) };
+
+    std::vector<PadInterval> placeLandingPads(const TerrainGenerationConfig &, std::vector<size_t>&);
+    void fillColumns(TerrainHeightmap&, const TerrainGenerationConfig &, const std::vector<size_t>&, const std::vector<PadInterval>&) const;
+    int addLandingPad();
+    void fillTerrainUpToHeight(TerrainHeightmap&, const TerrainGenerationConfig &, const int, const size_t, const TerrainCell) const;
     bool shouldAddLandingPad();
+    // Height of a rock column from mLatticeNoise, what fixed point builds use in place of the double noise
+    int latticeRockHeight(const TerrainGenerationConfig &, const size_t noiseCoordinate) const;
 
     PerlinNoise1D mNoise;
+    LatticeNoise1D mLatticeNoise;
     std::mt19937 mRandomNumberGenerator;
     double mLandingPadProbability;
+    std::vector<PadInterval> mLandingPads;
+    LandingPadIndex mLandingPadIndex;
 };
 
 #endif // TERRAINGENERATOR_H
\ No newline at end of file
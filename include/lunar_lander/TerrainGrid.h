@@ -0,0 +1,180 @@
+#ifndef TERRAINGRID_H
+#define TERRAINGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+using TerrainCell = std::uint8_t;
+
+// Dense terrain occupancy grid
+// Cells are packed 2 bits each into one contiguous row-major buffer of 64-bit words.
+// Each row starts on a word boundary so a row is addressed by y * rowStride.
+//
+// An occupancy pyramid over the cells lets regions of vacuum be ruled out without reading them:
+// level 0 counts the solid cells of each PYRAMID_BLOCK x PYRAMID_BLOCK block, and every level
+// above counts 2 x 2 blocks of the one below, up to a single block over the whole grid
+class TerrainGrid
+{
+public:
+    static constexpr size_t BITS_PER_CELL { 2 };
+    static constexpr size_t CELLS_PER_WORD { 64 / BITS_PER_CELL };
+    static constexpr std::uint64_t CELL_MASK { (1u << BITS_PER_CELL) - 1 };
+    static constexpr size_t PYRAMID_BLOCK { 8 };
+
+    TerrainGrid();
+    TerrainGrid(const size_t width, const size_t height);
+
+    size_t getWidth() const { return mWidth; };
+    size_t getHeight() const { return mHeight; };
+    size_t getRowStride() const { return mRowStride; };
+
+    // Bytes of cell storage owned by the grid
+    size_t getMemoryFootprint() const;
+
+    // Discards the existing contents, every cell becomes TERRAIN_VACUUM
+    void resize(const size_t width, const size_t height);
+
+    inline TerrainCell at(const size_t x, const size_t y) const;
+    inline void set(const size_t x, const size_t y, const TerrainCell value);
+
+    // Bit i is set when cell x + i of row y holds value, for the 64 cells from x.
+    // Cells past the end of the row never match
+    inline std::uint64_t matchCells(const size_t x, const size_t y, const TerrainCell value) const;
+
+    // Raw access to the packed words of a row, CELLS_PER_WORD cells per word.
+    // Writing through it leaves the pyramid stale until rebuildPyramid
+    const std::uint64_t* rowData(const size_t y) const { return mCells.data() + y * mRowStride; };
+    std::uint64_t* rowData(const size_t y) { return mCells.data() + y * mRowStride; };
+
+    // True when every cell of the rectangle is vacuum, as far as the pyramid can tell: it is only
+    // exact to PYRAMID_BLOCK cells, so false means a block overlapping the rectangle holds solid cells.
+    // Parts of the rectangle outside the grid are vacuum
+    bool isVacuum(const size_t x, const size_t y, const size_t width, const size_t height) const;
+
+    size_t getPyramidLevelCount() const { return mPyramid.size(); };
+    // Solid cells in block x, y of a level, the block is PYRAMID_BLOCK << level cells across
+    std::uint32_t getSolidCount(const size_t level, const size_t x, const size_t y) const
+    {
+        return mPyramid[level].counts[y * mPyramid[level].width + x];
+    };
+
+    // Recounts the pyramid from the cells, after writing them through rowData
+    void rebuildPyramid();
+
+private:
+    struct PyramidLevel
+    {
+        size_t width;
+        size_t height;
+        std::vector<std::uint32_t> counts;
+    };
+
+    size_t mWidth;
+    size_t mHeight;
+    size_t mRowStride; // in words
+    std::vector<std::uint64_t> mCells;
+    std::vector<PyramidLevel> mPyramid;
+
+    static constexpr std::uint64_t LOW_CELL_BITS { 0x5555555555555555ull };
+
+    static size_t shiftFor(const size_t x) { return (x % CELLS_PER_WORD) * BITS_PER_CELL; };
+    static inline std::uint64_t packLowCellBits(std::uint64_t);
+    inline void countSolid(const size_t x, const size_t y, const bool solid);
+    bool isVacuum(const size_t level, const size_t x, const size_t y, const size_t right, const size_t bottom) const;
+};
+
+TerrainCell TerrainGrid::at(const size_t x, const size_t y) const
+{
+    const std::uint64_t word { mCells[y * mRowStride + x / CELLS_PER_WORD] };
+    return static_cast<TerrainCell>((word >> shiftFor(x)) & CELL_MASK);
+}
+
+void TerrainGrid::set(const size_t x, const size_t y, const TerrainCell value)
+{
+    std::uint64_t& word { mCells[y * mRowStride + x / CELLS_PER_WORD] };
+    bool wasSolid { ((word >> shiftFor(x)) & CELL_MASK) != 0 };
+    word &= ~(CELL_MASK << shiftFor(x));
+    word |= (static_cast<std::uint64_t>(value) & CELL_MASK) << shiftFor(x);
+
+    bool isSolid { (value & CELL_MASK) != 0 };
+    if (wasSolid != isSolid)
+    {
+        countSolid(x, y, isSolid);
+    }
+}
+
+void TerrainGrid::countSolid(const size_t x, const size_t y, const bool solid)
+{
+    // one block per level holds the cell
+    size_t blockX { x / PYRAMID_BLOCK };
+    size_t blockY { y / PYRAMID_BLOCK };
+    for (PyramidLevel& level : mPyramid)
+    {
+        std::uint32_t& count { level.counts[blockY * level.width + blockX] };
+        count = solid ? count + 1 : count - 1;
+        blockX /= 2;
+        blockY /= 2;
+    }
+}
+
+std::uint64_t TerrainGrid::matchCells(const size_t x, const size_t y, const TerrainCell value) const
+{
+    const std::uint64_t* row { rowData(y) };
+    const std::uint64_t pattern { LOW_CELL_BITS * (value & CELL_MASK) };
+    std::uint64_t bits { 0 };
+    for (size_t half = 0; half < 2; half++)
+    {
+        size_t first { x + half * CELLS_PER_WORD };
+        size_t word { first / CELLS_PER_WORD };
+        if (word >= mRowStride)
+        {
+            break;
+        }
+
+        // the 32 cells from first, which can straddle two words
+        size_t shift { shiftFor(first) };
+        std::uint64_t cells { row[word] >> shift };
+        if (shift != 0 && word + 1 < mRowStride)
+        {
+            cells |= row[word + 1] << (64 - shift);
+        }
+
+        // both bits of a cell agree with the pattern
+        std::uint64_t same { ~(cells ^ pattern) };
+        same &= same >> 1;
+        bits |= packLowCellBits(same) << (half * CELLS_PER_WORD);
+    }
+
+    // padding at the end of the row is vacuum, which is not part of the grid
+    if (x >= mWidth)
+    {
+        return 0;
+    }
+    if (mWidth - x < 64)
+    {
+        bits &= ~std::uint64_t { 0 } >> (64 - (mWidth - x));
+    }
+    return bits;
+}
+
+std::uint64_t TerrainGrid::packLowCellBits(std::uint64_t bits)
+{
+    // gathers the low bit of each 2 bit cell into the low 32 bits
+#if defined(__BMI2__)
+    return _pext_u64(bits, LOW_CELL_BITS);
+#else
+    bits &= LOW_CELL_BITS;
+    bits = (bits | (bits >> 1)) & 0x3333333333333333ull;
+    bits = (bits | (bits >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+    bits = (bits | (bits >> 4)) & 0x00FF00FF00FF00FFull;
+    bits = (bits | (bits >> 8)) & 0x0000FFFF0000FFFFull;
+    return (bits | (bits >> 16)) & 0x00000000FFFFFFFFull;
+#endif
+}
+
+#endif // TERRAINGRID_H
@@ -0,0 +1,58 @@
+#ifndef TERRAINHEIGHTMAP_H
+#define TERRAINHEIGHTMAP_H
+
+#include "lunar_lander/TerrainGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Column heightmap terrain representation
+// Every column is solid from its surface row down to the bottom of the world,
+// so the terrain is described by one surface row and a landing pad flag per column.
+// The highest surface of each block of SURFACE_BLOCK_WIDTH columns is kept alongside,
+// so queries can pass over a block without reading its columns
+class TerrainHeightmap
+{
+public:
+    static constexpr size_t SURFACE_BLOCK_WIDTH { 64 };
+
+    TerrainHeightmap();
+    TerrainHeightmap(const size_t width, const size_t height);
+
+    size_t getWidth() const { return mWidth; };
+    size_t getHeight() const { return mHeight; };
+
+    // Bytes of column storage owned by the heightmap
+    size_t getMemoryFootprint() const;
+
+    // Discards the existing contents, every column becomes empty
+    void resize(const size_t width, const size_t height);
+
+    // Row of the topmost solid cell in column x, getHeight() if the column is empty
+    int getSurface(const size_t x) const { return mSurface[x]; };
+    bool isLandingPad(const size_t x) const { return mLandingPad[x] != 0; };
+    TerrainCell getColumnType(const size_t x) const;
+
+    // Highest surface row of any column, a scan of the blocks
+    int getMinSurface() const;
+    // Highest surface row of the columns [begin, end), whole blocks are not scanned
+    int getMinSurface(const size_t begin, const size_t end) const;
+    // Columns in the same block must not be set concurrently
+    void setColumn(const size_t x, const int surface, const bool landingPad);
+
+    // Contiguous per-column storage, for consumers that sweep many columns
+    const int* surfaceData() const { return mSurface.data(); };
+    const std::uint8_t* landingPadData() const { return mLandingPad.data(); };
+
+    // Builds the equivalent dense occupancy grid, only needed by consumers of individual cells
+    void rasterize(TerrainGrid&) const;
+
+private:
+    size_t mWidth;
+    size_t mHeight;
+    std::vector<int> mSurface;
+    std::vector<std::uint8_t> mLandingPad;
+    std::vector<int> mBlockMinSurface;
+};
+
+#endif // TERRAINHEIGHTMAP_H
@@ -0,0 +1,311 @@
+#ifndef TERRAINQUERY_H
+#define TERRAINQUERY_H
+
+#include "engine/Vector2D.h"
+#include "lunar_lander/TerrainHeightmap.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+struct RayHit
+{
+    bool hit;
+    float distance;  // along the ray from its origin
+    Vector2D point;
+    size_t column;
+    bool landingPad;
+};
+
+template <typename Scalar>
+struct BasicBoxHit
+{
+    bool hit;
+    Scalar time; // fraction of the displacement covered before contact
+    size_t column;
+    bool landingPad; // false whenever rock is touched at the same time
+};
+
+using BoxHit = BasicBoxHit<float>;
+
+// A contact time later than any real one, infinity where the scalar has it
+template <typename Scalar>
+constexpr Scalar noContactTime()
+{
+    if constexpr (std::numeric_limits<Scalar>::has_infinity)
+    {
+        return std::numeric_limits<Scalar>::infinity();
+    }
+    else
+    {
+        return std::numeric_limits<Scalar>::max();
+    }
+}
+
+// Geometric queries against column terrain: anything with getWidth, getHeight, getMinSurface(),
+// getMinSurface(begin, end), getSurface(x) and isLandingPad(x), such as TerrainHeightmap or ChunkManager.
+//
+// Column x is solid for surface(x) <= y < height. Rays are walked one column at a time, and only
+// through the band below the highest surface. Blocks of columns the ray stays above are passed over
+// whole, so a query costs at most the columns the ray crosses and usually far fewer.
+// Construction reads getMinSurface, so build one query for many rays against unchanged terrain
+template <typename Terrain>
+class TerrainQuery
+{
+public:
+    explicit TerrainQuery(const Terrain& terrain)
+        : mTerrain { terrain }
+        , mTop { static_cast<float>(terrain.getMinSurface()) }
+    {
+    }
+
+    // With the terrain's getMinSurface() already known, for queries built every step
+    TerrainQuery(const Terrain& terrain, const int minSurface)
+        : mTerrain { terrain }
+        , mTop { static_cast<float>(minSurface) }
+    {
+    }
+
+    // Vertical distance from (x, y) down to the surface below it, negative inside the terrain.
+    // Over an empty column it is the distance to the bottom of the world, NaN outside the world
+    float altitude(const float x, const float y) const;
+
+    // First solid point along direction from origin, up to maxDistance. The direction need not be normalised
+    RayHit raycast(const Vector2D& origin, const Vector2D& direction, const float maxDistance) const;
+
+    // First solid point on the segment from start to end
+    RayHit segmentcast(const Vector2D& start, const Vector2D& end) const;
+
+    // Earliest time in [0, 1] at which a box with its top left corner at topLeft + time * displacement
+    // overlaps a solid column. Exact, so nothing the box passes through during the move is missed.
+    // In Fixed the same arithmetic is done in integers, and the contact is the same on every machine
+    template <typename Scalar>
+    BasicBoxHit<Scalar> sweepBox(const BasicVector2D<Scalar>& topLeft, const Scalar width, const Scalar height, const BasicVector2D<Scalar>& displacement) const;
+
+private:
+    static constexpr long BLOCK_WIDTH { static_cast<long>(TerrainHeightmap::SURFACE_BLOCK_WIDTH) };
+
+    const Terrain& mTerrain;
+    float mTop; // no column is solid above this row
+
+    static RayHit miss() { return RayHit { false, 0.0f, Vector2D { 0.0f, 0.0f }, 0, false }; };
+};
+
+template <typename Terrain>
+float TerrainQuery<Terrain>::altitude(const float x, const float y) const
+{
+    if (!(x >= 0.0f && x < static_cast<float>(mTerrain.getWidth())))
+    {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    return static_cast<float>(mTerrain.getSurface(static_cast<size_t>(x))) - y;
+}
+
+template <typename Terrain>
+RayHit TerrainQuery<Terrain>::raycast(const Vector2D& origin, const Vector2D& direction, const float maxDistance) const
+{
+    float length { std::hypot(direction.getX(), direction.getY()) };
+    if (length == 0.0f || !(maxDistance >= 0.0f))
+    {
+        return miss();
+    }
+    float ox { origin.getX() };
+    float oy { origin.getY() };
+    float dx { direction.getX() / length };
+    float dy { direction.getY() / length };
+    float width { static_cast<float>(mTerrain.getWidth()) };
+    float height { static_cast<float>(mTerrain.getHeight()) };
+
+    // clip the ray to the world's columns
+    float t { 0.0f };
+    float tEnd { maxDistance };
+    if (dx == 0.0f)
+    {
+        if (!(ox >= 0.0f && ox < width))
+        {
+            return miss();
+        }
+    }
+    else
+    {
+        float tLeft { (0.0f - ox) / dx };
+        float tRight { (width - ox) / dx };
+        t = std::max(t, std::min(tLeft, tRight));
+        tEnd = std::min(tEnd, std::max(tLeft, tRight));
+    }
+
+    // nothing is solid above the highest surface, so skip down to it or give up on rays that stay above it
+    if (dy > 0.0f)
+    {
+        t = std::max(t, (mTop - oy) / dy);
+    }
+    else if (oy + dy * t < mTop)
+    {
+        return miss();
+    }
+    if (t > tEnd)
+    {
+        return miss();
+    }
+
+    // step from column boundary to column boundary
+    long column { std::clamp(static_cast<long>(std::floor(ox + dx * t)), 0L, static_cast<long>(mTerrain.getWidth()) - 1) };
+    long step { dx > 0.0f ? 1 : -1 };
+    auto boundaryTime = [&](const long c) {
+        return dx == 0.0f ? std::numeric_limits<float>::infinity() : (static_cast<float>(dx > 0.0f ? c + 1 : c) - ox) / dx;
+    };
+    float tDelta { dx == 0.0f ? 0.0f : 1.0f / std::fabs(dx) };
+    float tNext { boundaryTime(column) };
+    float yEnter { oy + dy * t };
+    float yExit { oy + dy * std::min(tNext, tEnd) };
+    bool blockStart { true };
+    while (true)
+    {
+        // on entering a block, pass over the rest of it when the ray stays above all of its columns.
+        // The whole block is tested even when the ray starts part way in, that is a single lookup
+        bool skipped { false };
+        if (blockStart && dx != 0.0f)
+        {
+            long blockFirst { column / BLOCK_WIDTH * BLOCK_WIDTH };
+            long blockEnd { std::min(blockFirst + BLOCK_WIDTH, static_cast<long>(mTerrain.getWidth())) };
+            long last { step > 0 ? blockEnd - 1 : blockFirst };
+            float tLast { boundaryTime(last) };
+            float yLast { oy + dy * std::min(tLast, tEnd) };
+            if (std::max(yEnter, yLast) < static_cast<float>(mTerrain.getMinSurface(static_cast<size_t>(blockFirst), static_cast<size_t>(blockEnd))))
+            {
+                column = last;
+                tNext = tLast;
+                yExit = yLast;
+                skipped = true;
+            }
+        }
+
+        // inside a column the ray is a straight y interval, so only its lower end needs testing
+        size_t c { static_cast<size_t>(column) };
+        float surface { skipped ? height : static_cast<float>(mTerrain.getSurface(c)) };
+        if (std::max(yEnter, yExit) >= surface && surface < height)
+        {
+            float tHit { -1.0f };
+            if (yEnter >= surface && yEnter < height)
+            {
+                tHit = t;
+            }
+            else if (yEnter < surface)
+            {
+                tHit = std::clamp((surface - oy) / dy, t, std::min(tNext, tEnd));
+            }
+            if (tHit >= 0.0f)
+            {
+                Vector2D point { ox + dx * tHit, oy + dy * tHit };
+                return RayHit { true, tHit, point, c, mTerrain.isLandingPad(c) };
+            }
+        }
+        if (tNext >= tEnd || (dy <= 0.0f && yExit < mTop))
+        {
+            return miss();
+        }
+        column += step;
+        if (column < 0 || column >= static_cast<long>(mTerrain.getWidth()))
+        {
+            return miss();
+        }
+        blockStart = column % BLOCK_WIDTH == (step > 0 ? 0 : BLOCK_WIDTH - 1);
+
+        // stepping the boundary time rather than dividing each time, the drift is far below a pixel
+        t = tNext;
+        tNext += tDelta;
+        yEnter = yExit;
+        yExit = oy + dy * std::min(tNext, tEnd);
+    }
+}
+
+template <typename Terrain>
+RayHit TerrainQuery<Terrain>::segmentcast(const Vector2D& start, const Vector2D& end) const
+{
+    Vector2D direction { end - start };
+    return raycast(start, direction, std::hypot(direction.getX(), direction.getY()));
+}
+
+template <typename Terrain>
+template <typename Scalar>
+BasicBoxHit<Scalar> TerrainQuery<Terrain>::sweepBox(const BasicVector2D<Scalar>& topLeft, const Scalar width, const Scalar height, const BasicVector2D<Scalar>& displacement) const
+{
+    const Scalar zero { 0 };
+    const Scalar one { 1 };
+    Scalar x0 { topLeft.getX() };
+    Scalar y0 { topLeft.getY() };
+    Scalar vx { displacement.getX() };
+    Scalar vy { displacement.getY() };
+    Scalar worldHeight { static_cast<Scalar>(static_cast<int>(mTerrain.getHeight())) };
+    // lowest the bottom edge gets during the move, columns with their surface at or below it cannot be touched
+    Scalar lowestBottom { y0 + height + std::max(vy, zero) };
+    BasicBoxHit<Scalar> contact { false, noContactTime<Scalar>(), 0, false };
+
+    // only the columns the box passes over can be touched
+    Scalar left { std::min(x0, x0 + vx) };
+    Scalar right { std::max(x0, x0 + vx) + width };
+    long first { std::max(0L, floorToLong(left)) };
+    long last { std::min(static_cast<long>(mTerrain.getWidth()) - 1, ceilToLong(right) - 1) };
+    for (long column = first; column <= last; column++)
+    {
+        size_t c { static_cast<size_t>(column) };
+        Scalar surface { static_cast<Scalar>(mTerrain.getSurface(c)) };
+        if (surface >= lowestBottom || surface >= worldHeight)
+        {
+            continue;
+        }
+
+        // the open time interval over which the box is above the column horizontally
+        Scalar columnLeft { static_cast<Scalar>(column) };
+        Scalar columnRight { static_cast<Scalar>(column + 1) };
+        Scalar xFrom { zero };
+        Scalar xTo { one };
+        if (vx == zero)
+        {
+            if (!(x0 < columnRight && x0 + width > columnLeft))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            Scalar a { (columnLeft - width - x0) / vx };
+            Scalar b { (columnRight - x0) / vx };
+            xFrom = std::min(a, b);
+            xTo = std::max(a, b);
+        }
+
+        // and over which its bottom is below the surface while its top is still inside the world
+        Scalar yFrom { zero };
+        Scalar yTo { one };
+        if (vy == zero)
+        {
+            if (!(y0 + height > surface && y0 < worldHeight))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            Scalar bottomCrossing { (surface - y0 - height) / vy };
+            Scalar topCrossing { (worldHeight - y0) / vy };
+            yFrom = vy > zero ? bottomCrossing : topCrossing;
+            yTo = vy > zero ? topCrossing : bottomCrossing;
+        }
+
+        Scalar from { std::max({ xFrom, yFrom, zero }) };
+        Scalar to { std::min({ xTo, yTo, one }) };
+        if (from >= to)
+        {
+            continue;
+        }
+        bool landingPad { mTerrain.isLandingPad(c) };
+        if (from < contact.time || (from == contact.time && contact.landingPad && !landingPad))
+        {
+            contact = BasicBoxHit<Scalar> { true, from, c, landingPad };
+        }
+    }
+    return contact;
+}
+
+#endif // TERRAINQUERY_H
@@ -0,0 +1,43 @@
+#ifndef TERRAINTEXTURES_H
+#define TERRAINTEXTURES_H
+
+#include "engine/Rect.h"
+#include "engine/TiledTexture.h"
+#include "lunar_lander/ChunkManager.h"
+#include "lunar_lander/TerrainHeightmap.h"
+#include <SDL.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// The drawn half of the terrain: the whole world as one TiledTexture,
+// or one per resident chunk following a ChunkManager
+class TerrainTextures
+{
+public:
+    TerrainTextures();
+    explicit TerrainTextures(SDL_Renderer*);
+
+    // Uploads the whole terrain, replacing any chunks. False if the texture could not be created or filled
+    bool create(const TerrainHeightmap&);
+
+    // Uploads the chunks that became resident since the last call and frees those that were evicted.
+    // False if a chunk failed to upload, it is left undrawn and tried again on the next call
+    bool update(const ChunkManager&);
+    size_t getChunkTextureCount() const { return mChunks.size(); };
+
+    // Renders the terrain under view, with the view's top left corner at the screen origin
+    void render(const Rect& view);
+
+private:
+    bool upload(TiledTexture&, const TerrainHeightmap&);
+
+    SDL_Renderer* mRenderer;
+    std::unique_ptr<TiledTexture> mWorld;
+    std::unordered_map<size_t, std::unique_ptr<TiledTexture>> mChunks;
+    int mChunkWidth;
+    std::vector<std::uint32_t> mPixels; // reused staging buffer
+};
+
+#endif // TERRAINTEXTURES_H
@@ -16,6 +16,7 @@ BaseEngine::BaseEngine(const int screenHeight, const int screenWidth, std::strin
     , mFrameCount { 0 }
     , mScore { 0 }
     , mFps { 0 }
+    , mInterpolation { 0 }
 {
 }
 
@@ -199,6 +200,10 @@ int BaseEngine::run(int argc, char* args[])
             printf("Creating game state objects\n");
             create();
 
+            // The simulation steps at a fixed rate, independent of how fast frames are presented
+            FixedTimestep timestep { SDL_GetPerformanceFrequency(), SIMULATION_STEPS_PER_SECOND, MAX_CATCH_UP_STEPS };
+            Uint64 lastFrame { SDL_GetPerformanceCounter() };
+
             // While application is running
             printf("Starting engine loop\n");
             while (!mQuit)
@@ -212,8 +217,15 @@ int BaseEngine::run(int argc, char* args[])
                     setWindowTitle();
                 }
 
-                // Update game state objects
-                update();
+                // Update game state objects, as many steps as the time since the last frame holds
+                Uint64 now { SDL_GetPerformanceCounter() };
+                int steps { timestep.advance(now - lastFrame) };
+                lastFrame = now;
+                for (int step = 0; step < steps && !mQuit; step++)
+                {
+                    update();
+                }
+                mInterpolation = timestep.getAlpha();
 
                 // Clear screen
                 SDL_SetRenderDrawColor(mRenderer.get(), 255, 255, 255, 255);
@@ -0,0 +1,98 @@
+#include "engine/MappedFile.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : mData { nullptr }
+    , mSize { 0 }
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        return false;
+    }
+    std::streamoff length { file.tellg() };
+    if (length <= 0)
+    {
+        return false;
+    }
+    mBuffer.resize(static_cast<size_t>(length));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(mBuffer.data()), length))
+    {
+        mBuffer.clear();
+        return false;
+    }
+    mData = mBuffer.data();
+    mSize = mBuffer.size();
+    return true;
+}
+
+void MappedFile::close()
+{
+    mBuffer.clear();
+    mBuffer.shrink_to_fit();
+    mData = nullptr;
+    mSize = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+    int fd { ::open(path.c_str(), O_RDONLY) };
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || status.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    size_t length { static_cast<size_t>(status.st_size) };
+    void* mapping { ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) };
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+    mData = static_cast<const std::uint8_t*>(mapping);
+    mSize = length;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mData != nullptr)
+    {
+        ::munmap(const_cast<std::uint8_t*>(mData), mSize);
+    }
+    mData = nullptr;
+    mSize = 0;
+}
+
+#endif
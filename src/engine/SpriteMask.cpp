@@ -0,0 +1,99 @@
+#include "engine/SpriteMask.h"
+#include <algorithm>
+#include <cmath>
+
+SpriteMask::SpriteMask()
+    : mFrameSize { 0 }
+    , mOffsetX { 0 }
+    , mOffsetY { 0 }
+    , mWordsPerRow { 0 }
+    , mRows {}
+    , mColumns {}
+    , mBounds {}
+{
+}
+
+SpriteMask::SpriteMask(const std::uint8_t* opacity, const int width, const int height)
+    : SpriteMask()
+{
+    // the diagonal plus a pixel either side for the rounding of rotated pixel centres
+    mFrameSize = static_cast<int>(std::ceil(std::hypot(static_cast<double>(width), static_cast<double>(height)))) + 2;
+    mOffsetX = (width - mFrameSize) / 2;
+    mOffsetY = (height - mFrameSize) / 2;
+    mWordsPerRow = (static_cast<size_t>(mFrameSize) + 63) / 64;
+
+    size_t frameSize { static_cast<size_t>(mFrameSize) };
+    mRows.assign(ANGLES * frameSize * mWordsPerRow, 0);
+    mColumns.assign(ANGLES * frameSize, MaskColumn { 0, 0 });
+    mBounds.assign(ANGLES, Rect { 0, 0, 0, 0 });
+    for (int angle = 0; angle < ANGLES; angle++)
+    {
+        buildFrame(opacity, width, height, angle);
+    }
+}
+
+int SpriteMask::angleIndex(const float degrees)
+{
+    int angle { static_cast<int>(std::lround(degrees)) % ANGLES };
+    return angle < 0 ? angle + ANGLES : angle;
+}
+
+bool SpriteMask::isOpaque(const int angle, const int x, const int y) const
+{
+    if (x < 0 || y < 0 || x >= mFrameSize || y >= mFrameSize)
+    {
+        return false;
+    }
+    size_t column { static_cast<size_t>(x) };
+    return (rowData(angle, y)[column / 64] >> (column % 64)) & 1u;
+}
+
+void SpriteMask::buildFrame(const std::uint8_t* opacity, const int width, const int height, const int angle)
+{
+    // sample the sprite under each frame pixel centre, turned back about the sprite centre
+    double radians { static_cast<double>(angle) * M_PI / 180.0 };
+    double cosine { std::cos(radians) };
+    double sine { std::sin(radians) };
+    double centreX { width / 2.0 };
+    double centreY { height / 2.0 };
+
+    int left { mFrameSize };
+    int top { mFrameSize };
+    int right { 0 };
+    int bottom { 0 };
+    MaskColumn* columns { mColumns.data() + static_cast<size_t>(angle) * static_cast<size_t>(mFrameSize) };
+    for (int y = 0; y < mFrameSize; y++)
+    {
+        std::uint64_t* row { mRows.data() + (static_cast<size_t>(angle) * static_cast<size_t>(mFrameSize) + static_cast<size_t>(y)) * mWordsPerRow };
+        double dy { y + mOffsetY + 0.5 - centreY };
+        for (int x = 0; x < mFrameSize; x++)
+        {
+            double dx { x + mOffsetX + 0.5 - centreX };
+            int sourceX { static_cast<int>(std::floor(centreX + dx * cosine + dy * sine)) };
+            int sourceY { static_cast<int>(std::floor(centreY - dx * sine + dy * cosine)) };
+            if (sourceX < 0 || sourceY < 0 || sourceX >= width || sourceY >= height
+                || opacity[sourceY * width + sourceX] == 0)
+            {
+                continue;
+            }
+
+            size_t column { static_cast<size_t>(x) };
+            row[column / 64] |= std::uint64_t { 1 } << (column % 64);
+            MaskColumn& span { columns[x] };
+            if (span.top == span.bottom)
+            {
+                span.top = y;
+            }
+            span.bottom = y + 1;
+            left = std::min(left, x);
+            right = std::max(right, x + 1);
+            top = std::min(top, y);
+            bottom = std::max(bottom, y + 1);
+        }
+    }
+
+    if (left < right)
+    {
+        mBounds[static_cast<size_t>(angle)] = Rect { left + mOffsetX, top + mOffsetY, right - left, bottom - top };
+    }
+}
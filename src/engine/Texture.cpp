@@ -6,6 +6,7 @@ Texture::Texture()
     , mFont { nullptr }
     , mWidth { 0 }
     , mHeight { 0 }
+    , mOpacity {}
 {
 }
 
@@ -15,6 +16,7 @@ Texture::Texture(SDL_Renderer* renderer)
     , mFont { nullptr }
     , mWidth { 0 }
     , mHeight { 0 }
+    , mOpacity {}
 {
 }
 
@@ -24,6 +26,7 @@ Texture::Texture(SDL_Renderer* renderer, TTF_Font* font)
     , mFont { font }
     , mWidth { 0 }
     , mHeight { 0 }
+    , mOpacity {}
 {
 }
 
@@ -67,6 +70,7 @@ bool Texture::loadFromFile(const std::string& path)
     // Get image dimensions
     mWidth = loadedSurface->w;
     mHeight = loadedSurface->h;
+    readOpacity(loadedSurface);
 
     // Get rid of old loaded surface
     SDL_FreeSurface(loadedSurface);
@@ -107,16 +111,55 @@ bool Texture::loadFromRenderedText(std::string textureText, SDL_Color textColor,
     return true;
 }
 
+void Texture::readOpacity(SDL_Surface* surface)
+{
+    mOpacity.clear();
+
+    // converting applies the colour key, keyed pixels come out with zero alpha
+    SDL_Surface* converted { SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0) };
+    if (converted == NULL)
+    {
+        printf("Unable to read image opacity! SDL Error: %s\n", SDL_GetError());
+        return;
+    }
+
+    SDL_LockSurface(converted);
+    mOpacity.resize(static_cast<size_t>(converted->w) * static_cast<size_t>(converted->h));
+    const std::uint8_t* pixels { static_cast<const std::uint8_t*>(converted->pixels) };
+    for (int y = 0; y < converted->h; y++)
+    {
+        const std::uint8_t* row { pixels + y * converted->pitch };
+        for (int x = 0; x < converted->w; x++)
+        {
+            // bytes are R, G, B, A in memory
+            mOpacity[static_cast<size_t>(y * converted->w + x)] = row[x * 4 + 3] >= 128;
+        }
+    }
+    SDL_UnlockSurface(converted);
+    SDL_FreeSurface(converted);
+}
+
 void Texture::setAsRenderingTarget()
 {
     SDL_SetRenderTarget(mRenderer, mTexture.get());
 }
 
+bool Texture::updatePixels(const void* pixels, const int pitch)
+{
+    if (SDL_UpdateTexture(mTexture.get(), NULL, pixels, pitch) != 0)
+    {
+        printf("Unable to update texture pixels! SDL Error: %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
 void Texture::reset()
 {
     mTexture.reset();
     mWidth = 0;
     mHeight = 0;
+    mOpacity.clear();
 }
 
 void Texture::render(int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip)
@@ -0,0 +1,129 @@
+#include "engine/TiledTexture.h"
+#include <algorithm>
+
+TiledTexture::TiledTexture(SDL_Renderer* renderer, const int tileSize)
+    : mRenderer { renderer }
+    , mTileSize { tileSize }
+    , mWidth { 0 }
+    , mHeight { 0 }
+    , mColumns { 0 }
+    , mTiles {}
+    , mBlits {}
+{
+}
+
+bool TiledTexture::create(const int width, const int height)
+{
+    SDL_RendererInfo info {};
+    if (SDL_GetRendererInfo(mRenderer, &info) == 0)
+    {
+        // a maximum of 0 means the renderer has no limit
+        if (info.max_texture_width > 0)
+        {
+            mTileSize = std::min(mTileSize, info.max_texture_width);
+        }
+        if (info.max_texture_height > 0)
+        {
+            mTileSize = std::min(mTileSize, info.max_texture_height);
+        }
+    }
+
+    mWidth = width;
+    mHeight = height;
+    mColumns = (width + mTileSize - 1) / mTileSize;
+    int rows { (height + mTileSize - 1) / mTileSize };
+    printf("Creating %d x %d tiled texture as %d x %d pages of %d pixels\n", width, height, mColumns, rows, mTileSize);
+
+    mTiles.clear();
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < mColumns; ++column)
+        {
+            // edge tiles only cover what is left of the image
+            int tileWidth { std::min(mTileSize, width - column * mTileSize) };
+            int tileHeight { std::min(mTileSize, height - row * mTileSize) };
+            SDL_Texture* texture = SDL_CreateTexture(
+                mRenderer,
+                SDL_PIXELFORMAT_RGBA8888,
+                SDL_TEXTUREACCESS_STATIC,
+                tileWidth,
+                tileHeight);
+            if (texture == NULL)
+            {
+                printf("Unable to create texture tile! SDL Error: %s\n", SDL_GetError());
+                // free the tiles made so far and leave an empty image that draws nothing
+                mTiles.clear();
+                mWidth = 0;
+                mHeight = 0;
+                mColumns = 0;
+                return false;
+            }
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+            mTiles.push_back(std::make_unique<Texture>(mRenderer));
+            mTiles.back()->setTexture(texture, tileWidth, tileHeight);
+        }
+    }
+    return true;
+}
+
+bool TiledTexture::updatePixels(const void* pixels, const int pitch)
+{
+    // each tile reads its sub-rectangle straight out of the full image using the full row pitch
+    const Uint8* bytes { static_cast<const Uint8*>(pixels) };
+    bool success = true;
+    for (size_t i = 0; i < mTiles.size(); ++i)
+    {
+        size_t column { i % static_cast<size_t>(mColumns) };
+        size_t row { i / static_cast<size_t>(mColumns) };
+        size_t offset { row * static_cast<size_t>(mTileSize) * static_cast<size_t>(pitch)
+            + column * static_cast<size_t>(mTileSize) * sizeof(Uint32) };
+        success = mTiles[i]->updatePixels(bytes + offset, pitch) && success;
+    }
+    return success;
+}
+
+size_t TiledTexture::render(const SDL_Rect& view, const int x, const int y)
+{
+    clipToTiles(view, mWidth, mHeight, mTileSize, mBlits);
+    for (TileBlit& blit : mBlits)
+    {
+        mTiles[blit.tile]->render(x + blit.destination.x, y + blit.destination.y, &blit.source);
+    }
+    return mBlits.size();
+}
+
+void TiledTexture::clipToTiles(const SDL_Rect& view, const int width, const int height, const int tileSize, std::vector<TileBlit>& blits)
+{
+    blits.clear();
+
+    // the part of the view that is inside the image
+    int left { std::max(view.x, 0) };
+    int top { std::max(view.y, 0) };
+    int right { std::min(view.x + view.w, width) };
+    int bottom { std::min(view.y + view.h, height) };
+    if (tileSize <= 0 || left >= right || top >= bottom)
+    {
+        return;
+    }
+
+    int columns { (width + tileSize - 1) / tileSize };
+    for (int row = top / tileSize; row <= (bottom - 1) / tileSize; ++row)
+    {
+        int tileTop { row * tileSize };
+        int clipTop { std::max(top, tileTop) };
+        int clipBottom { std::min(bottom, tileTop + tileSize) };
+        for (int column = left / tileSize; column <= (right - 1) / tileSize; ++column)
+        {
+            int tileLeft { column * tileSize };
+            int clipLeft { std::max(left, tileLeft) };
+            int clipRight { std::min(right, tileLeft + tileSize) };
+
+            TileBlit blit {};
+            blit.tile = static_cast<size_t>(row * columns + column);
+            blit.source = { clipLeft - tileLeft, clipTop - tileTop, clipRight - clipLeft, clipBottom - clipTop };
+            blit.destination = { clipLeft - view.x, clipTop - view.y, clipRight - clipLeft, clipBottom - clipTop };
+            blits.push_back(blit);
+        }
+    }
+}
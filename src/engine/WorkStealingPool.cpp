@@ -0,0 +1,168 @@
+#include "engine/WorkStealingPool.h"
+#include "engine/ParallelFor.h"
+#include <algorithm>
+#include <cassert>
+
+WorkStealingPool::WorkStealingPool(const size_t threads)
+    : mThreads {}
+    , mShares {}
+    , mSteals { 0 }
+    , mUntaken { 0 }
+    , mJob { nullptr }
+    , mGeneration { 0 }
+    , mBusy { 0 }
+    , mStop { false }
+{
+    size_t workers { threads > 0 ? threads : std::max<size_t>(1, std::thread::hardware_concurrency()) };
+    mShares = std::make_unique<Share[]>(workers);
+    for (size_t worker = 0; worker < workers; worker++)
+    {
+        mShares[worker].range.store(0, std::memory_order_relaxed);
+    }
+    mThreads.reserve(workers - 1);
+    for (size_t worker = 1; worker < workers; worker++)
+    {
+        mThreads.emplace_back([this, worker]() { workerLoop(worker); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock { mMutex };
+        mStop = true;
+    }
+    mStart.notify_all();
+    for (auto& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::run(const size_t count, const std::function<void(size_t, size_t)>& fn)
+{
+    assert(count <= 0xffffffffu);
+    if (count == 0)
+    {
+        return;
+    }
+
+    // contiguous shares, so neighbouring items start on the same worker
+    size_t workers { size() };
+    for (size_t worker = 0; worker < workers; worker++)
+    {
+        mShares[worker].range.store(pack(count * worker / workers, count * (worker + 1) / workers), std::memory_order_relaxed);
+    }
+    mSteals.store(0, std::memory_order_relaxed);
+    mUntaken.store(count, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock { mMutex };
+        mJob = &fn;
+        mBusy = workers - 1;
+        mGeneration++;
+    }
+    mStart.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock { mMutex };
+    mDone.wait(lock, [this]() { return mBusy == 0; });
+    mJob = nullptr;
+}
+
+void WorkStealingPool::work(const size_t worker)
+{
+    const std::function<void(size_t, size_t)>& fn { *mJob };
+    // every worker is busy already, an item that uses parallelFor works through it on its own thread
+    ScopedInlineParallelFor inlineItems { size() > 1 };
+    size_t index { 0 };
+    while (true)
+    {
+        if (take(worker, index))
+        {
+            fn(index, worker);
+        }
+        // a stolen share can be stolen from in turn before it is taken from, then this tries again
+        else if (!steal(worker))
+        {
+            if (mUntaken.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+            // every share looked empty while a thief was moving items into its own, which takes a moment
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool WorkStealingPool::take(const size_t worker, size_t& index)
+{
+    std::atomic<std::uint64_t>& share { mShares[worker].range };
+    std::uint64_t range { share.load(std::memory_order_acquire) };
+    while (beginOf(range) < endOf(range))
+    {
+        if (share.compare_exchange_weak(range, pack(beginOf(range) + 1, endOf(range)), std::memory_order_acq_rel))
+        {
+            index = beginOf(range);
+            mUntaken.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingPool::steal(const size_t thief)
+{
+    // The victims are tried in turn from the next worker round. Finding them all empty does not
+    // mean the run is done: a thief refills its own share after its compare and swap, so items can
+    // be in no share for a moment. work() asks mUntaken before giving up
+    size_t workers { size() };
+    for (size_t offset = 1; offset < workers; offset++)
+    {
+        std::atomic<std::uint64_t>& share { mShares[(thief + offset) % workers].range };
+        std::uint64_t range { share.load(std::memory_order_acquire) };
+        while (beginOf(range) < endOf(range))
+        {
+            std::uint64_t half { (endOf(range) - beginOf(range) + 1) / 2 };
+            std::uint64_t split { endOf(range) - half };
+            if (share.compare_exchange_weak(range, pack(beginOf(range), split), std::memory_order_acq_rel))
+            {
+                // only the owner refills its own share, and only once it is empty
+                mShares[thief].range.store(pack(split, split + half), std::memory_order_release);
+                mSteals.fetch_add(half, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(const size_t worker)
+{
+    std::uint64_t seen { 0 };
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock { mMutex };
+            mStart.wait(lock, [&]() { return mStop || mGeneration != seen; });
+            if (mStop)
+            {
+                return;
+            }
+            seen = mGeneration;
+        }
+
+        work(worker);
+
+        bool last { false };
+        {
+            std::lock_guard<std::mutex> lock { mMutex };
+            last = --mBusy == 0;
+        }
+        if (last)
+        {
+            mDone.notify_one();
+        }
+    }
+}
@@ -0,0 +1,210 @@
+#include "lunar_lander/Autopilot.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+constexpr float LANDED_SCORE { 1.0e6f };
+constexpr float CRASHED_SCORE { -1.0e6f };
+constexpr float BRAKING { 0.004f };          // deceleration the approach speed allows for, low as turning round to brake is slow
+constexpr float SPEED_WEIGHT { 200.0f };     // per unit of speed above the approach speed
+constexpr float CLEARANCE { 48.0f };         // altitude kept over rock
+constexpr float CLEARANCE_WEIGHT { 20.0f };  // per pixel below it
+constexpr float GLIDE_SLOPE { 1.0f };        // height over the pad aimed for per pixel away from it, so hills are flown over
+constexpr float LOOKAHEAD_STEPS { 120.0f }; // the course is checked for rock this far ahead at the current velocity
+constexpr float OBSTACLE_SCORE { -1.0e5f };  // inside the space station or past the world's edge, which the batch does not stop
+}
+
+Autopilot::Autopilot(const int shipWidth, const int shipHeight, const AutopilotConfig& config)
+    : mConfig { config }
+    , mShipWidth { static_cast<float>(shipWidth) }
+    , mShipHeight { static_cast<float>(shipHeight) }
+    , mBeam { shipWidth, shipHeight, GRAVITY, THRUST_UNIT, MAX_THRUST, ROTATION_SPEED }
+    , mChildren { shipWidth, shipHeight, GRAVITY, THRUST_UNIT, MAX_THRUST, ROTATION_SPEED }
+    , mBeamActions {}
+    , mChildActions {}
+    , mInputs {}
+    , mScores {}
+    , mOrder {}
+    , mHeld { 0, false }
+    , mStepsUntilDecision { 0 }
+    , mStats { 0, 0, 0.0, 0 }
+{
+    size_t children { std::max<size_t>(config.beamWidth, 1) * ACTION_COUNT };
+    mBeamActions.reserve(children);
+    mChildActions.reserve(children);
+    mInputs.reserve(children);
+    mScores.reserve(children);
+    mOrder.reserve(children);
+}
+
+void Autopilot::resetStats()
+{
+    mStats = AutopilotStats { 0, 0, 0.0, 0 };
+}
+
+void Autopilot::reset()
+{
+    mHeld = ShipInput { 0, false };
+    mStepsUntilDecision = 0;
+}
+
+ShipInput Autopilot::control(const LanderSimulation& simulation)
+{
+    if (mStepsUntilDecision <= 0)
+    {
+        mHeld = decide(simulation);
+        mStepsUntilDecision = mConfig.stepsPerDecision;
+    }
+    mStepsUntilDecision--;
+    return mHeld;
+}
+
+ShipInput Autopilot::decide(const LanderSimulation& simulation)
+{
+    auto start { std::chrono::steady_clock::now() };
+    int action { simulation.getTerrainChunks() != nullptr
+        ? search(simulation, TerrainQuery(*simulation.getTerrainChunks()))
+        : search(simulation, TerrainQuery(simulation.getTerrain(), simulation.getTerrainTop())) };
+    mStats.decisions++;
+    mStats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return ACTIONS[static_cast<size_t>(action)];
+}
+
+template <typename Terrain>
+int Autopilot::search(const LanderSimulation& simulation, const TerrainQuery<Terrain>& terrain)
+{
+    auto deadline { std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(mConfig.budgetMilliseconds) };
+    mBeam.clear();
+    mBeam.add(simulation.getShip());
+    mBeamActions.assign(1, 2); // no turn and no thrust until something better is found
+    int best { 2 };
+    mStats.lastDepth = 0;
+
+    for (int depth = 1; depth <= mConfig.horizon; depth++)
+    {
+        // every candidate branches over the actions, except that a landed or crashed one only waits
+        mChildren.clear();
+        mChildActions.clear();
+        mInputs.clear();
+        for (size_t candidate = 0; candidate < mBeam.size(); candidate++)
+        {
+            bool finished { mBeam.isCrashed(candidate) || isLanded(simulation, mBeam, candidate) };
+            for (size_t action = finished ? 2 : 0; action < (finished ? 3 : ACTION_COUNT); action++)
+            {
+                mChildren.add(mBeam, candidate);
+                mChildActions.push_back(depth == 1 ? static_cast<std::uint8_t>(action) : mBeamActions[candidate]);
+                mInputs.push_back(ACTIONS[action]);
+            }
+        }
+        for (int step = 0; step < mConfig.stepsPerDecision; step++)
+        {
+            mChildren.control(mInputs.data());
+            mChildren.updatePhysics(terrain);
+        }
+        mStats.nodes += mChildren.size();
+
+        // the best beamWidth go on, best first
+        mScores.clear();
+        mOrder.clear();
+        for (size_t child = 0; child < mChildren.size(); child++)
+        {
+            mScores.push_back(score(simulation, terrain, child));
+            mOrder.push_back(child);
+        }
+        size_t kept { std::min(mConfig.beamWidth, mOrder.size()) };
+        std::partial_sort(mOrder.begin(), mOrder.begin() + static_cast<std::ptrdiff_t>(kept), mOrder.end(),
+            [&](const size_t a, const size_t b) { return mScores[a] > mScores[b]; });
+
+        mBeam.clear();
+        mBeamActions.clear();
+        for (size_t rank = 0; rank < kept; rank++)
+        {
+            mBeam.add(mChildren, mOrder[rank]);
+            mBeamActions.push_back(mChildActions[mOrder[rank]]);
+        }
+        best = mBeamActions[0];
+        mStats.lastDepth = depth;
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+    }
+    return best;
+}
+
+template <typename Terrain>
+float Autopilot::score(const LanderSimulation& simulation, const TerrainQuery<Terrain>& terrain, const size_t child) const
+{
+    if (mChildren.isCrashed(child))
+    {
+        return CRASHED_SCORE;
+    }
+    if (isLanded(simulation, mChildren, child))
+    {
+        return LANDED_SCORE;
+    }
+
+    // from the middle of the bottom of the collision box
+    float left { mChildren.getPosX(child) };
+    float top { mChildren.getPosY(child) };
+    float x { left + mShipWidth / 2.0f };
+    float bottom { top + mShipHeight - static_cast<float>(COLLISION_BOX_MARGIN) };
+    float speed { std::hypot(mChildren.getVelX(child), mChildren.getVelY(child)) };
+
+    float value { 0.0f };
+    const LandingPad* pad { simulation.getLandingPadIndex().nearest(x) };
+    float distance { 0.0f };
+    if (pad != nullptr)
+    {
+        float padX { static_cast<float>(pad->start) + static_cast<float>(pad->width) / 2.0f };
+        float targetY { static_cast<float>(pad->surface) - GLIDE_SLOPE * std::fabs(padX - x) };
+        distance = std::hypot(padX - x, targetY - bottom);
+        value -= distance;
+    }
+
+    // fast is fine far from the pad, as long as there is room to brake before reaching it
+    float approachSpeed { std::sqrt(2.0f * BRAKING * distance) };
+    value -= SPEED_WEIGHT * std::max(0.0f, speed - approachSpeed);
+
+    float altitude { terrain.altitude(x, bottom) };
+    if (std::isnan(altitude) || left < 0.0f || left + mShipWidth > static_cast<float>(simulation.getWorldWidth()))
+    {
+        return value + OBSTACLE_SCORE;
+    }
+    if (simulation.getLandingPadIndex().padAt(x) == nullptr)
+    {
+        value -= CLEARANCE_WEIGHT * std::max(0.0f, CLEARANCE - altitude);
+    }
+
+    // rock on the course ahead costs the part of the course beyond it, a pad is where the course should end
+    float course { speed * LOOKAHEAD_STEPS };
+    if (course > 0.0f)
+    {
+        Vector2D velocity { mChildren.getVelX(child), mChildren.getVelY(child) };
+        RayHit ahead { terrain.raycast(Vector2D { x, bottom }, velocity, course) };
+        if (ahead.hit && !ahead.landingPad)
+        {
+            value -= CLEARANCE_WEIGHT * (course - ahead.distance);
+        }
+    }
+
+    const Rect& station { simulation.getSpacestation() };
+    if (left < static_cast<float>(station.x + station.w) && left + mShipWidth > static_cast<float>(station.x)
+        && top < static_cast<float>(station.y + station.h) && top + mShipHeight > static_cast<float>(station.y))
+    {
+        value += OBSTACLE_SCORE;
+    }
+    return value;
+}
+
+bool Autopilot::isLanded(const LanderSimulation& simulation, const ShipBatch& batch, const size_t ship) const
+{
+    // the simulation's own test, from the middle of the bottom of the collision box
+    return simulation.isLanded(batch.isCrashed(ship), batch.getVelX(ship), batch.getVelY(ship),
+        batch.getPosX(ship) + mShipWidth / 2.0f, batch.getPosY(ship) + mShipHeight - static_cast<float>(COLLISION_BOX_MARGIN));
+}
@@ -0,0 +1,187 @@
+#include "lunar_lander/ChunkManager.h"
+#include <algorithm>
+#include <cmath>
+
+ChunkManager::ChunkManager(const TerrainGenerationConfig& config, const int averageNumberOfLandingPads, const size_t chunkWidth, const size_t maxResidentChunks)
+    : mConfig { config }
+    , mChunkConfig { config }
+    , mChunkWidth { std::max<size_t>(chunkWidth, 1) }
+    , mChunkCount { (config.worldWidth + mChunkWidth - 1) / mChunkWidth }
+    , mMaxResidentChunks { maxResidentChunks }
+    , mGenerator { config.seed }
+    , mLandingPads {}
+    , mNoiseOrigin {}
+    , mFirstPad {}
+    , mLandingPadIndex {}
+    , mChunks {}
+    , mMinSurface { static_cast<int>(config.worldHeight) }
+    , mUpdateCount { 0 }
+    , mGeneratedChunkCount { 0 }
+{
+    mChunkConfig.worldWidth = mChunkWidth;
+
+    // Laying out the pads is only random draws, so it is done for the whole world up front.
+    // That fixes where each chunk's noise starts: after every rock column of the chunks to its left
+    double landingPadProbability { static_cast<double>(averageNumberOfLandingPads) / static_cast<double>(config.worldWidth) };
+    mLandingPads.resize(mChunkCount);
+    mNoiseOrigin.resize(mChunkCount);
+    mFirstPad.resize(mChunkCount);
+    std::vector<LandingPad> pads {};
+    size_t noiseX { 0 };
+    for (size_t i = 0; i < mChunkCount; i++)
+    {
+        mLandingPads[i] = TerrainGenerator::placeChunkLandingPads(mChunkConfig, i, landingPadProbability);
+        // the last chunk can run past the world's edge, where a pad could never be reached
+        while (!mLandingPads[i].empty() && i * mChunkWidth + mLandingPads[i].back().start + mLandingPads[i].back().width > config.worldWidth)
+        {
+            mLandingPads[i].pop_back();
+        }
+        mNoiseOrigin[i] = noiseX;
+        mFirstPad[i] = pads.size();
+
+        // a pad is as high as the column to its left, which is rock unless it is the previous pad
+        size_t padColumns { 0 };
+        for (const auto& pad : mLandingPads[i])
+        {
+            bool followsPad { !pads.empty() && pads.back().end() == i * mChunkWidth + pad.start };
+            int surface { followsPad ? pads.back().surface : mGenerator.rockSurface(mChunkConfig, noiseX + pad.start - 1 - padColumns) };
+            pads.push_back({ i * mChunkWidth + pad.start, pad.width, surface });
+            padColumns += pad.width;
+        }
+        noiseX += mChunkWidth - padColumns;
+    }
+    mLandingPadIndex = LandingPadIndex(std::move(pads));
+}
+
+void ChunkManager::update(const Rect& view, const float velocityX)
+{
+    mUpdateCount++;
+    if (mChunkCount == 0)
+    {
+        return;
+    }
+    auto chunkAt = [&](const float x) {
+        return static_cast<size_t>(std::clamp(std::floor(x / static_cast<float>(mChunkWidth)), 0.0f, static_cast<float>(mChunkCount - 1)));
+    };
+    size_t first { chunkAt(static_cast<float>(view.x)) };
+    size_t last { chunkAt(static_cast<float>(view.x + view.w - 1)) };
+
+    // what is on screen has to be there this frame
+    for (size_t i = first; i <= last; i++)
+    {
+        requireChunk(i);
+    }
+
+    // one chunk either side of the view, and everything the ship would reach at its current velocity
+    float lookahead { velocityX * PREFETCH_UPDATES };
+    size_t aheadFirst { lookahead < 0.0f ? chunkAt(static_cast<float>(view.x) + lookahead) : last };
+    size_t aheadLast { lookahead < 0.0f ? first : chunkAt(static_cast<float>(view.x + view.w - 1) + lookahead) };
+    aheadFirst = aheadFirst == 0 ? 0 : aheadFirst - 1;
+    aheadLast = std::min(aheadLast + 1, mChunkCount - 1);
+
+    // nearest first, and at most one new chunk per update to keep frame times flat
+    bool generated { false };
+    for (size_t distance = 1; distance <= aheadLast - aheadFirst; distance++)
+    {
+        for (size_t i : { last + distance, first - distance })
+        {
+            if (i < aheadFirst || i > aheadLast || (i >= first && i <= last))
+            {
+                continue;
+            }
+            auto chunk { mChunks.find(i) };
+            if (chunk != mChunks.end())
+            {
+                chunk->second->lastUsed = mUpdateCount;
+            }
+            else if (!generated)
+            {
+                requireChunk(i);
+                generated = true;
+            }
+        }
+    }
+
+    evict();
+}
+
+const TerrainChunk& ChunkManager::requireChunk(const size_t index)
+{
+    std::unique_ptr<TerrainChunk>& chunk { mChunks[index] };
+    if (!chunk)
+    {
+        chunk = std::make_unique<TerrainChunk>();
+        chunk->index = index;
+        generateChunk(*chunk);
+    }
+    chunk->lastUsed = mUpdateCount;
+    return *chunk;
+}
+
+const TerrainChunk* ChunkManager::findChunk(const size_t index) const
+{
+    auto chunk { mChunks.find(index) };
+    return chunk == mChunks.end() ? nullptr : chunk->second.get();
+}
+
+int ChunkManager::getSurface(const size_t x) const
+{
+    const TerrainChunk* chunk { x < mConfig.worldWidth ? findChunk(x / mChunkWidth) : nullptr };
+    return chunk == nullptr ? static_cast<int>(mConfig.worldHeight) : chunk->terrain.getSurface(x % mChunkWidth);
+}
+
+int ChunkManager::getMinSurface(const size_t begin, const size_t end) const
+{
+    int minSurface { static_cast<int>(mConfig.worldHeight) };
+    size_t last { std::min(end, mConfig.worldWidth) };
+    for (size_t x = begin; x < last; x = (x / mChunkWidth + 1) * mChunkWidth)
+    {
+        const TerrainChunk* chunk { findChunk(x / mChunkWidth) };
+        if (chunk != nullptr)
+        {
+            size_t chunkStart { x / mChunkWidth * mChunkWidth };
+            minSurface = std::min(minSurface, chunk->terrain.getMinSurface(x - chunkStart, std::min(last, chunkStart + mChunkWidth) - chunkStart));
+        }
+    }
+    return minSurface;
+}
+
+bool ChunkManager::isLandingPad(const size_t x) const
+{
+    const TerrainChunk* chunk { x < mConfig.worldWidth ? findChunk(x / mChunkWidth) : nullptr };
+    return chunk != nullptr && chunk->terrain.isLandingPad(x % mChunkWidth);
+}
+
+void ChunkManager::generateChunk(TerrainChunk& chunk)
+{
+    mGenerator.generateChunk(chunk.terrain, mChunkConfig, mLandingPads[chunk.index], mNoiseOrigin[chunk.index]);
+    mGeneratedChunkCount++;
+    mMinSurface = std::min(mMinSurface, chunk.terrain.getMinSurface());
+
+    // the pad surfaces were worked out from the exact noise, a noise table can put them a row out
+    for (size_t i = 0; i < mLandingPads[chunk.index].size(); i++)
+    {
+        mLandingPadIndex.setSurface(mFirstPad[chunk.index] + i, chunk.terrain.getSurface(mLandingPads[chunk.index][i].start));
+    }
+}
+
+void ChunkManager::evict()
+{
+    // chunks wanted during this update are never evicted, so the limit can be exceeded when it is too small for the view
+    while (mChunks.size() > mMaxResidentChunks)
+    {
+        auto oldest { mChunks.end() };
+        for (auto chunk = mChunks.begin(); chunk != mChunks.end(); ++chunk)
+        {
+            if (chunk->second->lastUsed < mUpdateCount && (oldest == mChunks.end() || chunk->second->lastUsed < oldest->second->lastUsed))
+            {
+                oldest = chunk;
+            }
+        }
+        if (oldest == mChunks.end())
+        {
+            return;
+        }
+        mChunks.erase(oldest);
+    }
+}
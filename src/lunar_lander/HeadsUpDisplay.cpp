@@ -1,3 +1,4 @@
+#include <cmath>
 #include <vector>
 #include "lunar_lander/HeadsUpDisplay.h"
 
@@ -38,6 +39,10 @@ void HeadsUpDisplay::update(const FlightStats stats)
     updateDisplayField(formatFloat(stats.xVel), FlightStatTexture::X_VEL);
     updateDisplayField(formatFloat(stats.yVel), FlightStatTexture::Y_VEL);
     updateDisplayField(formatFloat(stats.thrustUnits), FlightStatTexture::THRUST_UNITS);
+    updateDisplayField(std::isnan(stats.padOffset) ? "none" : formatFloat(stats.padOffset), FlightStatTexture::PAD_OFFSET);
+    updateDisplayField(std::isnan(stats.radarAltitude) ? "none" : formatFloat(stats.radarAltitude), FlightStatTexture::RADAR_ALTITUDE);
+    updateDisplayField(std::isnan(stats.autopilotNodesPerSecond) ? "off" : formatFloat(stats.autopilotNodesPerSecond / 1.0e6f) + "M/s", FlightStatTexture::AUTOPILOT_SPEED);
+    updateDisplayField(std::isnan(stats.autopilotDepth) ? "off" : std::to_string(static_cast<int>(stats.autopilotDepth)), FlightStatTexture::AUTOPILOT_DEPTH);
 }
 
 
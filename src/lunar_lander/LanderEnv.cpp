@@ -0,0 +1,149 @@
+#include "lunar_lander/LanderEnv.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <cassert>
+#include <cmath>
+
+LanderEnv::LanderEnv(const TerrainGenerationConfig& config, const int landingPads, const int maxSteps)
+    : mConfig { config }
+    , mLandingPads { landingPads }
+    , mMaxSteps { maxSteps }
+    , mHasWorld { false }
+    , mSimulation { SPACESHIP_WIDTH, SPACESHIP_HEIGHT, SPACESTATION_WIDTH, SPACESTATION_HEIGHT }
+    , mSteps { 0 }
+    , mPotential { 0.0f }
+{
+}
+
+ShipInput LanderEnv::decodeAction(const int action)
+{
+    assert(action >= 0 && action < ACTION_COUNT);
+    return ShipInput { static_cast<std::int8_t>(action / 2 - 1), action % 2 != 0 };
+}
+
+LanderEnv::Observation LanderEnv::reset(const unsigned int seed)
+{
+    Observation observation {};
+    reset(seed, observation.data());
+    return observation;
+}
+
+LanderEnv::Transition LanderEnv::step(const int action)
+{
+    Transition transition {};
+    transition.reward = step(action, transition.observation.data(), transition.done);
+    return transition;
+}
+
+void LanderEnv::reset(const unsigned int seed, float* observation)
+{
+    // generating the terrain is the expensive part, a new episode on the same seed only respawns the ship
+    if (!mHasWorld || seed != mConfig.seed)
+    {
+        mConfig.seed = seed;
+        mSimulation.createWorld(mConfig, mLandingPads);
+        mHasWorld = true;
+    }
+    else
+    {
+        mSimulation.respawn();
+    }
+    mSteps = 0;
+    observe(observation);
+    mPotential = potential(observation);
+}
+
+float LanderEnv::step(const int action, float* observation, bool& done)
+{
+    if (mSimulation.isCrashed() || mSimulation.isLanded() || mSteps >= mMaxSteps)
+    {
+        observe(observation);
+        done = true;
+        return 0.0f;
+    }
+
+    bool crashed { mSimulation.step(decodeAction(action)) };
+    mSteps++;
+    bool landed { !crashed && mSimulation.isLanded() };
+
+    observe(observation);
+    float next { potential(observation) };
+    float reward { next - mPotential - FUEL_COST * observation[THRUST] };
+    mPotential = next;
+    reward += crashed ? CRASH_REWARD : 0.0f;
+    reward += landed ? LANDING_REWARD : 0.0f;
+
+    done = crashed || landed || mSteps >= mMaxSteps;
+    return reward;
+}
+
+void LanderEnv::observe(float* observation) const
+{
+    const Spaceship& ship { mSimulation.getShip() };
+    FlightStats stats { mSimulation.getFlightStats() };
+    Vector2D heading { Spaceship::headingFor(ship.getNoseAngle()) };
+    observation[NOSE_SINE] = heading.getX();
+    observation[NOSE_COSINE] = -heading.getY();
+    observation[VELOCITY_X] = stats.xVel;
+    observation[VELOCITY_Y] = stats.yVel;
+    observation[THRUST] = stats.thrustUnits / MAX_THRUST;
+    observation[PAD_OFFSET] = std::isnan(stats.padOffset) ? 0.0f : stats.padOffset * DISTANCE_SCALE;
+    observation[ALTITUDE] = std::isnan(stats.radarAltitude) ? 0.0f : stats.radarAltitude * DISTANCE_SCALE;
+
+    // from the middle of the collision box, each ray reads the fraction of RAY_LENGTH to the terrain
+    Rect bounds { ship.getCollisionBounds() };
+    Vector2D centre { static_cast<float>(bounds.x) + static_cast<float>(bounds.w) / 2.0f, static_cast<float>(bounds.y) + static_cast<float>(bounds.h) / 2.0f };
+    TerrainQuery query { mSimulation.getTerrain(), mSimulation.getTerrainTop() };
+    for (size_t ray = 0; ray < RAY_COUNT; ray++)
+    {
+        int degrees { 90 + static_cast<int>(ray) * 180 / static_cast<int>(RAY_COUNT - 1) };
+        RayHit hit { query.raycast(centre, Vector2D::heading(degrees % 360), RAY_LENGTH) };
+        observation[FIRST_RAY + ray] = hit.hit ? hit.distance / RAY_LENGTH : 1.0f;
+    }
+}
+
+float LanderEnv::potential(const float* observation)
+{
+    // nearer the pad and slower is better, so the shaping reward for a step is how much nearer it got
+    return -(std::fabs(observation[PAD_OFFSET]) + std::hypot(observation[VELOCITY_X], observation[VELOCITY_Y]));
+}
+
+VectorEnv::VectorEnv(const size_t count, const TerrainGenerationConfig& config, const int landingPads, const int maxSteps)
+    : mEnvs {}
+    , mSeeds(count, 0)
+    , mObservations(count * LanderEnv::OBSERVATION_SIZE, 0.0f)
+    , mRewards(count, 0.0f)
+    , mDones(count, 0)
+{
+    mEnvs.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        mEnvs.emplace_back(config, landingPads, maxSteps);
+    }
+}
+
+void VectorEnv::reset(const unsigned int* seeds)
+{
+    for (size_t i = 0; i < mEnvs.size(); i++)
+    {
+        mSeeds[i] = seeds[i];
+        mEnvs[i].reset(seeds[i], mObservations.data() + i * LanderEnv::OBSERVATION_SIZE);
+        mRewards[i] = 0.0f;
+        mDones[i] = 0;
+    }
+}
+
+void VectorEnv::step(const int* actions)
+{
+    for (size_t i = 0; i < mEnvs.size(); i++)
+    {
+        float* observation { mObservations.data() + i * LanderEnv::OBSERVATION_SIZE };
+        bool done { false };
+        mRewards[i] = mEnvs[i].step(actions[i], observation, done);
+        mDones[i] = done ? 1 : 0;
+        if (done)
+        {
+            mEnvs[i].reset(mSeeds[i], observation);
+        }
+    }
+}
@@ -0,0 +1,246 @@
+#include "lunar_lander/LanderSimulation.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+// world handles are unique across simulations, so a snapshot cannot restore into another's world
+std::atomic<std::uint32_t> gNextWorld { 1 };
+}
+
+LanderSimulation::LanderSimulation()
+    : LanderSimulation(0, 0, 0, 0)
+{
+}
+
+LanderSimulation::LanderSimulation(const int shipWidth, const int shipHeight, const int stationWidth, const int stationHeight)
+    : mShipWidth { shipWidth }
+    , mShipHeight { shipHeight }
+    , mStationWidth { stationWidth }
+    , mStationHeight { stationHeight }
+    , mWorldWidth { 0 }
+    , mWorldHeight { 0 }
+    , mViewWidth { 0 }
+    , mViewHeight { 0 }
+    , mWorld { 0 }
+    , mTick { 0 }
+    , mTerrain {}
+    , mTerrainTop { 0 }
+    , mTerrainChunks {}
+    , mLandingPadIndex {}
+    , mShip {}
+    , mCollisionMask { nullptr }
+    , mSpacestation { 0, 0, 0, 0 }
+    , mBodies { BROADPHASE_CELL_SIZE }
+{
+}
+
+void LanderSimulation::createWorld(const TerrainGenerationConfig& config, const int landingPads)
+{
+    TerrainGenerator generator { config.seed };
+    TerrainHeightmap terrain {};
+    generator.generateTerrain(terrain, config, landingPads);
+    createWorld(config, std::move(terrain), generator.getLandingPads());
+}
+
+void LanderSimulation::createWorld(const TerrainGenerationConfig& config, TerrainHeightmap&& terrain, const std::vector<TerrainGenerator::PadInterval>& landingPads)
+{
+    mWorldWidth = static_cast<int>(config.worldWidth);
+    mWorldHeight = static_cast<int>(config.worldHeight);
+    mWorld = gNextWorld++;
+    mTerrainChunks.reset();
+    mTerrain = std::move(terrain);
+    mTerrainTop = mTerrain.getMinSurface();
+    mLandingPadIndex = LandingPadIndex::fromIntervals(mTerrain, landingPads);
+    placeSpacestation();
+    spawnShip();
+}
+
+void LanderSimulation::createStreamedWorld(const TerrainGenerationConfig& config, const int landingPads, const size_t chunkWidth, const size_t maxResidentChunks,
+    const int viewWidth, const int viewHeight)
+{
+    mWorldWidth = static_cast<int>(config.worldWidth);
+    mWorldHeight = static_cast<int>(config.worldHeight);
+    mWorld = gNextWorld++;
+    mViewWidth = viewWidth;
+    mViewHeight = viewHeight;
+    mTerrain = TerrainHeightmap {};
+    mTerrainTop = 0;
+    mLandingPadIndex = LandingPadIndex {};
+    mTerrainChunks = std::make_unique<ChunkManager>(config, landingPads, chunkWidth, maxResidentChunks);
+    placeSpacestation();
+    spawnShip();
+}
+
+void LanderSimulation::respawn()
+{
+    spawnShip();
+}
+
+LanderSimulation::Snapshot LanderSimulation::saveState() const
+{
+    return Snapshot { mWorld, mTick, mShip.saveState() };
+}
+
+bool LanderSimulation::restoreState(const Snapshot& snapshot)
+{
+    if (snapshot.world != mWorld)
+    {
+        return false;
+    }
+    mTick = snapshot.tick;
+    mShip.restoreState(snapshot.ship);
+    return true;
+}
+
+void LanderSimulation::setCollisionMask(const SpriteMask* mask)
+{
+    mCollisionMask = mask;
+    mShip.setCollisionMask(mask);
+}
+
+bool LanderSimulation::step(const ShipInput& input)
+{
+    if (mShip.isDestroyed())
+    {
+        return false;
+    }
+    mTick++;
+
+    // with no turn the nose is brought back towards vertical
+    if (input.turn != 0)
+    {
+        mShip.rotate(input.turn < 0 ? -ROTATION_SPEED : ROTATION_SPEED);
+    }
+    else
+    {
+        mShip.alignVertical(ALIGNMENT_SPEED);
+    }
+    if (input.thrust)
+    {
+        mShip.thrustIncrease();
+    }
+    else
+    {
+        mShip.thrustDecay();
+    }
+
+    // Stream in the terrain around the ship before colliding with it
+    if (mTerrainChunks)
+    {
+        mTerrainChunks->update(getView(mViewWidth, mViewHeight, 1.0f), mShip.getVelX());
+    }
+
+    // the move is swept against the terrain so fast descents cannot tunnel through it
+    bool crashed { mTerrainChunks
+        ? mShip.updatePhysics(TerrainQuery(*mTerrainChunks))
+        : mShip.updatePhysics(TerrainQuery(mTerrain, mTerrainTop)) };
+    mShip.handleBoundaryCollision(mWorldWidth, mWorldHeight);
+    handleBodyCollisions();
+
+    if (crashed)
+    {
+        mShip.destroy();
+    }
+    return crashed;
+}
+
+bool LanderSimulation::isLanded() const
+{
+    Rect bounds { mShip.getCollisionBounds() };
+    float shipX { static_cast<float>(bounds.x) + static_cast<float>(bounds.w) / 2.0f };
+    // the bounds are truncated to whole pixels, the fraction is put back so a ship stopped a hair
+    // short of the pad, as fixed point contact times leave it, is still on it
+    float shipBottom { static_cast<float>(bounds.y + bounds.h) + mShip.getPosY() - static_cast<float>(mShip.getDrawBounds().y) };
+    return isLanded(mShip.isDestroyed(), mShip.getVelX(), mShip.getVelY(), shipX, shipBottom);
+}
+
+bool LanderSimulation::isLanded(const bool crashed, const float velocityX, const float velocityY, const float x, const float bottom) const
+{
+    // touching a pad stops the ship for the step, where gravity would otherwise have moved it
+    if (crashed || velocityX != 0.0f || velocityY != 0.0f || getLandingPadIndex().padAt(x) == nullptr)
+    {
+        return false;
+    }
+    float altitude { mTerrainChunks
+        ? TerrainQuery(*mTerrainChunks).altitude(x, bottom)
+        : TerrainQuery(mTerrain, mTerrainTop).altitude(x, bottom) };
+    return altitude < 1.0f;
+}
+
+const LandingPadIndex& LanderSimulation::getLandingPadIndex() const
+{
+    return mTerrainChunks ? mTerrainChunks->getLandingPadIndex() : mLandingPadIndex;
+}
+
+FlightStats LanderSimulation::getFlightStats() const
+{
+    FlightStats stats { mShip.getFlightStats() };
+    Rect bounds { mShip.getCollisionBounds() };
+    float shipX { static_cast<float>(bounds.x) + static_cast<float>(bounds.w) / 2.0f };
+    const LandingPad* nearest { getLandingPadIndex().nearest(shipX) };
+    if (nearest != nullptr)
+    {
+        stats.padOffset = LandingPadIndex::offsetTo(*nearest, shipX);
+    }
+
+    // straight down from the middle of the bottom of the ship
+    float shipBottom { static_cast<float>(bounds.y + bounds.h) };
+    stats.radarAltitude = mTerrainChunks
+        ? TerrainQuery(*mTerrainChunks).altitude(shipX, shipBottom)
+        : TerrainQuery(mTerrain, mTerrainTop).altitude(shipX, shipBottom);
+    return stats;
+}
+
+std::uint64_t LanderSimulation::getStateHash() const
+{
+    // the terrain and the bodies are fixed once the world is created, streamed chunks are generated from the seed
+    StateHash hash {};
+    mShip.hashState(hash);
+    return hash.getValue();
+}
+
+Rect LanderSimulation::getView(const int width, const int height, const float alpha) const
+{
+    Vector2D focus { mShip.getDrawPosition(alpha) };
+    float viewX { focus.getX() - static_cast<float>(width / 2) };
+    float viewY { focus.getY() - static_cast<float>(height / 2) };
+
+    // a world smaller than the view is shown from its top left corner
+    viewX = std::clamp(viewX, 0.0f, static_cast<float>(std::max(mWorldWidth - width, 0)));
+    viewY = std::clamp(viewY, 0.0f, static_cast<float>(std::max(mWorldHeight - height, 0)));
+    return Rect { static_cast<int>(viewX), static_cast<int>(viewY), width, height };
+}
+
+void LanderSimulation::placeSpacestation()
+{
+    // at the center of the world width and the terrain start height
+    mSpacestation = Rect {
+        mWorldWidth / 2,
+        static_cast<int>(static_cast<float>(mWorldHeight) * (1.0f - TERRAIN_START_HEIGHT)),
+        mStationWidth,
+        mStationHeight
+    };
+
+    // the static bodies are bucketed once per world, each step only queries the ship
+    mBodies.clear();
+    mBodies.add(mSpacestation);
+    mBodies.build();
+}
+
+void LanderSimulation::spawnShip()
+{
+    mTick = 0;
+    mShip = Spaceship(mWorldWidth / 2, mWorldHeight / 2, mShipWidth, mShipHeight, GRAVITY, THRUST_UNIT, MAX_THRUST);
+    mShip.setCollisionMask(mCollisionMask);
+}
+
+void LanderSimulation::handleBodyCollisions()
+{
+    // every static body is in the broadphase, so more of them only costs the ones close to the ship
+    mBodies.query(mShip.getCollisionBounds(), [&](const size_t) {
+        mShip.handleBodyCollision();
+    });
+}
@@ -0,0 +1,64 @@
+#include "lunar_lander/LandingPadIndex.h"
+#include <algorithm>
+#include <cmath>
+
+LandingPadIndex::LandingPadIndex()
+    : mPads {}
+{
+}
+
+LandingPadIndex::LandingPadIndex(std::vector<LandingPad> pads)
+    : mPads { std::move(pads) }
+{
+    std::sort(mPads.begin(), mPads.end(), [](const LandingPad& a, const LandingPad& b) { return a.start < b.start; });
+}
+
+size_t LandingPadIndex::upperBound(const float x) const
+{
+    auto pad { std::upper_bound(mPads.begin(), mPads.end(), x, [](const float value, const LandingPad& p) { return value < static_cast<float>(p.start); }) };
+    return static_cast<size_t>(pad - mPads.begin());
+}
+
+const LandingPad* LandingPadIndex::padAt(const float x) const
+{
+    size_t i { upperBound(x) };
+    if (i == 0 || x >= static_cast<float>(mPads[i - 1].end()))
+    {
+        return nullptr;
+    }
+    return &mPads[i - 1];
+}
+
+const LandingPad* LandingPadIndex::nearest(const float x) const
+{
+    // only the pads either side of x can be nearest
+    size_t i { upperBound(x) };
+    const LandingPad* left { i == 0 ? nullptr : &mPads[i - 1] };
+    const LandingPad* right { i == mPads.size() ? nullptr : &mPads[i] };
+    if (left == nullptr || right == nullptr)
+    {
+        return left == nullptr ? right : left;
+    }
+    return std::fabs(offsetTo(*left, x)) <= offsetTo(*right, x) ? left : right;
+}
+
+const LandingPad* LandingPadIndex::next(const float x) const
+{
+    size_t i { upperBound(x) };
+    return i == mPads.size() ? nullptr : &mPads[i];
+}
+
+float LandingPadIndex::offsetTo(const LandingPad& pad, const float x)
+{
+    float start { static_cast<float>(pad.start) };
+    float end { static_cast<float>(pad.end()) };
+    if (x < start)
+    {
+        return start - x;
+    }
+    if (x >= end)
+    {
+        return end - x;
+    }
+    return 0.0f;
+}
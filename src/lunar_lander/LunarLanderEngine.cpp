@@ -1,11 +1,13 @@
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <random>
 
 #include "lunar_lander/LunarLanderEngine.h"
 
 LunarLanderEngine::LunarLanderEngine()
-    : BaseEngine(SCREEN_HEIGHT, SCREEN_WIDTH, DISPLAY_TITLE)
-    , mTerrainGenerator { std::random_device {}() } { };
+    : BaseEngine(SCREEN_HEIGHT, SCREEN_WIDTH, DISPLAY_TITLE) { };
 
 bool LunarLanderEngine::loadMedia()
 {
@@ -14,15 +16,22 @@ bool LunarLanderEngine::loadMedia()
 
     success = success && loadTexture(SPACESHIP_TEXTURE);
     success = success && loadTexture(SPACESTATION_TEXTURE);
+
+    // the ship collides with its opaque pixels whenever the image could be read
+    const Texture* spaceship { mTextures.at(SPACESHIP_TEXTURE).get() };
+    if (success && !spaceship->getOpacity().empty())
+    {
+        mSpaceshipMask = SpriteMask(spaceship->getOpacity().data(), spaceship->getWidth(), spaceship->getHeight());
+    }
     return success;
 }
 
 bool LunarLanderEngine::create()
 {
     mCurrentState = GameState::PLAYING;
-    generateTerrain();
+    mHistory.clear();
+    generateWorld();
     generateBackground();
-    spawnPlayer();
     createHeadsUpDisplay();
     return true;
 }
@@ -58,50 +67,34 @@ bool LunarLanderEngine::updatePlaying()
             case SDLK_r:
                 create();
                 break;
+            // A key hands the ship to the autopilot and takes it back
+            case SDLK_a:
+                mAutopilotEngaged = !mAutopilotEngaged;
+                mAutopilot.reset();
+                mAutopilot.resetStats();
+                break;
             }
         }
     }
 
-    // Handle continuous key input for rotation
-    const Uint8* keyState = SDL_GetKeyboardState(NULL);
-    if (keyState[SDL_SCANCODE_LEFT])
-    {
-        mPlayer.rotate(-ROTATION_SPEED);
-    }
-    if (keyState[SDL_SCANCODE_RIGHT])
-    {
-        mPlayer.rotate(ROTATION_SPEED);
-    }
-    if (!keyState[SDL_SCANCODE_LEFT] && !keyState[SDL_SCANCODE_RIGHT])
-    {
-        mPlayer.alignVertical(ALIGNMENT_SPEED);
-    }
-
-    // Handle holding down space to thrust, otherwise thrust decays
-    if (keyState[SDL_SCANCODE_SPACE])
+    // Step the simulation with the keys held down, keeping the state before it to rewind to
+    mHistory.push(mSimulation.saveState());
+    if (mSimulation.step(mAutopilotEngaged ? mAutopilot.control(mSimulation) : readInput()))
     {
-        mPlayer.thrustIncrease();
-    }
-    else
-    {
-        mPlayer.thrustDecay();
+        mCurrentState = GameState::DEATH;
     }
-
-    // Handle physics
-    mPlayer.updatePhysics();
-    mPlayer.handleBoundaryCollision(WORLD_WIDTH, WORLD_HEIGHT);
-    
-    // Check for death-causing collision
-    if (mPlayer.handleTerrainCollision(mTerrain))
+    if (mSimulation.getTerrainChunks() != nullptr)
     {
-        mPlayer.destroy();
-        mCurrentState = GameState::DEATH;
+        if (!mTerrainTextures.update(*mSimulation.getTerrainChunks()))
+        {
+            printf("Failed to upload a terrain chunk texture!\n");
+        }
     }
 
     // Update HUD at controlled interval
     if (mHudUpdateTimer.shouldUpdate())
     {
-        mHeadsUpDisplay.update(mPlayer.getFlightStats());
+        mHeadsUpDisplay.update(getFlightStats());
     }
 
     return true;
@@ -125,6 +118,10 @@ bool LunarLanderEngine::updateDeath()
             case SDLK_r:
                 create();
                 break;
+            // B key goes back to before the crash and flies on from there
+            case SDLK_b:
+                rewind();
+                break;
             }
         }
     }
@@ -135,23 +132,40 @@ bool LunarLanderEngine::updateDeath()
     return true;
 }
 
-bool LunarLanderEngine::render()
+void LunarLanderEngine::rewind()
 {
-    // Calculate desired camera position (world coordinates)
-    float cameraWorldX = mPlayer.getPosX() - (mScreenWidth / 2);
-    float cameraWorldY = mPlayer.getPosY() - (mScreenHeight / 2);
+    if (mHistory.empty())
+    {
+        return;
+    }
+    size_t age { std::min(REWIND_STEPS, mHistory.size() - 1) };
+    if (mSimulation.restoreState(mHistory.newest(age)))
+    {
+        // the restored state is pushed again before the next step
+        mHistory.dropNewest(age + 1);
+        // an input held from before the rewind was chosen for a flight that no longer happens
+        mAutopilot.reset();
+        mCurrentState = mSimulation.isCrashed() ? GameState::DEATH : GameState::PLAYING;
+        mHudUpdateTimer.reset();
+    }
+}
 
-    // Clamp camera to world boundaries
-    float clampedCameraX = std::clamp(cameraWorldX, 0.0f, static_cast<float>(WORLD_WIDTH - mScreenWidth));
-    float clampedCameraY = std::clamp(cameraWorldY, 0.0f, static_cast<float>(WORLD_HEIGHT - mScreenHeight));
+bool LunarLanderEngine::render()
+{
+    // Draw the player and camera between the last two updates, frames rarely land exactly on a step
+    const Spaceship& player { mSimulation.getShip() };
+    Vector2D playerPosition { player.getDrawPosition(mInterpolation) };
+    Rect cameraView { getCameraView(mInterpolation) };
+    float clampedCameraX = static_cast<float>(cameraView.x);
+    float clampedCameraY = static_cast<float>(cameraView.y);
 
     // Convert to terrain screen position
-    int terrainScreenX = -static_cast<int>(clampedCameraX);
-    int terrainScreenY = -static_cast<int>(clampedCameraY);
+    int terrainScreenX = -cameraView.x;
+    int terrainScreenY = -cameraView.y;
 
     // Calculate player screen position relative to clamped camera
-    int playerScreenX = static_cast<int>(mPlayer.getPosX() - clampedCameraX);
-    int playerScreenY = static_cast<int>(mPlayer.getPosY() - clampedCameraY);
+    int playerScreenX = static_cast<int>(playerPosition.getX() - clampedCameraX);
+    int playerScreenY = static_cast<int>(playerPosition.getY() - clampedCameraY);
 
     // render background
     SDL_SetRenderDrawColor(mRenderer.get(), 0, 0, 0, 255);
@@ -159,43 +173,65 @@ bool LunarLanderEngine::render()
 
     // render world
     mTextures.at("starfield").get()->render(static_cast<int>(terrainScreenX * STARFIELD_PARALLAX_RATIO), static_cast<int>(terrainScreenY * STARFIELD_PARALLAX_RATIO));
-    mTextures.at("terrain").get()->render(terrainScreenX, terrainScreenY);
+    // only the terrain pages under the camera are drawn
+    mTerrainTextures.render(cameraView);
 
     // render objects
-    // render spacestation at center of world width and terrain start height
-    float spacestationWorldX = WORLD_WIDTH / 2.0f;
-    float spacestationWorldY = WORLD_HEIGHT * (1.0f - TERRAIN_START_HEIGHT);
-    int spacestationScreenX = static_cast<int>(spacestationWorldX - clampedCameraX);
-    int spacestationScreenY = static_cast<int>(spacestationWorldY - clampedCameraY);
-    mTextures.at(SPACESTATION_TEXTURE).get()->render(spacestationScreenX, spacestationScreenY);
-    mPlayer.render(playerScreenX, playerScreenY);
+    const Rect& spacestation { mSimulation.getSpacestation() };
+    mTextures.at(SPACESTATION_TEXTURE).get()->render(spacestation.x - cameraView.x, spacestation.y - cameraView.y);
+    if (!player.isDestroyed())
+    {
+        mTextures.at(SPACESHIP_TEXTURE).get()->render(playerScreenX, playerScreenY, NULL, static_cast<double>(player.getNoseAngle()));
+    }
     mHeadsUpDisplay.render();
 
     return true;
 }
 
-void LunarLanderEngine::generateTerrain()
+void LunarLanderEngine::generateWorld()
 {
+    // A seed fixed from the environment replays the same world on every restart, served from the terrain cache
+    const char* fixedSeed { std::getenv(TERRAIN_SEED_VARIABLE) };
+    unsigned int seed { fixedSeed != nullptr ? static_cast<unsigned int>(std::strtoul(fixedSeed, nullptr, 10)) : std::random_device {}() };
+
     // Initialise the terrain data structure
-    TerrainGenerationConfig config {
-        static_cast<size_t>(WORLD_WIDTH),
-        static_cast<size_t>(WORLD_HEIGHT),
-        static_cast<int>(WORLD_HEIGHT * TERRAIN_HEIGHT_VARIATION),
-        static_cast<int>(WORLD_HEIGHT * TERRAIN_START_HEIGHT),
-        PERLIN_OCTAVES,
-        PERLIN_PERSISTENCE,
-        PERLIN_FREQUENCY
-    };
+    TerrainGenerationConfig config { makeWorldConfig(seed, static_cast<size_t>(mWorldWidth), TERRAIN_USE_NOISE_TABLE) };
     // todo printf
     std::cout << "Generating terrain" << std::endl;
-    mTerrainGenerator = TerrainGenerator(std::random_device {}());
-    mTerrainGenerator.generateTerrain(mTerrain, config, static_cast<int>(WORLD_WIDTH / SCREEN_WIDTH));
+    int landingPads { mWorldWidth / SCREEN_WIDTH };
+
+    // the simulation only needs the sizes of the sprites
+    const Texture* spaceship { mTextures.at(SPACESHIP_TEXTURE).get() };
+    const Texture* spacestation { mTextures.at(SPACESTATION_TEXTURE).get() };
+    mSimulation = LanderSimulation(spaceship->getWidth(), spaceship->getHeight(), spacestation->getWidth(), spacestation->getHeight());
+    mSimulation.setCollisionMask(mSpaceshipMask.isEmpty() ? nullptr : &mSpaceshipMask);
+    mAutopilot = Autopilot(spaceship->getWidth(), spaceship->getHeight(), mAutopilot.getConfig());
+    mTerrainTextures = TerrainTextures(mRenderer.get());
 
-    // Create terrain texture
-    createTargetTexture("terrain", static_cast<int>(mTerrain[0].size()), static_cast<int>(mTerrain.size()));
+    // chunks and their textures are generated as the camera reaches them
+    if (TERRAIN_STREAM_CHUNKS)
+    {
+        mSimulation.createStreamedWorld(config, landingPads, TERRAIN_CHUNK_WIDTH, TERRAIN_MAX_RESIDENT_CHUNKS, mScreenWidth, mScreenHeight);
+        return;
+    }
+
+    if (fixedSeed != nullptr)
+    {
+        TerrainHeightmap terrain {};
+        std::vector<TerrainGenerator::PadInterval> pads {};
+        mTerrainCache.loadOrGenerate(config, landingPads, terrain, pads);
+        mSimulation.createWorld(config, std::move(terrain), pads);
+    }
+    else
+    {
+        mSimulation.createWorld(config, landingPads);
+    }
 
-    // Render terrain to the texture
-    mTerrainGenerator.createTerrainTexture(mRenderer.get(), mTextures.at("terrain").get(), mTerrain);
+    // Upload the terrain pixels to the texture
+    if (!mTerrainTextures.create(mSimulation.getTerrain()))
+    {
+        printf("Failed to upload the terrain texture!\n");
+    }
 }
 
 void LunarLanderEngine::generateBackground()
@@ -204,7 +240,7 @@ void LunarLanderEngine::generateBackground()
     int starfieldHeight { static_cast<int>(SCREEN_HEIGHT * (1 + STARFIELD_PARALLAX_RATIO)) };
 
     std::cout << "Generating starfield background" << std::endl;
-    mStarfieldGenerator.generateStarfield(starfieldWidth, starfieldHeight, 1500);
+    mStarfieldGenerator.generateStarfield(starfieldWidth, starfieldHeight, 1500, STARFIELD_USE_NOISE_TABLES);
 
     // Create starfield texture
     createTargetTexture("starfield", starfieldWidth, starfieldHeight);
@@ -213,17 +249,36 @@ void LunarLanderEngine::generateBackground()
     mStarfieldGenerator.createStarfieldTexture(mRenderer.get(), mTextures.at("starfield").get());
 }
 
-void LunarLanderEngine::spawnPlayer()
+Rect LunarLanderEngine::getCameraView(const float interpolation) const
 {
-    std::cout << "Spawning player" << std::endl;
-    int worldCenterX = WORLD_WIDTH / 2;
-    int worldCenterY = WORLD_HEIGHT / 2;
-    mPlayer = Spaceship(worldCenterX, worldCenterY, mTextures.at(SPACESHIP_TEXTURE).get(), GRAVITY, THRUST_UNIT, MAX_THRUST);
+    // the camera follows the player as drawn
+    return mSimulation.getView(mScreenWidth, mScreenHeight, interpolation);
+}
+
+ShipInput LunarLanderEngine::readInput() const
+{
+    // left and right together cancel out, neither brings the nose back towards vertical
+    const Uint8* keyState = SDL_GetKeyboardState(NULL);
+    int turn { (keyState[SDL_SCANCODE_RIGHT] ? 1 : 0) - (keyState[SDL_SCANCODE_LEFT] ? 1 : 0) };
+    return ShipInput { static_cast<std::int8_t>(turn), keyState[SDL_SCANCODE_SPACE] != 0 };
 }
 
 void LunarLanderEngine::createHeadsUpDisplay()
 {
     std::cout << "Creating heads up display" << std::endl;
     mHeadsUpDisplay = HeadsUpDisplay(mScreenHeight, mScreenWidth, mRenderer.get(), mFont.get());
-    mHeadsUpDisplay.update(mPlayer.getFlightStats());
+    mHeadsUpDisplay.update(getFlightStats());
+}
+
+FlightStats LunarLanderEngine::getFlightStats() const
+{
+    // the simulation does not know who is flying the ship
+    FlightStats stats { mSimulation.getFlightStats() };
+    if (mAutopilotEngaged)
+    {
+        const AutopilotStats& autopilot { mAutopilot.getStats() };
+        stats.autopilotNodesPerSecond = static_cast<float>(autopilot.getNodesPerSecond());
+        stats.autopilotDepth = static_cast<float>(autopilot.lastDepth);
+    }
+    return stats;
 }
\ No newline at end of file
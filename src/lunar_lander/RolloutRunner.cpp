@@ -0,0 +1,111 @@
+#include "lunar_lander/RolloutRunner.h"
+#include "lunar_lander/Constants.h"
+#include <algorithm>
+
+void RolloutSummary::add(const RolloutResult& result)
+{
+    switch (result.outcome)
+    {
+    case RolloutOutcome::LANDED: landed++; break;
+    case RolloutOutcome::CRASHED: crashed++; break;
+    case RolloutOutcome::TIMED_OUT: timedOut++; break;
+    }
+    steps += static_cast<size_t>(result.steps);
+    fuel += static_cast<double>(result.fuel);
+}
+
+void RolloutSummary::add(const RolloutSummary& other)
+{
+    landed += other.landed;
+    crashed += other.crashed;
+    timedOut += other.timedOut;
+    steps += other.steps;
+    fuel += other.fuel;
+}
+
+RolloutRunner::RolloutRunner(const TerrainGenerationConfig& config, const int landingPads, const size_t threads)
+    : mConfig { config }
+    , mLandingPads { landingPads }
+    , mPool { threads }
+    , mWorkers(mPool.size())
+    , mSummary {}
+    , mWorldsGenerated { 0 }
+{
+}
+
+std::vector<RolloutResult> RolloutRunner::run(const std::vector<unsigned int>& seeds, const int maxSteps, const Controller& controller)
+{
+    for (Worker& worker : mWorkers)
+    {
+        worker.summary = RolloutSummary {};
+        worker.worldsGenerated = 0;
+    }
+
+    // each rollout has its own slot, written by whichever worker flies it
+    std::vector<RolloutResult> results(seeds.size());
+    mPool.run(seeds.size(), [&](const size_t rollout, const size_t workerIndex) {
+        Worker& worker { mWorkers[workerIndex] };
+        LanderSimulation& simulation { findWorld(worker, seeds[rollout]) };
+        RolloutResult result { seeds[rollout], RolloutOutcome::TIMED_OUT, 0, 0.0f };
+        while (result.steps < maxSteps)
+        {
+            bool crashed { simulation.step(controller(simulation, rollout, result.steps)) };
+            result.steps++;
+            result.fuel += simulation.getShip().getThrust();
+            if (crashed)
+            {
+                result.outcome = RolloutOutcome::CRASHED;
+                break;
+            }
+            if (simulation.isLanded())
+            {
+                result.outcome = RolloutOutcome::LANDED;
+                break;
+            }
+        }
+        results[rollout] = result;
+        worker.summary.add(result);
+    });
+
+    mSummary = RolloutSummary {};
+    mWorldsGenerated = 0;
+    for (const Worker& worker : mWorkers)
+    {
+        mSummary.add(worker.summary);
+        mWorldsGenerated += worker.worldsGenerated;
+    }
+    return results;
+}
+
+LanderSimulation& RolloutRunner::findWorld(Worker& worker, const unsigned int seed)
+{
+    worker.clock++;
+    auto cached { std::find_if(worker.worlds.begin(), worker.worlds.end(), [seed](const CachedWorld& world) { return world.seed == seed; }) };
+    if (cached != worker.worlds.end())
+    {
+        cached->lastUsed = worker.clock;
+        cached->simulation.respawn();
+        return cached->simulation;
+    }
+
+    // the least recently used world makes way once the cache is full
+    if (worker.worlds.size() < WORLD_CACHE_SIZE)
+    {
+        worker.worlds.push_back(CachedWorld { seed, worker.clock, LanderSimulation { SPACESHIP_WIDTH, SPACESHIP_HEIGHT, SPACESTATION_WIDTH, SPACESTATION_HEIGHT } });
+        cached = worker.worlds.end() - 1;
+    }
+    else
+    {
+        cached = std::min_element(worker.worlds.begin(), worker.worlds.end(), [](const CachedWorld& left, const CachedWorld& right) {
+            return left.lastUsed < right.lastUsed;
+        });
+        cached->seed = seed;
+        cached->lastUsed = worker.clock;
+    }
+
+    TerrainGenerationConfig config { mConfig };
+    config.seed = seed;
+    cached->simulation.createWorld(config, mLandingPads);
+    worker.worldsGenerated++;
+    return cached->simulation;
+}
@@ -0,0 +1,209 @@
+#include "lunar_lander/ShipBatch.h"
+#include <cassert>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr size_t BLOCK { ShipBatch::BATCH_BLOCK_SIZE };
+
+// The kernels run over whole blocks of lanes with fixed size inner loops, and __restrict promises the
+// arrays never overlap, so the compiler vectorises them without checks. Multiplies and adds stay
+// separate, never fused (lander_simulation builds with -ffp-contract=off), so every lane rounds as
+// Spaceship's scalar code does
+
+// velocity += base + heading * thrust along one axis, base is gravity or nullptr for none
+void accelerateAlong(float* __restrict velocity, const float* __restrict base, const float* __restrict heading,
+    const float* __restrict thrust, const size_t count)
+{
+    for (size_t start = 0; start < count; start += BLOCK)
+    {
+#if defined(__AVX2__)
+        __m256 acceleration = _mm256_mul_ps(_mm256_load_ps(heading + start), _mm256_load_ps(thrust + start));
+        acceleration = _mm256_add_ps(base != nullptr ? _mm256_load_ps(base + start) : _mm256_setzero_ps(), acceleration);
+        _mm256_store_ps(velocity + start, _mm256_add_ps(_mm256_load_ps(velocity + start), acceleration));
+#else
+        if (base == nullptr)
+        {
+            for (size_t lane = 0; lane < BLOCK; lane++)
+            {
+                velocity[start + lane] += 0.0f + heading[start + lane] * thrust[start + lane];
+            }
+        }
+        else
+        {
+            for (size_t lane = 0; lane < BLOCK; lane++)
+            {
+                velocity[start + lane] += base[start + lane] + heading[start + lane] * thrust[start + lane];
+            }
+        }
+#endif
+    }
+}
+
+// position += velocity along one axis
+void integrate(float* __restrict position, const float* __restrict velocity, const size_t count)
+{
+    for (size_t start = 0; start < count; start += BLOCK)
+    {
+        for (size_t lane = 0; lane < BLOCK; lane++)
+        {
+            position[start + lane] += velocity[start + lane];
+        }
+    }
+}
+}
+
+ShipBatch::ShipBatch(const int width, const int height, const float gravity, const float thrustUnit, const float maxThrust, const float rotationSpeed)
+    : mCollisionWidth { static_cast<float>(width - (2 * COLLISION_BOX_MARGIN)) }
+    , mCollisionHeight { static_cast<float>(height - (2 * COLLISION_BOX_MARGIN)) }
+    , mGravity { gravity }
+    , mThrustUnit { thrustUnit }
+    , mMaxThrust { maxThrust }
+    , mRotationSpeed { rotationSpeed }
+    , mCount { 0 }
+{
+}
+
+size_t ShipBatch::add(const float x, const float y)
+{
+    size_t ship { append() };
+    Vector2D heading { Vector2D::heading(0) };
+    mPosX[ship] = x;
+    mPosY[ship] = y;
+    mHeadingX[ship] = heading.getX();
+    mHeadingY[ship] = heading.getY();
+    mGravityY[ship] = mGravity;
+    return ship;
+}
+
+size_t ShipBatch::add(const Spaceship& source)
+{
+    size_t ship { append() };
+    Vector2D heading { Spaceship::headingFor(source.getNoseAngle()) };
+    mPosX[ship] = source.getPosX();
+    mPosY[ship] = source.getPosY();
+    mVelX[ship] = source.getVelX();
+    mVelY[ship] = source.getVelY();
+    mHeadingX[ship] = heading.getX();
+    mHeadingY[ship] = heading.getY();
+    mThrust[ship] = source.getThrust();
+    mNoseAngle[ship] = source.getNoseAngle();
+    mGravityY[ship] = mGravity;
+    if (source.isDestroyed())
+    {
+        crash(ship);
+    }
+    return ship;
+}
+
+size_t ShipBatch::add(const ShipBatch& source, const size_t from)
+{
+    size_t ship { append() };
+    mPosX[ship] = source.mPosX[from];
+    mPosY[ship] = source.mPosY[from];
+    mVelX[ship] = source.mVelX[from];
+    mVelY[ship] = source.mVelY[from];
+    mHeadingX[ship] = source.mHeadingX[from];
+    mHeadingY[ship] = source.mHeadingY[from];
+    mThrust[ship] = source.mThrust[from];
+    mNoseAngle[ship] = source.mNoseAngle[from];
+    mGravityY[ship] = source.mGravityY[from];
+    mCrashed[ship] = source.mCrashed[from];
+    return ship;
+}
+
+void ShipBatch::clear()
+{
+    for (Floats* component : { &mPosX, &mPosY, &mVelX, &mVelY, &mHeadingX, &mHeadingY, &mThrust, &mNoseAngle, &mGravityY })
+    {
+        component->clear();
+    }
+    mCrashed.clear();
+    mCount = 0;
+}
+
+size_t ShipBatch::append()
+{
+    // clear keeps the capacity, so a batch refilled to the same size allocates nothing
+    if (mCount % BATCH_BLOCK_SIZE == 0)
+    {
+        for (Floats* component : { &mPosX, &mPosY, &mVelX, &mVelY, &mHeadingX, &mHeadingY, &mThrust, &mNoseAngle, &mGravityY })
+        {
+            component->resize(mCount + BATCH_BLOCK_SIZE, 0.0f);
+        }
+        mCrashed.resize(mCount + BATCH_BLOCK_SIZE, 0);
+    }
+    return mCount++;
+}
+
+void ShipBatch::control(const ShipInput* inputs)
+{
+    for (size_t ship = 0; ship < size(); ship++)
+    {
+        if (mCrashed[ship] != 0)
+        {
+            continue;
+        }
+
+        // Spaceship::rotate
+        if (inputs[ship].turn != 0)
+        {
+            float& angle { mNoseAngle[ship] };
+            angle += inputs[ship].turn > 0 ? mRotationSpeed : -mRotationSpeed;
+            if (angle >= 360.0f)
+            {
+                angle -= 360.0f;
+            }
+            if (angle < 0.0f)
+            {
+                angle += 360.0f;
+            }
+            assert(angle >= 0.0f && angle < 360.0f);
+            Vector2D heading { Spaceship::headingFor(angle) };
+            mHeadingX[ship] = heading.getX();
+            mHeadingY[ship] = heading.getY();
+        }
+
+        // Spaceship::thrustIncrease and thrustDecay
+        float& thrust { mThrust[ship] };
+        if (inputs[ship].thrust)
+        {
+            thrust = thrust < mThrustUnit ? mThrustUnit : thrust + mThrustUnit;
+            if (thrust > mMaxThrust)
+            {
+                thrust = mMaxThrust;
+            }
+        }
+        else
+        {
+            thrust = thrust > mThrustUnit ? thrust - mThrustUnit : 0.0f;
+        }
+    }
+}
+
+void ShipBatch::updatePhysics()
+{
+    accelerate();
+    integrate(mPosX.data(), mVelX.data(), mPosX.size());
+    integrate(mPosY.data(), mVelY.data(), mPosY.size());
+}
+
+void ShipBatch::crash(const size_t ship)
+{
+    // nothing left to move it, so the steps can carry on over it without a mask
+    mCrashed[ship] = 1;
+    mGravityY[ship] = 0;
+    mThrust[ship] = 0;
+    mVelX[ship] = 0;
+    mVelY[ship] = 0;
+}
+
+void ShipBatch::accelerate()
+{
+    // as Spaceship::accelerate, acceleration = gravity + heading * thrust, then velocity += acceleration
+    accelerateAlong(mVelX.data(), nullptr, mHeadingX.data(), mThrust.data(), mVelX.size());
+    accelerateAlong(mVelY.data(), mGravityY.data(), mHeadingY.data(), mThrust.data(), mVelY.size());
+}
@@ -1,31 +1,42 @@
 #include "lunar_lander/Spaceship.h"
 #include "lunar_lander/Constants.h"
 #include <cassert>
+#include <limits>
 #include <iostream>
 
 Spaceship::Spaceship()
     : mNoseAngle { 0 }
-    , mThrustUnit { THRUST_UNIT }
-    , mMaxThrust { MAX_THRUST }
+    , mThrustUnit { fromFloat<PhysicsScalar>(THRUST_UNIT) }
+    , mMaxThrust { fromFloat<PhysicsScalar>(MAX_THRUST) }
     , mPosition { 0, 0 }
+    , mPreviousPosition { 0, 0 }
     , mVelocity { 0, 0 }
     , mAcceleration { 0, 0 }
+    , mHeading { PhysicsVector::heading(0) }
+    , mThrustMagnitude { 0 }
     , mThrust { 0, 0 }
-    , mGravity { 0, GRAVITY }
-    , mTexture { nullptr }
+    , mGravity { 0, fromFloat<PhysicsScalar>(GRAVITY) }
+    , mWidth { 0 }
+    , mHeight { 0 }
+    , mCollisionMask { nullptr }
 {
 }
 
-Spaceship::Spaceship(int x, int y, Texture* texture, float gravity, float thrustUnit, float maxThrust)
+Spaceship::Spaceship(int x, int y, int width, int height, float gravity, float thrustUnit, float maxThrust)
     : mNoseAngle { 0 }
-    , mThrustUnit { thrustUnit }
-    , mMaxThrust { maxThrust }
-    , mPosition { static_cast<float>(x), static_cast<float>(y) }
+    , mThrustUnit { fromFloat<PhysicsScalar>(thrustUnit) }
+    , mMaxThrust { fromFloat<PhysicsScalar>(maxThrust) }
+    , mPosition { static_cast<PhysicsScalar>(x), static_cast<PhysicsScalar>(y) }
+    , mPreviousPosition { mPosition }
     , mVelocity { 0, 0 }
     , mAcceleration { 0, 0 }
+    , mHeading { PhysicsVector::heading(0) }
+    , mThrustMagnitude { 0 }
     , mThrust { 0, 0 }
-    , mGravity { 0, gravity }
-    , mTexture { texture }
+    , mGravity { 0, fromFloat<PhysicsScalar>(gravity) }
+    , mWidth { width }
+    , mHeight { height }
+    , mCollisionMask { nullptr }
 {
 }
 
@@ -42,7 +53,42 @@ void Spaceship::rotate(const float angle)
         mNoseAngle += 360.0f;
     }
     assert(mNoseAngle >= 0.0f && mNoseAngle < 360.0f);
-    mThrust.rotateTo(mNoseAngle);
+
+    mHeading = physicsHeadingFor(mNoseAngle);
+    mThrust = mHeading * mThrustMagnitude;
+}
+
+Vector2D Spaceship::headingFor(const float noseAngle)
+{
+    return vectorCast<float>(physicsHeadingFor(noseAngle));
+}
+
+PhysicsVector Spaceship::physicsHeadingFor(const float noseAngle)
+{
+    // whole degrees, all ROTATION_SPEED turns by, come from the table.
+    // The angle is never negative, so truncating is flooring without a call into the maths library
+    int wholeDegrees { static_cast<int>(noseAngle) };
+    if (static_cast<float>(wholeDegrees) == noseAngle)
+    {
+        return PhysicsVector::heading(wholeDegrees);
+    }
+#ifdef LUNAR_LANDER_FIXED_POINT
+    // sin and cos differ between maths libraries, so the table's heading is turned on by the rest of the
+    // angle with their series, which under a degree are exact to well below the last bit after two terms
+    constexpr PhysicsScalar RADIANS_PER_DEGREE { 3.14159265358979323846 / 180.0 };
+    PhysicsScalar turn { fromFloat<PhysicsScalar>(noseAngle - static_cast<float>(wholeDegrees)) * RADIANS_PER_DEGREE };
+    PhysicsScalar turnSquared { turn * turn };
+    PhysicsScalar sine { turn - turn * turnSquared / 6 };
+    PhysicsScalar cosine { 1 - turnSquared / 2 + turnSquared * turnSquared / 24 };
+    const PhysicsVector& table { PhysicsVector::heading(wholeDegrees) };
+    return PhysicsVector {
+        table.getX() * cosine - table.getY() * sine,
+        table.getY() * cosine + table.getX() * sine };
+#else
+    Vector2D heading { 0.0f, -1.0f };
+    heading.rotateTo(noseAngle);
+    return heading;
+#endif
 }
 
 void Spaceship::alignVertical(const float angle)
@@ -64,76 +110,120 @@ void Spaceship::alignVertical(const float angle)
 
 void Spaceship::thrustIncrease()
 {
-    float currentMagnitude { mThrust.getMagnitude() };
-
     // handling for small / zero thrust
-    if (currentMagnitude < mThrustUnit)
+    if (mThrustMagnitude < mThrustUnit)
     {
-        mThrust.setMagnitude(mThrustUnit);
-        mThrust.rotateTo(mNoseAngle);
+        mThrustMagnitude = mThrustUnit;
     }
     else
     {
-        mThrust.setMagnitude(currentMagnitude + mThrustUnit);
+        mThrustMagnitude += mThrustUnit;
     }
 
     // limit thrust to the max thrust
-    if (mThrust.getMagnitude() > mMaxThrust)
+    if (mThrustMagnitude > mMaxThrust)
     {
-        mThrust.setMagnitude(mMaxThrust);
+        mThrustMagnitude = mMaxThrust;
     }
+    mThrust = mHeading * mThrustMagnitude;
 }
 
 void Spaceship::thrustDecay()
 {
-    float currentMagnitude { mThrust.getMagnitude() };
-    if (currentMagnitude > mThrustUnit)
+    // the minimum thrust is zero
+    if (mThrustMagnitude > mThrustUnit)
     {
-        mThrust.setMagnitude(currentMagnitude - mThrustUnit);
+        mThrustMagnitude -= mThrustUnit;
     }
     else
     {
-        mThrust.setMagnitude(0);
+        mThrustMagnitude = 0;
     }
+    mThrust = mHeading * mThrustMagnitude;
+}
 
-    // the minimum thrust is zero
-    if (mThrust.getMagnitude() < 0)
-    {
-        mThrust.setMagnitude(0);
-    }
+void Spaceship::setCollisionMask(const SpriteMask* mask)
+{
+    mCollisionMask = mask;
 }
 
 void Spaceship::updatePhysics()
 {
+    accelerate();
+    mPosition += mVelocity;
+}
+
+Vector2D Spaceship::getDrawPosition(const float alpha) const
+{
+    // measured back from the current position so alpha 1 is exactly where the ship is
+    Vector2D position { vectorCast<float>(mPosition) };
+    Vector2D previousPosition { vectorCast<float>(mPreviousPosition) };
+    return position - (position - previousPosition) * (1.0f - alpha);
+}
+
+void Spaceship::accelerate()
+{
+    mPreviousPosition = mPosition;
     mAcceleration = mGravity + mThrust;
     mVelocity += mAcceleration;
-    mPosition += mVelocity;
 }
 
-SDL_Rect Spaceship::getDrawBounds() const
+bool Spaceship::moveUntilContact(const BasicBoxHit<PhysicsScalar>& contact)
+{
+    if (!contact.hit)
+    {
+        mPosition += mVelocity;
+        return false;
+    }
+
+    // come to rest touching the terrain rather than backing out of it like resetVelocity
+    mPosition += mVelocity * contact.time;
+    mVelocity.setX(0);
+    mVelocity.setY(0);
+    return !contact.landingPad;
+}
+
+PhysicsScalar Spaceship::getCollisionWidth() const
+{
+    return static_cast<PhysicsScalar>(mWidth - (2 * COLLISION_BOX_MARGIN));
+}
+
+PhysicsScalar Spaceship::getCollisionHeight() const
+{
+    return static_cast<PhysicsScalar>(mHeight - (2 * COLLISION_BOX_MARGIN));
+}
+
+Rect Spaceship::getDrawBounds() const
 {
     return {
-        static_cast<int>(mPosition.getX()),
-        static_cast<int>(mPosition.getY()),
-        mTexture->getWidth(),
-        mTexture->getHeight()
+        toInt(mPosition.getX()),
+        toInt(mPosition.getY()),
+        mWidth,
+        mHeight
     };
 }
 
-SDL_Rect Spaceship::getCollisionBounds() const
+Rect Spaceship::getCollisionBounds() const
 {
-    SDL_Rect drawBounds { getDrawBounds() };
+    Rect drawBounds { getDrawBounds() };
+    if (mCollisionMask != nullptr)
+    {
+        Rect bounds { mCollisionMask->getBounds(SpriteMask::angleIndex(mNoseAngle)) };
+        bounds.x += drawBounds.x;
+        bounds.y += drawBounds.y;
+        return bounds;
+    }
     return {
         drawBounds.x + COLLISION_BOX_MARGIN,
         drawBounds.y + COLLISION_BOX_MARGIN,
-        mTexture->getWidth() - (2 * COLLISION_BOX_MARGIN),
-        mTexture->getHeight() - (2 * COLLISION_BOX_MARGIN)
+        mWidth - (2 * COLLISION_BOX_MARGIN),
+        mHeight - (2 * COLLISION_BOX_MARGIN)
     };
 }
 
 bool Spaceship::handleBoundaryCollision(int worldWidth, int worldHeight)
 {
-    SDL_Rect bounds = getDrawBounds();
+    Rect bounds = getDrawBounds();
     bool collision = false;
 
     if (bounds.x < 0)
@@ -164,20 +254,29 @@ bool Spaceship::handleBoundaryCollision(int worldWidth, int worldHeight)
     return collision;
 }
 
-bool Spaceship::handleTerrainCollision(std::vector<std::vector<int>>& terrain)
+bool Spaceship::handleTerrainCollision(const TerrainGrid& terrain)
 {
-    SDL_Rect bounds { getCollisionBounds() };
+    if (mCollisionMask != nullptr)
+    {
+        return handleMaskCollision(terrain);
+    }
+
+    Rect bounds { getCollisionBounds() };
     int startX { std::max(0, bounds.x) };
     int startY { std::max(0, bounds.y) };
-    int endX { std::min(static_cast<int>(terrain.at(0).size()), (bounds.x + bounds.w)) };
-    int endY { std::min(static_cast<int>(terrain.size()), (bounds.y + bounds.h)) };
+    int endX { std::min(static_cast<int>(terrain.getWidth()), (bounds.x + bounds.w)) };
+    int endY { std::min(static_cast<int>(terrain.getHeight()), (bounds.y + bounds.h)) };
+    if (startX >= endX || startY >= endY || isVacuum(terrain, startX, startY, endX, endY))
+    {
+        return false;
+    }
 
     bool hitLandingPad { false };
     for (int y = startY; y != endY; y++)
     {
         for (int x = startX; x != endX; x++)
         {   
-            switch (terrain[static_cast<size_t>(y)][static_cast<size_t>(x)])
+            switch (terrain.at(static_cast<size_t>(x), static_cast<size_t>(y)))
             {
                 // any rock collision and its gameover - short out here
                 case TERRAIN_ROCK:
@@ -202,31 +301,212 @@ bool Spaceship::handleTerrainCollision(std::vector<std::vector<int>>& terrain)
     return false;
 }
 
-FlightStats Spaceship::getFlightStats() const
+bool Spaceship::handleTerrainCollision(const TerrainHeightmap& terrain)
 {
-    return FlightStats {
-        mNoseAngle,
-        mPosition.getX(),
-        mPosition.getY(),
-        mVelocity.getX(),
-        mVelocity.getY(),
-        mAcceleration.getX(),
-        mAcceleration.getY(),
-        mThrust.getMagnitude()
-    };
+    if (mCollisionMask != nullptr)
+    {
+        return handleMaskCollision(terrain);
+    }
+
+    Rect bounds { getCollisionBounds() };
+    int startX { std::max(0, bounds.x) };
+    int startY { std::max(0, bounds.y) };
+    int endX { std::min(static_cast<int>(terrain.getWidth()), (bounds.x + bounds.w)) };
+    int endY { std::min(static_cast<int>(terrain.getHeight()), (bounds.y + bounds.h)) };
+    if (startX >= endX || startY >= endY)
+    {
+        return false;
+    }
+
+    int minRockSurface { endY };
+    int minPadSurface { endY };
+    findMinSurfaces(terrain, startX, endX, minRockSurface, minPadSurface);
+    return resolveTerrainCollision(minRockSurface, minPadSurface, endY);
+}
+
+bool Spaceship::handleTerrainCollision(const ChunkManager& terrain)
+{
+    if (mCollisionMask != nullptr)
+    {
+        return handleMaskCollision(terrain);
+    }
+
+    Rect bounds { getCollisionBounds() };
+    int startX { std::max(0, bounds.x) };
+    int startY { std::max(0, bounds.y) };
+    int endX { std::min(static_cast<int>(terrain.getWidth()), (bounds.x + bounds.w)) };
+    int endY { std::min(static_cast<int>(terrain.getHeight()), (bounds.y + bounds.h)) };
+    if (startX >= endX || startY >= endY)
+    {
+        return false;
+    }
+
+    // the box can straddle a chunk boundary, chunks that are not resident have no terrain
+    int chunkWidth { static_cast<int>(terrain.getChunkWidth()) };
+    int minRockSurface { endY };
+    int minPadSurface { endY };
+    for (int chunkStart = startX / chunkWidth * chunkWidth; chunkStart < endX; chunkStart += chunkWidth)
+    {
+        const TerrainChunk* chunk { terrain.findChunk(static_cast<size_t>(chunkStart / chunkWidth)) };
+        if (chunk != nullptr)
+        {
+            int begin { std::max(startX, chunkStart) - chunkStart };
+            int end { std::min(endX, chunkStart + chunkWidth) - chunkStart };
+            findMinSurfaces(chunk->terrain, begin, end, minRockSurface, minPadSurface);
+        }
+    }
+    return resolveTerrainCollision(minRockSurface, minPadSurface, endY);
+}
+
+void Spaceship::handleBodyCollision()
+{
+    resetVelocity();
+}
+
+bool Spaceship::handleMaskCollision(const TerrainGrid& terrain)
+{
+    int angle { SpriteMask::angleIndex(mNoseAngle) };
+    Rect drawBounds { getDrawBounds() };
+    Rect bounds { getCollisionBounds() };
+    int frameX { drawBounds.x + mCollisionMask->getOffsetX() };
+    int frameY { drawBounds.y + mCollisionMask->getOffsetY() };
+    int width { static_cast<int>(terrain.getWidth()) };
+    int startY { std::max(0, bounds.y) };
+    int endY { std::min(static_cast<int>(terrain.getHeight()), (bounds.y + bounds.h)) };
+    int startX { std::max(0, bounds.x) };
+    int endX { std::min(width, (bounds.x + bounds.w)) };
+    if (startX >= endX || startY >= endY || isVacuum(terrain, startX, startY, endX, endY))
+    {
+        return false;
+    }
+
+    // AND each mask row, 64 pixels at a time, against the matching cells of the terrain row.
+    // Bottom up, the ground is below the ship far more often than above it
+    bool hitRock { false };
+    bool hitLandingPad { false };
+    for (int y = endY - 1; y >= startY && !hitRock; y--)
+    {
+        const std::uint64_t* row { mCollisionMask->rowData(angle, y - frameY) };
+        for (size_t word = 0; word < mCollisionMask->getWordsPerRow(); word++)
+        {
+            std::uint64_t bits { row[word] };
+            int x { frameX + static_cast<int>(word * 64) };
+            if (bits == 0 || x + 64 <= 0 || x >= width)
+            {
+                continue;
+            }
+            // line the mask up with the start of the row where it hangs off the left edge
+            if (x < 0)
+            {
+                bits >>= -x;
+                x = 0;
+            }
+            size_t cellX { static_cast<size_t>(x) };
+            size_t cellY { static_cast<size_t>(y) };
+            hitRock = (bits & terrain.matchCells(cellX, cellY, TERRAIN_ROCK)) != 0;
+            if (hitRock)
+            {
+                break;
+            }
+            hitLandingPad = hitLandingPad || (bits & terrain.matchCells(cellX, cellY, TERRAIN_LANDING_PAD)) != 0;
+        }
+    }
+    return resolveTerrainCollision(hitRock, hitLandingPad);
+}
+
+template <typename Terrain>
+bool Spaceship::handleMaskCollision(const Terrain& terrain)
+{
+    int angle { SpriteMask::angleIndex(mNoseAngle) };
+    Rect drawBounds { getDrawBounds() };
+    int frameX { drawBounds.x + mCollisionMask->getOffsetX() };
+    int frameY { drawBounds.y + mCollisionMask->getOffsetY() };
+    int width { static_cast<int>(terrain.getWidth()) };
+    int height { static_cast<int>(terrain.getHeight()) };
+
+    // columns are solid from their surface down, so only the lowest opaque pixel of each mask column matters
+    const MaskColumn* columns { mCollisionMask->columnData(angle) };
+    bool hitRock { false };
+    bool hitLandingPad { false };
+    for (int column = 0; column < mCollisionMask->getFrameSize() && !hitRock; column++)
+    {
+        const MaskColumn& span { columns[column] };
+        int x { frameX + column };
+        if (span.top == span.bottom || x < 0 || x >= width || frameY + span.top >= height)
+        {
+            continue;
+        }
+        size_t terrainX { static_cast<size_t>(x) };
+        if (terrain.getSurface(terrainX) < frameY + span.bottom)
+        {
+            bool& hit { terrain.isLandingPad(terrainX) ? hitLandingPad : hitRock };
+            hit = true;
+        }
+    }
+    return resolveTerrainCollision(hitRock, hitLandingPad);
+}
+
+bool Spaceship::isVacuum(const TerrainGrid& terrain, const int startX, const int startY, const int endX, const int endY)
+{
+    // most of a flight is far from the ground, where the pyramid rules the box out without reading cells
+    return terrain.isVacuum(static_cast<size_t>(startX), static_cast<size_t>(startY), static_cast<size_t>(endX - startX), static_cast<size_t>(endY - startY));
 }
 
-void Spaceship::render(const int x, const int y) const
+void Spaceship::findMinSurfaces(const TerrainHeightmap& terrain, const int startX, const int endX, int& minRockSurface, int& minPadSurface)
 {
-    if (!mIsDestroyed)
+    // columns are solid from their surface to the bottom of the world,
+    // so a column touches the box when its surface is above the bottom edge
+    const int* surface { terrain.surfaceData() };
+    const std::uint8_t* landingPad { terrain.landingPadData() };
+    for (int x = startX; x != endX; x++)
     {
-        mTexture->render(x, y, NULL, static_cast<double>(mNoseAngle));
+        int& minSurface { landingPad[x] ? minPadSurface : minRockSurface };
+        minSurface = std::min(minSurface, surface[x]);
     }
 }
 
+bool Spaceship::resolveTerrainCollision(const int minRockSurface, const int minPadSurface, const int bottom)
+{
+    return resolveTerrainCollision(minRockSurface < bottom, minPadSurface < bottom);
+}
+
+bool Spaceship::resolveTerrainCollision(const bool hitRock, const bool hitLandingPad)
+{
+    // any rock collision and its gameover
+    if (hitRock)
+    {
+        resetVelocity();
+        return true;
+    }
+    if (hitLandingPad)
+    {
+        resetVelocity();
+    }
+    return false;
+}
+
+FlightStats Spaceship::getFlightStats() const
+{
+    return FlightStats {
+        mNoseAngle,
+        toFloat(mPosition.getX()),
+        toFloat(mPosition.getY()),
+        toFloat(mVelocity.getX()),
+        toFloat(mVelocity.getY()),
+        toFloat(mAcceleration.getX()),
+        toFloat(mAcceleration.getY()),
+        toFloat(mThrustMagnitude),
+        // the ship does not know about the terrain or the autopilot
+        std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+}
+
 void Spaceship::resetVelocity()
 {
-    Vector2D oppositeVelocity { mVelocity * -1.0f };
+    PhysicsVector oppositeVelocity { mVelocity * PhysicsScalar { -1 } };
     mPosition += oppositeVelocity;
     mVelocity.setX(0);
     mVelocity.setY(0);
@@ -241,3 +521,33 @@ bool Spaceship::isDestroyed() const
 {
     return mIsDestroyed;
 }
+
+Spaceship::State Spaceship::saveState() const
+{
+    return State { mNoseAngle, mThrustMagnitude, mPosition, mPreviousPosition, mVelocity, mAcceleration, mHeading, mThrust, mIsDestroyed };
+}
+
+void Spaceship::restoreState(const State& state)
+{
+    mNoseAngle = state.noseAngle;
+    mThrustMagnitude = state.thrustMagnitude;
+    mPosition = state.position;
+    mPreviousPosition = state.previousPosition;
+    mVelocity = state.velocity;
+    mAcceleration = state.acceleration;
+    mHeading = state.heading;
+    mThrust = state.thrust;
+    mIsDestroyed = state.isDestroyed;
+}
+
+void Spaceship::hashState(StateHash& hash) const
+{
+    hash.add(mNoseAngle);
+    hash.add(mThrustMagnitude);
+    for (const PhysicsVector& vector : { mPosition, mPreviousPosition, mVelocity, mAcceleration, mHeading, mThrust })
+    {
+        hash.add(vector.getX());
+        hash.add(vector.getY());
+    }
+    hash.add(mIsDestroyed);
+}
@@ -6,11 +6,12 @@ StarfieldGenerator::StarfieldGenerator()
     , mMediumScaleNoise(std::random_device{}())
     , mSmallScaleNoise(std::random_device{}())
     , mVariationNoise(std::random_device{}())
+    , mUseNoiseTables(false)
     , mGenerator(std::random_device{}())
 {
 }
 
-void StarfieldGenerator::generateStarfield(int width, int height, size_t targetStars)
+void StarfieldGenerator::generateStarfield(int width, int height, size_t targetStars, bool useNoiseTables)
 {
     // Reinitialize noise generators with new seed each time
     unsigned int seed = std::random_device{}();
@@ -26,6 +27,12 @@ void StarfieldGenerator::generateStarfield(int width, int height, size_t targetS
     mGalacticCenterX = static_cast<int>(width * 0.3); // Off-center for realism
     mGalacticCenterY = static_cast<int>(height * 0.35); // Lower third of screen
     mGalacticPlaneY = static_cast<int>(height * 0.45); // Slightly below center
+
+    mUseNoiseTables = useNoiseTables;
+    if (mUseNoiseTables)
+    {
+        buildNoiseTables();
+    }
     
     mStars.clear();
     mStars.reserve(4000); // Pre-allocate for performance
@@ -69,8 +76,8 @@ void StarfieldGenerator::generateGalacticPlane(size_t starCount)
         int x = xDist(mGenerator);
 
         // Use 1D noise along X-axis to vary the galactic plane density
-        double xNoise = mLargeScaleNoise.octaveNoise(x * 0.003, 3, 0.5, 1.0); // Large-scale structure
-        double localVariation = mVariationNoise.noise(x * 0.02); // Local variation
+        double xNoise = sampleNoise(mLargeScaleNoise, mGalacticPlaneTable, x * 0.003, 3, 0.5); // Large-scale structure
+        double localVariation = sampleNoise(mVariationNoise, mVariationTable, x * 0.02); // Local variation
 
         // Combine noise sources for complex density variation
         double densityFactor = (xNoise * 0.7 + localVariation * 0.3 + 1.0) * 0.5; // Normalize to [0,1]
@@ -123,7 +130,7 @@ void StarfieldGenerator::generateGalacticCenter(size_t starCount)
         double distanceFromCenter = calculateDistanceFromCenter(x, y);
 
         // Use distance as input to 1D noise for central structure
-        double centralNoise = mMediumScaleNoise.octaveNoise(distanceFromCenter * 0.01, 2, 0.6, 1.0);
+        double centralNoise = sampleNoise(mMediumScaleNoise, mGalacticCenterTable, distanceFromCenter * 0.01, 2, 0.6);
 
         // Probability decreases exponentially with distance from center
         double distanceFactor = std::exp(-distanceFromCenter * distanceFromCenter * 0.00001);
@@ -175,8 +182,8 @@ void StarfieldGenerator::generateSpiralArms(size_t starCount)
             }
 
             // Use radius as input to 1D noise for spiral arm density
-            double spiralNoise = mMediumScaleNoise.octaveNoise(radius * 0.005, 2, 0.5, 1.0);
-            double localNoise = mSmallScaleNoise.noise(radius * 0.02);
+            double spiralNoise = sampleNoise(mMediumScaleNoise, mSpiralArmTable, radius * 0.005, 2, 0.5);
+            double localNoise = sampleNoise(mSmallScaleNoise, mSpiralLocalTable, radius * 0.02);
 
             double armDensity = (spiralNoise * 0.8 + localNoise * 0.2 + 1.0) * 0.5;
 
@@ -249,7 +256,7 @@ void StarfieldGenerator::generateBackgroundStars(size_t starCount)
         int y = yDist(mGenerator);
 
         // Very slight density variation using 1D noise
-        double variation = mVariationNoise.noise((x + y) * 0.001);
+        double variation = sampleNoise(mVariationNoise, mVariationTable, (x + y) * 0.001);
         double intensity = (variation + 1.0) * 0.25 + 0.3; // Range [0.3, 0.8]
 
         addStar(x, y, static_cast<double>(intensity), 0.8);
@@ -268,6 +275,35 @@ double StarfieldGenerator::calculateDistanceFromCenter(int x, int y) const
     return static_cast<double>(std::sqrt(dx * dx + dy * dy));
 }
 
+void StarfieldGenerator::buildNoiseTables()
+{
+    // each table spans the inputs its structure generator can produce
+    double diagonal = std::sqrt(static_cast<double>(mWidth) * mWidth + static_cast<double>(mHeight) * mHeight);
+    mGalacticPlaneTable = NoiseTable(mLargeScaleNoise, 3, 0.5, 1.0, 0.0, mWidth * 0.003);
+    mVariationTable = NoiseTable(mVariationNoise, 1, 0.5, 1.0, 0.0, std::max(mWidth * 0.02, (mWidth + mHeight) * 0.001));
+    mGalacticCenterTable = NoiseTable(mMediumScaleNoise, 2, 0.6, 1.0, 0.0, diagonal * 0.01);
+    mSpiralArmTable = NoiseTable(mMediumScaleNoise, 2, 0.5, 1.0, mWidth * 0.1 * 0.005, mWidth * 0.4 * 0.005);
+    mSpiralLocalTable = NoiseTable(mSmallScaleNoise, 1, 0.5, 1.0, mWidth * 0.1 * 0.02, mWidth * 0.4 * 0.02);
+}
+
+double StarfieldGenerator::getNoiseTableErrorBound() const
+{
+    if (!mUseNoiseTables)
+    {
+        return 0.0;
+    }
+    return std::max({ mGalacticPlaneTable.getErrorBound(),
+        mVariationTable.getErrorBound(),
+        mGalacticCenterTable.getErrorBound(),
+        mSpiralArmTable.getErrorBound(),
+        mSpiralLocalTable.getErrorBound() });
+}
+
+double StarfieldGenerator::sampleNoise(const PerlinNoise1D& noise, const NoiseTable& table, double x, int octaves, double persistence) const
+{
+    return mUseNoiseTables ? table.sample(x) : noise.octaveNoise(x, octaves, persistence, 1.0);
+}
+
 void StarfieldGenerator::addStar(int x, int y, double intensity, double baseSize)
 {
     // Clamp coordinates
@@ -0,0 +1,206 @@
+#include "lunar_lander/TerrainCache.h"
+#include "engine/MappedFile.h"
+#include "engine/StateHash.h"
+#include "lunar_lander/PhysicsScalar.h"
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+constexpr char MAGIC[4] { 'L', 'L', 'T', 'C' };
+
+// numbers the temporary files of this process, so threads saving the same world never share one
+std::atomic<unsigned int> temporaryFileCount { 0 };
+
+int processId()
+{
+#ifdef _WIN32
+    return _getpid();
+#else
+    return getpid();
+#endif
+}
+}
+
+TerrainCache::TerrainCache(const std::string& directory)
+    : mDirectory { directory }
+{
+}
+
+std::uint64_t TerrainCache::configHash(const TerrainGenerationConfig& config, const int averageNumberOfLandingPads)
+{
+    // fields are hashed one by one so struct padding never leaks into the key
+    StateHash hash {};
+    hash.add(FORMAT_VERSION);
+    hash.add(config.seed);
+    hash.add(static_cast<std::uint64_t>(config.worldWidth));
+    hash.add(static_cast<std::uint64_t>(config.worldHeight));
+    hash.add(config.heightVariation);
+    hash.add(config.startHeight);
+    hash.add(config.octaves);
+    hash.add(config.persistence);
+    hash.add(config.scale);
+    hash.add(static_cast<std::uint8_t>(config.useNoiseTable));
+    hash.add(averageNumberOfLandingPads);
+    // fixed point builds generate other worlds from the same config, float keys are left as they were
+    if (FIXED_POINT_PHYSICS)
+    {
+        hash.add(static_cast<std::uint8_t>(FIXED_POINT_PHYSICS));
+    }
+    return hash.getValue();
+}
+
+std::string TerrainCache::pathFor(const TerrainGenerationConfig& config, const int averageNumberOfLandingPads) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.terrain", static_cast<unsigned long long>(configHash(config, averageNumberOfLandingPads)));
+    return (std::filesystem::path(mDirectory) / name).string();
+}
+
+size_t TerrainCache::padOffset(const size_t width)
+{
+    size_t surfaceEnd { sizeof(Header) + width * sizeof(std::uint16_t) };
+    return (surfaceEnd + alignof(PadRecord) - 1) / alignof(PadRecord) * alignof(PadRecord);
+}
+
+bool TerrainCache::load(const TerrainGenerationConfig& config, const int averageNumberOfLandingPads, TerrainHeightmap& terrain, std::vector<TerrainGenerator::PadInterval>& pads) const
+{
+    MappedFile file {};
+    if (!file.open(pathFor(config, averageNumberOfLandingPads)) || file.size() < sizeof(Header))
+    {
+        return false;
+    }
+
+    Header header {};
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+        || header.version != FORMAT_VERSION
+        || header.configHash != configHash(config, averageNumberOfLandingPads)
+        || header.width != config.worldWidth
+        || header.height != config.worldHeight)
+    {
+        return false;
+    }
+    size_t width { header.width };
+    size_t height { header.height };
+    size_t padBegin { padOffset(width) };
+    if (file.size() != padBegin + header.padCount * sizeof(PadRecord))
+    {
+        return false;
+    }
+
+    // the mapping is only 1 byte aligned as far as the compiler knows, so columns are copied out with memcpy
+    std::vector<std::uint16_t> surfaces(width);
+    std::memcpy(surfaces.data(), file.data() + sizeof(Header), width * sizeof(std::uint16_t));
+    std::vector<TerrainGenerator::PadInterval> loadedPads(header.padCount);
+    for (size_t i = 0; i < loadedPads.size(); i++)
+    {
+        PadRecord record {};
+        std::memcpy(&record, file.data() + padBegin + i * sizeof(PadRecord), sizeof(PadRecord));
+        if (static_cast<size_t>(record.start) + record.width > width)
+        {
+            return false;
+        }
+        loadedPads[i] = { record.start, record.width };
+    }
+
+    terrain.resize(width, height);
+    for (size_t x = 0; x < width; x++)
+    {
+        terrain.setColumn(x, surfaces[x], false);
+    }
+    for (const auto& pad : loadedPads)
+    {
+        for (size_t x = pad.start; x != pad.start + pad.width; x++)
+        {
+            terrain.setColumn(x, surfaces[x], true);
+        }
+    }
+    pads = std::move(loadedPads);
+    return true;
+}
+
+bool TerrainCache::save(const TerrainGenerationConfig& config, const int averageNumberOfLandingPads, const TerrainHeightmap& terrain, const std::vector<TerrainGenerator::PadInterval>& pads) const
+{
+    if (terrain.getHeight() > std::numeric_limits<std::uint16_t>::max()
+        || terrain.getWidth() > std::numeric_limits<std::uint32_t>::max()
+        || pads.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        return false;
+    }
+
+    Header header {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.configHash = configHash(config, averageNumberOfLandingPads);
+    header.width = static_cast<std::uint32_t>(terrain.getWidth());
+    header.height = static_cast<std::uint32_t>(terrain.getHeight());
+    header.padCount = static_cast<std::uint32_t>(pads.size());
+
+    // assemble the whole file in memory and write it in one go
+    size_t width { terrain.getWidth() };
+    size_t padBegin { padOffset(width) };
+    std::vector<char> bytes(padBegin + pads.size() * sizeof(PadRecord), 0);
+    std::memcpy(bytes.data(), &header, sizeof(Header));
+    for (size_t x = 0; x < width; x++)
+    {
+        std::uint16_t surface { static_cast<std::uint16_t>(terrain.getSurface(x)) };
+        std::memcpy(bytes.data() + sizeof(Header) + x * sizeof(std::uint16_t), &surface, sizeof(surface));
+    }
+    for (size_t i = 0; i < pads.size(); i++)
+    {
+        PadRecord record { static_cast<std::uint32_t>(pads[i].start), static_cast<std::uint32_t>(pads[i].width) };
+        std::memcpy(bytes.data() + padBegin + i * sizeof(PadRecord), &record, sizeof(PadRecord));
+    }
+
+    // write next to the final file and rename, so concurrent readers never map a partial world.
+    // The temporary name is unique to this process and save, as other processes or threads may
+    // be writing the same world at the same time and the last rename simply wins
+    std::error_code error {};
+    std::filesystem::create_directories(mDirectory, error);
+    std::string path { pathFor(config, averageNumberOfLandingPads) };
+    std::string temporaryPath { path + "." + std::to_string(processId()) + "." + std::to_string(temporaryFileCount++) + ".tmp" };
+    bool written { false };
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        written = static_cast<bool>(file.write(bytes.data(), static_cast<std::streamsize>(bytes.size())));
+    }
+    if (written)
+    {
+        std::filesystem::rename(temporaryPath, path, error);
+    }
+    if (!written || error)
+    {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool TerrainCache::loadOrGenerate(const TerrainGenerationConfig& config, const int averageNumberOfLandingPads, TerrainHeightmap& terrain, std::vector<TerrainGenerator::PadInterval>& pads) const
+{
+    if (load(config, averageNumberOfLandingPads, terrain, pads))
+    {
+        printf("Loaded terrain for seed %u from the cache\n", config.seed);
+        return true;
+    }
+
+    // the world is filed under config.seed, so it is generated from that seed and no other
+    TerrainGenerator generator { config.seed };
+    generator.generateTerrain(terrain, config, averageNumberOfLandingPads);
+    pads = generator.getLandingPads();
+    if (!save(config, averageNumberOfLandingPads, terrain, pads))
+    {
+        printf("Unable to write terrain cache file %s\n", pathFor(config, averageNumberOfLandingPads).c_str());
+    }
+    return false;
+}
@@ -1,131 +1,325 @@
 #include "lunar_lander/Constants.h"
+#include "lunar_lander/PhysicsScalar.h"
 #include "lunar_lander/TerrainGenerator.h"
+#include "engine/ParallelFor.h"
+#include <algorithm>
 #include <iostream>
 #include <random>
 
+namespace
+{
+// The std distributions are implemented differently by each standard library, so fixed point builds
+// draw straight from the engine, whose output the standard fixes
+double drawChance(std::mt19937& randomNumberGenerator)
+{
+    if constexpr (FIXED_POINT_PHYSICS)
+    {
+        return static_cast<double>(randomNumberGenerator()) / 4294967296.0;
+    }
+    else
+    {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(randomNumberGenerator);
+    }
+}
+
+int drawLandingPadWidth(std::mt19937& randomNumberGenerator)
+{
+    if constexpr (FIXED_POINT_PHYSICS)
+    {
+        return static_cast<int>(MIN_LANDING_PAD_WIDTH + randomNumberGenerator() % (MAX_LANDING_PAD_WIDTH - MIN_LANDING_PAD_WIDTH + 1));
+    }
+    else
+    {
+        return std::uniform_int_distribution<int>(MIN_LANDING_PAD_WIDTH, MAX_LANDING_PAD_WIDTH)(randomNumberGenerator);
+    }
+}
+}
+
+TerrainGenerationConfig makeWorldConfig(const unsigned int seed, const size_t worldWidth, const bool useNoiseTable)
+{
+    return TerrainGenerationConfig {
+        seed,
+        worldWidth,
+        static_cast<size_t>(WORLD_HEIGHT),
+        static_cast<int>(WORLD_HEIGHT * TERRAIN_HEIGHT_VARIATION),
+        static_cast<int>(WORLD_HEIGHT * TERRAIN_START_HEIGHT),
+        PERLIN_OCTAVES,
+        PERLIN_PERSISTENCE,
+        PERLIN_FREQUENCY,
+        useNoiseTable
+    };
+}
+
 TerrainGenerator::TerrainGenerator(const unsigned int seed)
     : mNoise { seed }
+    , mLatticeNoise { seed }
     , mRandomNumberGenerator { seed } {
     };
 
-void TerrainGenerator::generateTerrain(std::vector<std::vector<int>>& terrain, const TerrainGenerationConfig & config, const int averageNumberOfLandingPads)
+void TerrainGenerator::generateTerrain(TerrainHeightmap& terrain, const TerrainGenerationConfig & config, const int averageNumberOfLandingPads)
 {
     // Calculate landing pad probability once at the start
     mLandingPadProbability = static_cast<double>(averageNumberOfLandingPads) / static_cast<double>(config.worldWidth);
-    resizeTerrain(terrain, config);
+    terrain.resize(config.worldWidth, config.worldHeight);
+
+    // Pass 1 - serial, but only random draws: where the landing pads go, and so each rock column's noise coordinate
+    std::vector<size_t> noiseCoordinates {};
+    mLandingPads = placeLandingPads(config, noiseCoordinates);
+
+    // Passes 2 and 3
+    fillColumns(terrain, config, noiseCoordinates, mLandingPads);
+    mLandingPadIndex = LandingPadIndex::fromIntervals(terrain, mLandingPads);
+
+    std::cout << "World size x=" << terrain.getWidth() << " y=" << terrain.getHeight() << '\n';
+};
+
+void TerrainGenerator::generateChunk(TerrainHeightmap& terrain, const TerrainGenerationConfig & config, const std::vector<PadInterval>& pads, const size_t noiseOrigin) const
+{
+    terrain.resize(config.worldWidth, config.worldHeight);
+
+    // rock columns continue the noise from noiseOrigin, pad columns do not consume a coordinate
+    std::vector<size_t> noiseCoordinates(config.worldWidth, 0);
+    for (const auto& pad : pads)
+    {
+        std::fill_n(noiseCoordinates.begin() + static_cast<std::ptrdiff_t>(pad.start), pad.width, PAD_COLUMN);
+    }
+    size_t noiseX { noiseOrigin };
+    for (size_t& coordinate : noiseCoordinates)
+    {
+        if (coordinate != PAD_COLUMN)
+        {
+            coordinate = noiseX++;
+        }
+    }
+    fillColumns(terrain, config, noiseCoordinates, pads);
+};
+
+int TerrainGenerator::rockSurface(const TerrainGenerationConfig & config, const size_t noiseCoordinate) const
+{
+    int height { config.startHeight };
+    if constexpr (FIXED_POINT_PHYSICS)
+    {
+        height = latticeRockHeight(config, noiseCoordinate);
+    }
+    else
+    {
+        double noiseValue { mNoise.octaveNoise(static_cast<double>(noiseCoordinate), config.octaves, config.persistence, config.scale) };
+        height += static_cast<int>(noiseValue * config.heightVariation);
+    }
+    return std::clamp(static_cast<int>(config.worldHeight) - height + 1, 0, static_cast<int>(config.worldHeight));
+};
+
+std::vector<TerrainGenerator::PadInterval> TerrainGenerator::placeChunkLandingPads(const TerrainGenerationConfig & config, const size_t chunkIndex, const double landingPadProbability)
+{
+    // every chunk draws from its own generator, so its layout does not depend on which chunks were generated before it
+    std::seed_seq chunkSeed { config.seed, static_cast<unsigned int>(chunkIndex), static_cast<unsigned int>(static_cast<std::uint64_t>(chunkIndex) >> 32) };
+    std::mt19937 randomNumberGenerator { chunkSeed };
+
+    // pads never start in the first column or reach the last one, so the column
+    // a pad takes its height from is always inside the same chunk
+    std::vector<PadInterval> pads {};
+    size_t terrainX { 1 };
+    while (terrainX < config.worldWidth)
+    {
+        if (drawChance(randomNumberGenerator) < landingPadProbability && terrainX + MAX_LANDING_PAD_WIDTH < config.worldWidth)
+        {
+            size_t width { static_cast<size_t>(drawLandingPadWidth(randomNumberGenerator)) };
+            pads.push_back({ terrainX, width });
+            terrainX += width;
+        }
+        else
+        {
+            terrainX++;
+        }
+    }
+    return pads;
+};
+
+void TerrainGenerator::fillColumns(TerrainHeightmap& terrain, const TerrainGenerationConfig & config, const std::vector<size_t>& noiseCoordinates, const std::vector<PadInterval>& pads) const
+{
+    // Pass 2 - the noise based rock columns are independent of each other, so evaluate them in parallel
+    std::vector<int> heights(config.worldWidth, config.startHeight);
+    // whole heightmap blocks per thread, so no two threads set columns of the same block
+    constexpr size_t BLOCK_WIDTH { TerrainHeightmap::SURFACE_BLOCK_WIDTH };
+    constexpr size_t MIN_BLOCKS_PER_THREAD { 1024 / BLOCK_WIDTH };
+    size_t blocks { (config.worldWidth + BLOCK_WIDTH - 1) / BLOCK_WIDTH };
+    if constexpr (FIXED_POINT_PHYSICS)
+    {
+        // exact and cheap in integers, so there is no table to trade accuracy for and no batch to gather
+        parallelFor(0, blocks, [&](const size_t firstBlock, const size_t lastBlock) {
+            size_t end { std::min(lastBlock * BLOCK_WIDTH, config.worldWidth) };
+            for (size_t x = firstBlock * BLOCK_WIDTH; x < end; x++)
+            {
+                if (noiseCoordinates[x] != PAD_COLUMN)
+                {
+                    heights[x] = latticeRockHeight(config, noiseCoordinates[x]);
+                    fillTerrainUpToHeight(terrain, config, heights[x], x, TERRAIN_ROCK);
+                }
+            }
+        }, MIN_BLOCKS_PER_THREAD);
+    }
+    else
+    {
+        NoiseTable noiseTable {};
+        if (config.useNoiseTable)
+        {
+            // coordinates only increase, and no more of them than there are columns
+            auto firstRock { std::find_if(noiseCoordinates.begin(), noiseCoordinates.end(), [](const size_t coordinate) { return coordinate != PAD_COLUMN; }) };
+            double firstNoiseX { firstRock == noiseCoordinates.end() ? 0.0 : static_cast<double>(*firstRock) };
+            double lastNoiseX { firstNoiseX + static_cast<double>(config.worldWidth) };
+            noiseTable = NoiseTable(mNoise, config.octaves, config.persistence, config.scale, firstNoiseX, lastNoiseX);
+        }
+        parallelFor(0, blocks, [&](const size_t firstBlock, const size_t lastBlock) {
+            size_t begin { firstBlock * BLOCK_WIDTH };
+            size_t end { std::min(lastBlock * BLOCK_WIDTH, config.worldWidth) };
+            std::vector<size_t> columns {};
+            std::vector<double> samples {};
+            columns.reserve(end - begin);
+            samples.reserve(end - begin);
+            for (size_t x = begin; x < end; x++)
+            {
+                if (noiseCoordinates[x] != PAD_COLUMN)
+                {
+                    columns.push_back(x);
+                    samples.push_back(static_cast<double>(noiseCoordinates[x]));
+                }
+            }
+            std::vector<double> noiseValues(samples.size());
+            if (config.useNoiseTable)
+            {
+                std::transform(samples.begin(), samples.end(), noiseValues.begin(), [&](const double x) { return noiseTable.sample(x); });
+            }
+            else
+            {
+                mNoise.octaveNoiseBatch(samples.data(), noiseValues.data(), samples.size(), config.octaves, config.persistence, config.scale);
+            }
+
+            for (size_t i = 0; i < columns.size(); i++)
+            {
+                size_t x { columns[i] };
+                heights[x] = config.startHeight + static_cast<int>(noiseValues[i] * config.heightVariation);
+                fillTerrainUpToHeight(terrain, config, heights[x], x, TERRAIN_ROCK);
+            }
+        }, MIN_BLOCKS_PER_THREAD);
+    }
+
+    // Pass 3 - a landing pad continues at the height of the terrain to its left
+    for (const auto& pad : pads)
+    {
+        int padHeight { pad.start == 0 ? config.startHeight : heights[pad.start - 1] };
+        for (size_t x = pad.start; x != pad.start + pad.width; x++)
+        {
+            heights[x] = padHeight;
+            fillTerrainUpToHeight(terrain, config, padHeight, x, TERRAIN_LANDING_PAD);
+        }
+    }
+};
+
+std::vector<TerrainGenerator::PadInterval> TerrainGenerator::placeLandingPads(const TerrainGenerationConfig & config, std::vector<size_t>& noiseCoordinates)
+{
+    // This consumes the random number generator in exactly the order of a column by column walk,
+    // so a given seed always yields the same world however the noise work is later divided up
+    std::vector<PadInterval> pads {};
+    noiseCoordinates.assign(config.worldWidth, PAD_COLUMN);
 
     size_t noiseX = 0;      // Continuous noise coordinate
     size_t terrainX = 0;    // Current terrain position
-    int terrainHeight = config.startHeight; // Initialize with base height
-    
     while (terrainX < config.worldWidth) {
-        
+
         // randomly add a landing pad
         if (shouldAddLandingPad() && terrainX + MAX_LANDING_PAD_WIDTH < config.worldWidth) {
-            size_t padWidth = static_cast<size_t>(addLandingPad(terrain, config, terrainHeight, terrainX));
+            size_t padWidth = static_cast<size_t>(addLandingPad());
+            pads.push_back({ terrainX, padWidth });
             terrainX += padWidth;  // Skip ahead by pad width
-        
+
         // otherwise keep generating noise based terrain
         } else {
-            double noiseValue = mNoise.octaveNoise(noiseX, config.octaves, config.persistence, config.scale);
-            terrainHeight = config.startHeight + static_cast<int>(noiseValue * config.heightVariation);
-            fillTerrainUpToHeight(terrain, config, terrainHeight, terrainX, TERRAIN_ROCK);
+            noiseCoordinates[terrainX] = noiseX;
             terrainX++;
             noiseX++;  // Only increment noise coordinate when we use a noise value - for continuous height on either side of a pad
         }
     }
-    
-    std::cout << "World size x=" << terrain[0].size() << " y=" << terrain.size() << '\n';
+    return pads;
 };
 
-void TerrainGenerator::resizeTerrain(std::vector<std::vector<int>>& terrain, const TerrainGenerationConfig & config) const
+void TerrainGenerator::generateTerrain(TerrainGrid& terrain, const TerrainGenerationConfig & config, const int averageNumberOfLandingPads)
 {
-    terrain = std::vector<std::vector<int>> {};
-    terrain.resize(config.worldHeight);
-    for (size_t y = 0; y < config.worldHeight; y++)
-    {
-        terrain[y].resize(config.worldWidth, TERRAIN_VACUUM);
-    }
+    TerrainHeightmap heightmap {};
+    generateTerrain(heightmap, config, averageNumberOfLandingPads);
+    heightmap.rasterize(terrain);
 };
 
-int TerrainGenerator::addLandingPad(std::vector<std::vector<int>>& terrain, const TerrainGenerationConfig & config, const int height, const size_t xPos)
+int TerrainGenerator::addLandingPad()
 {
-    std::uniform_int_distribution<int> dist(MIN_LANDING_PAD_WIDTH, MAX_LANDING_PAD_WIDTH);
-    size_t padLength = static_cast<size_t>(dist(mRandomNumberGenerator));
-    
-    for (size_t i = 0; i != padLength; i++)
-    {
-        fillTerrainUpToHeight(terrain, config, height, xPos + i, TERRAIN_LANDING_PAD);
-    };
-    return static_cast<int>(padLength);
+    return drawLandingPadWidth(mRandomNumberGenerator);
 };
 
-void TerrainGenerator::fillTerrainUpToHeight(std::vector<std::vector<int>>& terrain, const TerrainGenerationConfig & config, const int height, const size_t xPos, const int terrainValue)
+void TerrainGenerator::fillTerrainUpToHeight(TerrainHeightmap& terrain, const TerrainGenerationConfig & config, const int height, const size_t xPos, const TerrainCell terrainValue) const
 {
-    for (size_t y = config.worldHeight - 1; y > config.worldHeight - static_cast<size_t>(height); y--)
-    {
-        terrain[y][xPos] = terrainValue;
-    }
+    // the column is solid for the rows below worldHeight - height
+    int surface { static_cast<int>(config.worldHeight) - height + 1 };
+    terrain.setColumn(xPos, surface, terrainValue == TERRAIN_LANDING_PAD);
+};
+
+int TerrainGenerator::latticeRockHeight(const TerrainGenerationConfig & config, const size_t noiseCoordinate) const
+{
+    std::int64_t noiseValue { mLatticeNoise.octaveNoise(noiseCoordinate, config.octaves, config.persistence, config.scale) };
+    // truncated towards zero like the cast of the double noise
+    return config.startHeight + static_cast<int>(noiseValue * config.heightVariation / LatticeNoise1D::ONE);
 };
 
 bool TerrainGenerator::shouldAddLandingPad()
 {
     // Generate random number between 0.0 and 1.0
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    double randomValue = dist(mRandomNumberGenerator);
+    double randomValue = drawChance(mRandomNumberGenerator);
     
     // Return true if random value is less than probability
     return randomValue < mLandingPadProbability;
 };
 
-void TerrainGenerator::createTerrainTexture(SDL_Renderer* renderer, Texture* targetTexture, const std::vector<std::vector<int>>& terrain) const
+void TerrainGenerator::rasterizeTerrainPixels(const TerrainHeightmap& terrain, std::vector<std::uint32_t>& pixels)
 {
-    // Set the passed texture as render target
-    targetTexture->setAsRenderingTarget();
+    size_t width { terrain.getWidth() };
+    size_t height { terrain.getHeight() };
 
-    // determine which points are foreground, terrain, or background
-    std::vector<SDL_Point> foregroundPoints {}; // these are opaque black
-    std::vector<SDL_Point> terrainPoints {}; // these are opaque white
-    for (size_t x = 0; x < terrain[0].size(); x++)
+    // every pixel is written exactly once below, so a reused buffer is not cleared first
+    pixels.resize(width * height);
+    if (width == 0 || height == 0)
     {
-        bool reachedForeground = false;
-        for (size_t y = 0; y < terrain.size(); y++)
-        {
-            SDL_Point point { static_cast<int>(x), static_cast<int>(y) };
-            if (terrain[y][x] == TERRAIN_ROCK || terrain[y][x] == TERRAIN_LANDING_PAD)
-            {
-                if (!reachedForeground)
-                {
-                    terrainPoints.push_back(point);
-                    reachedForeground = true;
-                    
-                    // Add extra thickness for landing pads (one pixel below, every other column)
-                    if (terrain[y][x] == TERRAIN_LANDING_PAD && y + 1 < terrain.size() && x % 2 == 0)
-                    {
-                        SDL_Point thickPoint { static_cast<int>(x), static_cast<int>(y + 1) };
-                        terrainPoints.push_back(thickPoint);
-                    }
-                }
-                else
-                {
-                    foregroundPoints.push_back(point);
-                }
-            }
-        }
+        return;
     }
 
-    // fill the target texture with a transparent base (so that the background will show through it)
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-    SDL_RenderClear(renderer);
+    // Every column is transparent above its surface, has a white horizon pixel at the surface
+    // (two for every other landing pad column) and is opaque black below that
+    const int* surface { terrain.surfaceData() };
+    const std::uint8_t* landingPad { terrain.landingPadData() };
+    size_t firstRow { static_cast<size_t>(*std::min_element(surface, surface + width)) };
+    size_t lastRow { std::min(static_cast<size_t>(*std::max_element(surface, surface + width)) + 2, height) };
 
-    // set the foregound pixels to opaque black
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderDrawPoints(renderer, foregroundPoints.data(), static_cast<int>(foregroundPoints.size()));
-
-    // set the terrain horizon line to opaque white
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawPoints(renderer, terrainPoints.data(), static_cast<int>(terrainPoints.size()));
+    // the lowest row of the horizon for each column
+    std::vector<int> horizonEnd(width);
+    for (size_t x = 0; x < width; x++)
+    {
+        horizonEnd[x] = surface[x] + ((landingPad[x] && x % 2 == 0) ? 1 : 0);
+    }
 
-    // return the render target to the screen itself
-    SDL_SetRenderTarget(renderer, nullptr);
-}
\ No newline at end of file
+    // rows are independent and contiguous, so fill them in parallel blocks
+    parallelFor(0, height, [&](const size_t begin, const size_t end) {
+        for (size_t y = begin; y < end; y++)
+        {
+            std::uint32_t* row { pixels.data() + y * width };
+            if (y < firstRow || y >= lastRow)
+            {
+                // above the highest surface everything is transparent, below the lowest horizon everything is foreground
+                std::fill(row, row + width, y < firstRow ? PIXEL_TRANSPARENT : PIXEL_FOREGROUND);
+                continue;
+            }
+            int rowY { static_cast<int>(y) };
+            for (size_t x = 0; x < width; x++)
+            {
+                std::uint32_t solid { rowY > horizonEnd[x] ? PIXEL_FOREGROUND : PIXEL_HORIZON };
+                row[x] = rowY < surface[x] ? PIXEL_TRANSPARENT : solid;
+            }
+        }
+    }, 16);
+}
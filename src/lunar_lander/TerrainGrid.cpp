@@ -0,0 +1,153 @@
+#include "lunar_lander/TerrainGrid.h"
+#include "engine/ParallelFor.h"
+#include <algorithm>
+#include <bitset>
+
+TerrainGrid::TerrainGrid()
+    : mWidth { 0 }
+    , mHeight { 0 }
+    , mRowStride { 0 }
+    , mCells {}
+    , mPyramid {}
+{
+}
+
+TerrainGrid::TerrainGrid(const size_t width, const size_t height)
+    : TerrainGrid()
+{
+    resize(width, height);
+}
+
+size_t TerrainGrid::getMemoryFootprint() const
+{
+    return mCells.size() * sizeof(std::uint64_t);
+}
+
+void TerrainGrid::resize(const size_t width, const size_t height)
+{
+    mWidth = width;
+    mHeight = height;
+    mRowStride = (width + CELLS_PER_WORD - 1) / CELLS_PER_WORD;
+
+    // vacuum is zero, so a zeroed buffer is an empty world
+    mCells.assign(mRowStride * mHeight, 0);
+
+    // and an empty world has nothing to count
+    mPyramid.clear();
+    size_t levelWidth { (width + PYRAMID_BLOCK - 1) / PYRAMID_BLOCK };
+    size_t levelHeight { (height + PYRAMID_BLOCK - 1) / PYRAMID_BLOCK };
+    while (levelWidth > 0 && levelHeight > 0)
+    {
+        mPyramid.push_back({ levelWidth, levelHeight, std::vector<std::uint32_t>(levelWidth * levelHeight, 0) });
+        if (levelWidth == 1 && levelHeight == 1)
+        {
+            break;
+        }
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+}
+
+bool TerrainGrid::isVacuum(const size_t x, const size_t y, const size_t width, const size_t height) const
+{
+    if (x >= mWidth || y >= mHeight || width == 0 || height == 0)
+    {
+        return true;
+    }
+
+    // start from the finest level whose blocks are at least as large as the rectangle,
+    // where it overlaps no more than 2 x 2 blocks
+    size_t level { 0 };
+    while (level + 1 < mPyramid.size() && (PYRAMID_BLOCK << level) < std::max(width, height))
+    {
+        level++;
+    }
+    return isVacuum(level, x, y, std::min(x + width, mWidth), std::min(y + height, mHeight));
+}
+
+bool TerrainGrid::isVacuum(const size_t level, const size_t x, const size_t y, const size_t right, const size_t bottom) const
+{
+    const PyramidLevel& blocks { mPyramid[level] };
+    size_t side { PYRAMID_BLOCK << level };
+    for (size_t blockY = y / side; blockY <= (bottom - 1) / side; blockY++)
+    {
+        for (size_t blockX = x / side; blockX <= (right - 1) / side; blockX++)
+        {
+            if (blocks.counts[blockY * blocks.width + blockX] == 0)
+            {
+                continue;
+            }
+            if (level == 0)
+            {
+                return false;
+            }
+
+            // look again at the part of the rectangle in this block, one level down
+            if (!isVacuum(level - 1,
+                    std::max(x, blockX * side),
+                    std::max(y, blockY * side),
+                    std::min(right, (blockX + 1) * side),
+                    std::min(bottom, (blockY + 1) * side)))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void TerrainGrid::rebuildPyramid()
+{
+    if (mPyramid.empty())
+    {
+        return;
+    }
+
+    // level 0 from the cells, each block row of cells on its own
+    constexpr size_t BLOCKS_PER_WORD { CELLS_PER_WORD / PYRAMID_BLOCK };
+    constexpr std::uint64_t BLOCK_BITS { (std::uint64_t { 1 } << (PYRAMID_BLOCK * BITS_PER_CELL)) - 1 };
+    PyramidLevel& base { mPyramid[0] };
+    parallelFor(0, base.height, [&](const size_t begin, const size_t end) {
+        for (size_t blockY = begin; blockY < end; blockY++)
+        {
+            std::uint32_t* counts { base.counts.data() + blockY * base.width };
+            std::fill(counts, counts + base.width, 0);
+            for (size_t y = blockY * PYRAMID_BLOCK; y < std::min((blockY + 1) * PYRAMID_BLOCK, mHeight); y++)
+            {
+                const std::uint64_t* row { rowData(y) };
+                for (size_t word = 0; word < mRowStride; word++)
+                {
+                    // one bit per solid cell, padding cells are vacuum
+                    std::uint64_t solid { (row[word] | (row[word] >> 1)) & LOW_CELL_BITS };
+                    for (size_t block = 0; block < BLOCKS_PER_WORD && word * BLOCKS_PER_WORD + block < base.width; block++)
+                    {
+                        std::uint64_t cells { (solid >> (block * PYRAMID_BLOCK * BITS_PER_CELL)) & BLOCK_BITS };
+                        counts[word * BLOCKS_PER_WORD + block] += static_cast<std::uint32_t>(std::bitset<64>(cells).count());
+                    }
+                }
+            }
+        }
+    }, 16);
+
+    // then every level from the one below
+    for (size_t level = 1; level < mPyramid.size(); level++)
+    {
+        const PyramidLevel& below { mPyramid[level - 1] };
+        PyramidLevel& blocks { mPyramid[level] };
+        for (size_t blockY = 0; blockY < blocks.height; blockY++)
+        {
+            for (size_t blockX = 0; blockX < blocks.width; blockX++)
+            {
+                std::uint32_t count { 0 };
+                for (size_t childY = blockY * 2; childY < std::min(blockY * 2 + 2, below.height); childY++)
+                {
+                    for (size_t childX = blockX * 2; childX < std::min(blockX * 2 + 2, below.width); childX++)
+                    {
+                        count += below.counts[childY * below.width + childX];
+                    }
+                }
+                blocks.counts[blockY * blocks.width + blockX] = count;
+            }
+        }
+    }
+}
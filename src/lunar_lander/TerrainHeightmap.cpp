@@ -0,0 +1,133 @@
+#include "lunar_lander/TerrainHeightmap.h"
+#include "lunar_lander/Constants.h"
+#include "engine/ParallelFor.h"
+#include <algorithm>
+#include <cassert>
+
+TerrainHeightmap::TerrainHeightmap()
+    : mWidth { 0 }
+    , mHeight { 0 }
+    , mSurface {}
+    , mLandingPad {}
+    , mBlockMinSurface {}
+{
+}
+
+TerrainHeightmap::TerrainHeightmap(const size_t width, const size_t height)
+    : TerrainHeightmap()
+{
+    resize(width, height);
+}
+
+size_t TerrainHeightmap::getMemoryFootprint() const
+{
+    return (mSurface.size() + mBlockMinSurface.size()) * sizeof(int) + mLandingPad.size() * sizeof(std::uint8_t);
+}
+
+void TerrainHeightmap::resize(const size_t width, const size_t height)
+{
+    mWidth = width;
+    mHeight = height;
+    mSurface.assign(width, static_cast<int>(height));
+    mLandingPad.assign(width, 0);
+    mBlockMinSurface.assign((width + SURFACE_BLOCK_WIDTH - 1) / SURFACE_BLOCK_WIDTH, static_cast<int>(height));
+}
+
+TerrainCell TerrainHeightmap::getColumnType(const size_t x) const
+{
+    return isLandingPad(x) ? TERRAIN_LANDING_PAD : TERRAIN_ROCK;
+}
+
+int TerrainHeightmap::getMinSurface() const
+{
+    return mBlockMinSurface.empty() ? static_cast<int>(mHeight) : *std::min_element(mBlockMinSurface.begin(), mBlockMinSurface.end());
+}
+
+int TerrainHeightmap::getMinSurface(const size_t begin, const size_t end) const
+{
+    int minSurface { static_cast<int>(mHeight) };
+    size_t x { begin };
+    size_t last { std::min(end, mWidth) };
+    while (x < last)
+    {
+        size_t block { x / SURFACE_BLOCK_WIDTH };
+        size_t blockEnd { std::min((block + 1) * SURFACE_BLOCK_WIDTH, last) };
+        if (x % SURFACE_BLOCK_WIDTH == 0 && (blockEnd % SURFACE_BLOCK_WIDTH == 0 || blockEnd == mWidth))
+        {
+            minSurface = std::min(minSurface, mBlockMinSurface[block]);
+        }
+        else
+        {
+            minSurface = std::min(minSurface, *std::min_element(mSurface.begin() + static_cast<std::ptrdiff_t>(x), mSurface.begin() + static_cast<std::ptrdiff_t>(blockEnd)));
+        }
+        x = blockEnd;
+    }
+    return minSurface;
+}
+
+void TerrainHeightmap::setColumn(const size_t x, const int surface, const bool landingPad)
+{
+    assert(x < mWidth);
+    int previous { mSurface[x] };
+    mSurface[x] = std::clamp(surface, 0, static_cast<int>(mHeight));
+    mLandingPad[x] = landingPad ? 1 : 0;
+
+    // raising the block is immediate, lowering the column that held it up means a rescan of the block
+    int& blockMin { mBlockMinSurface[x / SURFACE_BLOCK_WIDTH] };
+    if (mSurface[x] <= blockMin)
+    {
+        blockMin = mSurface[x];
+    }
+    else if (previous == blockMin)
+    {
+        size_t begin { x / SURFACE_BLOCK_WIDTH * SURFACE_BLOCK_WIDTH };
+        size_t end { std::min(begin + SURFACE_BLOCK_WIDTH, mWidth) };
+        blockMin = *std::min_element(mSurface.begin() + static_cast<std::ptrdiff_t>(begin), mSurface.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+}
+
+void TerrainHeightmap::rasterize(TerrainGrid& grid) const
+{
+    grid.resize(mWidth, mHeight);
+    if (mWidth == 0 || mHeight == 0)
+    {
+        return;
+    }
+
+    // rows above the highest surface are already vacuum, and every row
+    // below the lowest surface is identical to the lowest surface row
+    size_t firstRow { static_cast<size_t>(*std::min_element(mSurface.begin(), mSurface.end())) };
+    size_t lastRow { std::min(static_cast<size_t>(*std::max_element(mSurface.begin(), mSurface.end())), mHeight - 1) };
+
+    // fill row by row so that every write is to consecutive words, blocks of rows in parallel
+    parallelFor(firstRow, lastRow + 1, [&](const size_t begin, const size_t end) {
+        for (size_t y = begin; y < end; y++)
+        {
+            std::uint64_t* row { grid.rowData(y) };
+            for (size_t word = 0; word < grid.getRowStride(); word++)
+            {
+                size_t xStart { word * TerrainGrid::CELLS_PER_WORD };
+                size_t xEnd { std::min(xStart + TerrainGrid::CELLS_PER_WORD, mWidth) };
+                std::uint64_t bits { 0 };
+                for (size_t x = xStart; x < xEnd; x++)
+                {
+                    // a rock cell is 1 and a landing pad cell is 2
+                    std::uint64_t cell { static_cast<std::uint64_t>(TERRAIN_ROCK + mLandingPad[x]) };
+                    std::uint64_t solid { static_cast<std::uint64_t>(static_cast<int>(y) >= mSurface[x]) };
+                    bits |= (cell * solid) << ((x - xStart) * TerrainGrid::BITS_PER_CELL);
+                }
+                row[word] = bits;
+            }
+        }
+    }, 16);
+
+    // then replicate the lowest surface row in contiguous spans down to the bottom of the world
+    const std::uint64_t* source { grid.rowData(lastRow) };
+    parallelFor(lastRow + 1, mHeight, [&](const size_t begin, const size_t end) {
+        for (size_t y = begin; y < end; y++)
+        {
+            std::copy_n(source, grid.getRowStride(), grid.rowData(y));
+        }
+    }, 64);
+    grid.rebuildPyramid();
+}
@@ -0,0 +1,91 @@
+#include "lunar_lander/TerrainTextures.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <algorithm>
+
+TerrainTextures::TerrainTextures()
+    : TerrainTextures(nullptr)
+{
+}
+
+TerrainTextures::TerrainTextures(SDL_Renderer* renderer)
+    : mRenderer { renderer }
+    , mWorld {}
+    , mChunks {}
+    , mChunkWidth { 0 }
+    , mPixels {}
+{
+}
+
+bool TerrainTextures::create(const TerrainHeightmap& terrain)
+{
+    mChunks.clear();
+    mWorld = std::make_unique<TiledTexture>(mRenderer);
+    return upload(*mWorld, terrain);
+}
+
+bool TerrainTextures::update(const ChunkManager& chunks)
+{
+    bool success { true };
+    mWorld.reset();
+    mChunkWidth = static_cast<int>(chunks.getChunkWidth());
+    for (auto texture = mChunks.begin(); texture != mChunks.end();)
+    {
+        texture = chunks.findChunk(texture->first) == nullptr ? mChunks.erase(texture) : std::next(texture);
+    }
+
+    // a chunk is the same whenever it is generated, so one that came back after eviction looks as before
+    chunks.forEachResidentChunk([&](const TerrainChunk& chunk) {
+        auto texture { mChunks.find(chunk.index) };
+        if (texture == mChunks.end())
+        {
+            auto created { std::make_unique<TiledTexture>(mRenderer) };
+            if (upload(*created, chunk.terrain))
+            {
+                mChunks.emplace(chunk.index, std::move(created));
+            }
+            else
+            {
+                success = false;
+            }
+        }
+    });
+    return success;
+}
+
+void TerrainTextures::render(const Rect& view)
+{
+    if (mWorld)
+    {
+        mWorld->render(SDL_Rect { view.x, view.y, view.w, view.h });
+        return;
+    }
+    if (mChunkWidth == 0)
+    {
+        return;
+    }
+
+    int first { std::max(view.x, 0) / mChunkWidth };
+    int last { (view.x + view.w - 1) / mChunkWidth };
+    for (int i = first; i <= last; i++)
+    {
+        auto texture { mChunks.find(static_cast<size_t>(i)) };
+        if (texture != mChunks.end())
+        {
+            // the same view, in the chunk's own coordinates
+            SDL_Rect chunkView { view.x - i * mChunkWidth, view.y, view.w, view.h };
+            texture->second->render(chunkView);
+        }
+    }
+}
+
+bool TerrainTextures::upload(TiledTexture& texture, const TerrainHeightmap& terrain)
+{
+    // build the image on the CPU and upload it to the texture in one go
+    int width { static_cast<int>(terrain.getWidth()) };
+    if (!texture.create(width, static_cast<int>(terrain.getHeight())))
+    {
+        return false;
+    }
+    TerrainGenerator::rasterizeTerrainPixels(terrain, mPixels);
+    return texture.updatePixels(mPixels.data(), width * static_cast<int>(sizeof(std::uint32_t)));
+}
@@ -0,0 +1,22 @@
+#ifndef TESTWORLDS_H
+#define TESTWORLDS_H
+
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LanderSimulation.h"
+#include "lunar_lander/TerrainGenerator.h"
+
+// The game's terrain settings for a world of the given seed and width, from the exact noise
+inline TerrainGenerationConfig makeTestWorldConfig(const unsigned int seed, const size_t worldWidth)
+{
+    return makeWorldConfig(seed, worldWidth, false);
+}
+
+// That world generated whole with the game's sprite sizes, no window, renderer or textures anywhere
+inline LanderSimulation makeTestSimulation(const unsigned int seed, const size_t worldWidth, const int landingPads)
+{
+    LanderSimulation simulation { SPACESHIP_WIDTH, SPACESHIP_HEIGHT, SPACESTATION_WIDTH, SPACESTATION_HEIGHT };
+    simulation.createWorld(makeTestWorldConfig(seed, worldWidth), landingPads);
+    return simulation;
+}
+
+#endif // TESTWORLDS_H
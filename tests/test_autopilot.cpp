@@ -0,0 +1,108 @@
+#include "TestWorlds.h"
+#include "lunar_lander/Autopilot.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LanderSimulation.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+LanderSimulation makeSimulation(const unsigned int seed)
+{
+    return makeTestSimulation(seed, static_cast<size_t>(WORLD_WIDTH), WORLD_WIDTH / SCREEN_WIDTH);
+}
+
+// a budget no search runs out of, so every decision looks the whole horizon ahead
+Autopilot makeAutopilot(const size_t beamWidth, const int horizon)
+{
+    return Autopilot { SPACESHIP_WIDTH, SPACESHIP_HEIGHT, AutopilotConfig { beamWidth, horizon, 10, 1.0e6 } };
+}
+}
+
+TEST(AutopilotTest, TestSearchKeepsTheBeam)
+{
+    LanderSimulation simulation { makeSimulation(1) };
+    Autopilot autopilot { makeAutopilot(8, 5) };
+    autopilot.decide(simulation);
+
+    // six children of the one ship, six of each of those six, then six of each of the eight kept
+    const AutopilotStats& stats { autopilot.getStats() };
+    EXPECT_EQ(stats.decisions, 1u);
+    EXPECT_EQ(stats.lastDepth, 5);
+    EXPECT_EQ(stats.nodes, 6u + 6u * 6u + 3u * 8u * 6u);
+    EXPECT_GT(stats.seconds, 0.0);
+    EXPECT_GT(stats.getNodesPerSecond(), 0.0);
+
+    autopilot.resetStats();
+    EXPECT_EQ(autopilot.getStats().nodes, 0u);
+}
+
+TEST(AutopilotTest, TestBudgetCutsTheSearchShort)
+{
+    LanderSimulation simulation { makeSimulation(1) };
+    Autopilot autopilot { SPACESHIP_WIDTH, SPACESHIP_HEIGHT, AutopilotConfig { 32, 1000, 10, 0.0 } };
+    autopilot.decide(simulation);
+    // the first decision is always looked at, so there is a plan to fly
+    EXPECT_EQ(autopilot.getStats().lastDepth, 1);
+    EXPECT_EQ(autopilot.getStats().nodes, 6u);
+}
+
+TEST(AutopilotTest, TestInputsAreHeldBetweenDecisions)
+{
+    LanderSimulation simulation { makeSimulation(1) };
+    Autopilot autopilot { makeAutopilot(4, 2) };
+    ShipInput held { autopilot.control(simulation) };
+    for (int step = 1; step < 10; step++)
+    {
+        simulation.step(held);
+        ShipInput input { autopilot.control(simulation) };
+        EXPECT_EQ(input.turn, held.turn) << "step " << step;
+        EXPECT_EQ(input.thrust, held.thrust) << "step " << step;
+    }
+    EXPECT_EQ(autopilot.getStats().decisions, 1u);
+    autopilot.control(simulation);
+    EXPECT_EQ(autopilot.getStats().decisions, 2u);
+}
+
+TEST(AutopilotTest, TestResetDecidesAgainAfterARewind)
+{
+    LanderSimulation simulation { makeSimulation(1) };
+    Autopilot autopilot { makeAutopilot(4, 2) };
+    LanderSimulation::Snapshot start { simulation.saveState() };
+    for (int step = 0; step < 4; step++)
+    {
+        simulation.step(autopilot.control(simulation));
+    }
+    ASSERT_EQ(autopilot.getStats().decisions, 1u);
+
+    // rewound in the middle of holding an input, the flight is planned again from where it now is
+    ASSERT_TRUE(simulation.restoreState(start));
+    autopilot.reset();
+    autopilot.control(simulation);
+    EXPECT_EQ(autopilot.getStats().decisions, 2u);
+    for (int step = 1; step < 10; step++)
+    {
+        autopilot.control(simulation);
+    }
+    EXPECT_EQ(autopilot.getStats().decisions, 2u);
+}
+
+TEST(AutopilotTest, TestLandsOnMostPads)
+{
+    // Seeds 1 to 8 with the game's settings. Landing is not guaranteed: in float builds the ship comes to rest
+    // against the space station above seed 6's pad and stays there until the time runs out. It never crashes
+    constexpr unsigned int SEEDS { 8 };
+    constexpr int MAX_STEPS { 30 * 60 };
+    unsigned int landed { 0 };
+    for (unsigned int seed = 1; seed <= SEEDS; seed++)
+    {
+        LanderSimulation simulation { makeSimulation(seed) };
+        Autopilot autopilot { makeAutopilot(AUTOPILOT_BEAM_WIDTH, AUTOPILOT_HORIZON) };
+        for (int step = 0; step < MAX_STEPS && !simulation.isCrashed() && !simulation.isLanded(); step++)
+        {
+            simulation.step(autopilot.control(simulation));
+        }
+        EXPECT_FALSE(simulation.isCrashed()) << "seed " << seed;
+        landed += simulation.isLanded() ? 1u : 0u;
+    }
+    EXPECT_GE(landed, SEEDS - 1);
+}
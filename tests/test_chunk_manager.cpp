@@ -0,0 +1,163 @@
+#include "TestWorlds.h"
+#include "lunar_lander/ChunkManager.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LatticeNoise1D.h"
+#include "lunar_lander/PhysicsScalar.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr size_t CHUNK_WIDTH { 512 };
+}
+
+TEST(ChunkManagerTest, TestChunksDoNotDependOnGenerationOrder)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(3, CHUNK_WIDTH * 6) };
+    ChunkManager forward { config, 12, CHUNK_WIDTH, 6 };
+    ChunkManager backward { config, 12, CHUNK_WIDTH, 6 };
+    for (size_t i = 0; i < forward.getChunkCount(); i++)
+    {
+        forward.requireChunk(i);
+        backward.requireChunk(backward.getChunkCount() - 1 - i);
+    }
+
+    for (size_t x = 0; x < forward.getWidth(); x++)
+    {
+        ASSERT_EQ(forward.getSurface(x), backward.getSurface(x)) << "x=" << x;
+        ASSERT_EQ(forward.isLandingPad(x), backward.isLandingPad(x)) << "x=" << x;
+    }
+}
+
+TEST(ChunkManagerTest, TestNoiseContinuesAcrossChunks)
+{
+    // the whole world walked column by column, with the chunks' pad layouts
+    TerrainGenerationConfig config { makeTestWorldConfig(3, CHUNK_WIDTH * 6) };
+    ChunkManager chunks { config, 12, CHUNK_WIDTH, 6 };
+    PerlinNoise1D noise { config.seed };
+    LatticeNoise1D latticeNoise { config.seed };
+
+    size_t noiseX { 0 };
+    size_t padColumns { 0 };
+    int height { config.startHeight };
+    for (size_t i = 0; i < chunks.getChunkCount(); i++)
+    {
+        const TerrainChunk& chunk { chunks.requireChunk(i) };
+        const auto& pads { chunks.getLandingPads(i) };
+        size_t pad { 0 };
+        for (size_t x = 0; x < CHUNK_WIDTH; x++)
+        {
+            bool isPad { pad < pads.size() && x >= pads[pad].start && x < pads[pad].start + pads[pad].width };
+            if (!isPad)
+            {
+                // fixed point builds generate from the lattice noise
+                if (FIXED_POINT_PHYSICS)
+                {
+                    std::int64_t value { latticeNoise.octaveNoise(noiseX++, config.octaves, config.persistence, config.scale) };
+                    height = config.startHeight + static_cast<int>(value * config.heightVariation / LatticeNoise1D::ONE);
+                }
+                else
+                {
+                    double value { noise.octaveNoise(static_cast<double>(noiseX++), config.octaves, config.persistence, config.scale) };
+                    height = config.startHeight + static_cast<int>(value * config.heightVariation);
+                }
+            }
+            if (pad < pads.size() && x + 1 == pads[pad].start + pads[pad].width)
+            {
+                pad++;
+            }
+            padColumns += isPad;
+            ASSERT_EQ(chunk.terrain.getSurface(x), static_cast<int>(config.worldHeight) - height + 1) << "chunk=" << i << " x=" << x;
+            ASSERT_EQ(chunk.terrain.isLandingPad(x), isPad) << "chunk=" << i << " x=" << x;
+        }
+    }
+    EXPECT_GT(padColumns, 0u);
+}
+
+TEST(ChunkManagerTest, TestWorldEndsPartWayThroughLastChunk)
+{
+    for (unsigned int seed = 1; seed <= 20; seed++)
+    {
+        TerrainGenerationConfig config { makeTestWorldConfig(seed, 1000) };
+        ChunkManager chunks { config, 4, CHUNK_WIDTH, 2 };
+        chunks.requireChunk(0);
+        chunks.requireChunk(1);
+        ASSERT_EQ(chunks.getWidth(), 1000u);
+        ASSERT_EQ(chunks.getChunkCount(), 2u);
+
+        for (size_t x = chunks.getWidth(); x < CHUNK_WIDTH * 2; x++)
+        {
+            ASSERT_EQ(chunks.getSurface(x), static_cast<int>(config.worldHeight)) << "seed=" << seed << " x=" << x;
+            ASSERT_FALSE(chunks.isLandingPad(x)) << "seed=" << seed << " x=" << x;
+        }
+        for (const LandingPad& pad : chunks.getLandingPadIndex().getPads())
+        {
+            ASSERT_LE(pad.end(), chunks.getWidth()) << "seed=" << seed;
+        }
+
+        // the block holding the world's edge only counts the columns inside the world
+        int expected { static_cast<int>(config.worldHeight) };
+        for (size_t x = 960; x < chunks.getWidth(); x++)
+        {
+            expected = std::min(expected, chunks.getSurface(x));
+        }
+        ASSERT_EQ(chunks.getMinSurface(960, 1024), expected) << "seed=" << seed;
+
+        // so a ray just below the highest of those columns is not skipped past them
+        float y { static_cast<float>(expected) + 0.5f };
+        RayHit hit { TerrainQuery(chunks).raycast(Vector2D { 960.5f, y }, Vector2D { 1.0f, 0.0f }, 100.0f) };
+        ASSERT_TRUE(hit.hit) << "seed=" << seed;
+        EXPECT_LE(static_cast<float>(chunks.getSurface(hit.column)), y) << "seed=" << seed;
+    }
+}
+
+TEST(ChunkManagerTest, TestUpdateKeepsViewResidentWithinBudget)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(3, CHUNK_WIDTH * 40) };
+    ChunkManager chunks { config, 40, CHUNK_WIDTH, 8 };
+    Rect view { 0, 0, 700, 400 };
+
+    // fly right across the whole world
+    for (; view.x + view.w <= static_cast<int>(chunks.getWidth()); view.x += 64)
+    {
+        chunks.update(view, 8.0f);
+        EXPECT_LE(chunks.getResidentChunkCount(), 8u);
+        for (int x = view.x; x < view.x + view.w; x += 64)
+        {
+            EXPECT_NE(chunks.findChunk(static_cast<size_t>(x) / CHUNK_WIDTH), nullptr) << "x=" << x;
+        }
+    }
+
+    // long since evicted
+    EXPECT_EQ(chunks.findChunk(0), nullptr);
+    EXPECT_LT(chunks.getGeneratedChunkCount(), 2 * chunks.getChunkCount());
+}
+
+TEST(ChunkManagerTest, TestUpdatePrefetchesAlongVelocity)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(3, CHUNK_WIDTH * 40) };
+    Rect view { static_cast<int>(CHUNK_WIDTH) * 20, 0, 100, 100 };
+
+    ChunkManager movingLeft { config, 40, CHUNK_WIDTH, 10 };
+    for (int i = 0; i < 8; i++)
+    {
+        movingLeft.update(view, -10.0f);
+    }
+    EXPECT_NE(movingLeft.findChunk(17), nullptr);
+    EXPECT_EQ(movingLeft.findChunk(23), nullptr);
+
+    // generation is spread out, one chunk ahead per update
+    ChunkManager movingRight { config, 40, CHUNK_WIDTH, 10 };
+    movingRight.update(view, 10.0f);
+    EXPECT_EQ(movingRight.getGeneratedChunkCount(), 2u);
+    movingRight.update(view, 10.0f);
+    EXPECT_EQ(movingRight.getGeneratedChunkCount(), 3u);
+    for (int i = 0; i < 8; i++)
+    {
+        movingRight.update(view, 10.0f);
+    }
+    EXPECT_NE(movingRight.findChunk(23), nullptr);
+    EXPECT_EQ(movingRight.findChunk(17), nullptr);
+}
@@ -0,0 +1,97 @@
+#include "engine/Fixed.h"
+#include "engine/Vector2D.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+
+TEST(FixedTest, TestArithmetic)
+{
+    Fixed a { 3 };
+    Fixed b { 0.5 };
+    EXPECT_EQ(a + b, Fixed { 3.5 });
+    EXPECT_EQ(a - b, Fixed { 2.5 });
+    EXPECT_EQ(a * b, Fixed { 1.5 });
+    EXPECT_EQ(a / b, Fixed { 6 });
+    EXPECT_EQ(-a, Fixed { -3 });
+    EXPECT_LT(b, a);
+    EXPECT_EQ(Fixed::fromRaw(Fixed::ONE), Fixed { 1 });
+}
+
+TEST(FixedTest, TestRounding)
+{
+    // products round down, quotients towards zero
+    Fixed tiny { Fixed::fromRaw(1) };
+    EXPECT_EQ(tiny * Fixed { 0.5 }, Fixed {});
+    EXPECT_EQ(-tiny * Fixed { 0.5 }, -tiny);
+    EXPECT_EQ(Fixed { 1 } / Fixed { 3 }, Fixed::fromRaw(Fixed::ONE / 3));
+    EXPECT_EQ(Fixed { -1 } / Fixed { 3 }, Fixed::fromRaw(-Fixed::ONE / 3));
+
+    // doubles round to the nearest step either side of zero
+    EXPECT_EQ(Fixed { 0.6 / Fixed::ONE }, tiny);
+    EXPECT_EQ(Fixed { -0.6 / Fixed::ONE }, -tiny);
+}
+
+TEST(FixedTest, TestSqrt)
+{
+    EXPECT_EQ(sqrt(Fixed { 4 }), Fixed { 2 });
+    EXPECT_EQ(sqrt(Fixed { 0.25 }), Fixed { 0.5 });
+    EXPECT_EQ(sqrt(Fixed {}), Fixed {});
+    EXPECT_EQ(sqrt(Fixed { -1 }), Fixed {});
+    EXPECT_NEAR(toFloat(sqrt(Fixed { 2 })), 1.41421356f, 1e-6f);
+    EXPECT_NEAR(toFloat(sqrt(Fixed { 30000 })), 173.205081f, 1e-4f);
+
+    // rounded down, so squaring never overshoots
+    Fixed root { sqrt(Fixed { 3 }) };
+    EXPECT_LE(root * root, Fixed { 3 });
+    Fixed above { root + Fixed::fromRaw(1) };
+    EXPECT_GT(above * above, Fixed { 3 });
+}
+
+TEST(FixedTest, TestConversions)
+{
+    EXPECT_EQ(toInt(Fixed { 2.75 }), 2);
+    EXPECT_EQ(toInt(Fixed { -2.75 }), -2);
+    EXPECT_EQ(floorToLong(Fixed { -2.25 }), -3);
+    EXPECT_EQ(ceilToLong(Fixed { -2.25 }), -2);
+    EXPECT_EQ(floorToLong(Fixed { 5 }), 5);
+    EXPECT_EQ(ceilToLong(Fixed { 5 }), 5);
+    EXPECT_EQ(ceilToLong(Fixed { 5 } + Fixed::fromRaw(1)), 6);
+
+    EXPECT_FLOAT_EQ(toFloat(Fixed { 0.125 }), 0.125f);
+    EXPECT_EQ(fromFloat<Fixed>(0.125f), Fixed { 0.125 });
+    EXPECT_EQ(fromFloat<float>(0.125f), 0.125f);
+    EXPECT_EQ(abs(Fixed { -1.5 }), Fixed { 1.5 });
+}
+
+TEST(FixedTest, TestLimits)
+{
+    EXPECT_FALSE(std::numeric_limits<Fixed>::has_infinity);
+    EXPECT_GT(std::numeric_limits<Fixed>::max(), Fixed { 1000000 });
+    EXPECT_LT(std::numeric_limits<Fixed>::lowest(), Fixed { -1000000 });
+    EXPECT_EQ(std::numeric_limits<Fixed>::min(), std::numeric_limits<Fixed>::lowest());
+    EXPECT_EQ(std::clamp(Fixed { -5 }, std::numeric_limits<Fixed>::min(), Fixed { 0 }), Fixed { -5 });
+    EXPECT_EQ(std::numeric_limits<Fixed>::epsilon(), Fixed::fromRaw(1));
+}
+
+TEST(FixedTest, TestVectors)
+{
+    FixedVector2D velocity { Fixed { 3 }, Fixed { -4 } };
+    EXPECT_EQ(velocity.getMagnitude(), Fixed { 5 });
+    velocity.setMagnitude(Fixed { 10 });
+    EXPECT_EQ(velocity.getX(), Fixed { 6 });
+    EXPECT_EQ(velocity.getY(), Fixed { -8 });
+
+    // the heading table holds the float headings, rounded
+    for (int degrees = 0; degrees < 360; degrees++)
+    {
+        const FixedVector2D& heading { FixedVector2D::heading(degrees) };
+        EXPECT_NEAR(toFloat(heading.getX()), Vector2D::heading(degrees).getX(), 1e-7f) << degrees;
+        EXPECT_NEAR(toFloat(heading.getY()), Vector2D::heading(degrees).getY(), 1e-7f) << degrees;
+    }
+    EXPECT_EQ(FixedVector2D::heading(90).getX(), Fixed { 1 });
+    EXPECT_EQ(FixedVector2D::heading(90).getY(), Fixed {});
+
+    Vector2D converted { vectorCast<float>(FixedVector2D { Fixed { 0.5 }, Fixed { -2 } }) };
+    EXPECT_FLOAT_EQ(converted.getX(), 0.5f);
+    EXPECT_FLOAT_EQ(converted.getY(), -2.0f);
+}
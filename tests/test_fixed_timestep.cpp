@@ -0,0 +1,41 @@
+#include "engine/FixedTimestep.h"
+#include <gtest/gtest.h>
+
+TEST(FixedTimestepTest, TestStepsAtTheConfiguredRate)
+{
+    FixedTimestep timestep(1000, 100, 5); // 10 ticks a step
+    EXPECT_EQ(timestep.getStepLength(), 10u);
+
+    // frames shorter than a step run no steps until the time adds up
+    EXPECT_EQ(timestep.advance(4), 0);
+    EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.4f);
+    EXPECT_EQ(timestep.advance(4), 0);
+    EXPECT_EQ(timestep.advance(4), 1);
+    EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.2f);
+
+    // and longer frames run several
+    EXPECT_EQ(timestep.advance(28), 3);
+    EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+
+    // over a long run the step count matches the elapsed time whatever the frame lengths
+    int steps { 0 };
+    for (int frame = 0; frame < 1000; frame++)
+    {
+        steps += timestep.advance(static_cast<Uint64>(3 + frame % 7));
+    }
+    EXPECT_EQ(steps, (1000 / 7 * (3 + 4 + 5 + 6 + 7 + 8 + 9) + 3 + 4 + 5 + 6 + 7 + 8) / 10);
+}
+
+TEST(FixedTimestepTest, TestCatchUpIsCapped)
+{
+    FixedTimestep timestep(1000, 100, 5);
+    EXPECT_EQ(timestep.advance(3), 0);
+
+    // a long stall runs the cap and drops the rest, keeping the fraction of a step
+    EXPECT_EQ(timestep.advance(1000), 5);
+    EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.3f);
+
+    // after which it is back to real time
+    EXPECT_EQ(timestep.advance(7), 1);
+    EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+}
@@ -0,0 +1,140 @@
+#include "TestWorlds.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LanderEnv.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+constexpr int MAX_STEPS { 600 };
+const TerrainGenerationConfig CONFIG { makeTestWorldConfig(0, 2048) };
+
+// straight, no thrust
+constexpr int FALL { 2 };
+}
+
+TEST(LanderEnvTest, TestDecodeActionCoversEveryInput)
+{
+    for (int action = 0; action < LanderEnv::ACTION_COUNT; action++)
+    {
+        ShipInput input { LanderEnv::decodeAction(action) };
+        EXPECT_EQ(input.turn, action / 2 - 1);
+        EXPECT_EQ(input.thrust, action % 2 == 1);
+    }
+    EXPECT_EQ(LanderEnv::decodeAction(FALL).turn, 0);
+    EXPECT_FALSE(LanderEnv::decodeAction(FALL).thrust);
+}
+
+TEST(LanderEnvTest, TestResetObservesAShipAtRest)
+{
+    LanderEnv env { CONFIG, 2, MAX_STEPS };
+    LanderEnv::Observation observation { env.reset(5) };
+    EXPECT_EQ(env.getStepCount(), 0);
+    EXPECT_FLOAT_EQ(observation[LanderEnv::NOSE_SINE], 0.0f);
+    EXPECT_FLOAT_EQ(observation[LanderEnv::NOSE_COSINE], 1.0f);
+    EXPECT_FLOAT_EQ(observation[LanderEnv::VELOCITY_X], 0.0f);
+    EXPECT_FLOAT_EQ(observation[LanderEnv::VELOCITY_Y], 0.0f);
+    EXPECT_FLOAT_EQ(observation[LanderEnv::THRUST], 0.0f);
+    EXPECT_GT(observation[LanderEnv::ALTITUDE], 0.0f);
+    for (size_t ray = 0; ray < LanderEnv::RAY_COUNT; ray++)
+    {
+        EXPECT_GT(observation[LanderEnv::FIRST_RAY + ray], 0.0f);
+        EXPECT_LE(observation[LanderEnv::FIRST_RAY + ray], 1.0f);
+    }
+}
+
+TEST(LanderEnvTest, TestEpisodesAreDeterministic)
+{
+    LanderEnv first { CONFIG, 2, MAX_STEPS };
+    LanderEnv second { CONFIG, 2, MAX_STEPS };
+    EXPECT_EQ(first.reset(9), second.reset(9));
+    for (int step = 0; step < 200; step++)
+    {
+        int action { step * 7 % LanderEnv::ACTION_COUNT };
+        LanderEnv::Transition left { first.step(action) };
+        LanderEnv::Transition right { second.step(action) };
+        ASSERT_EQ(left.observation, right.observation);
+        ASSERT_EQ(left.reward, right.reward);
+        ASSERT_EQ(left.done, right.done);
+    }
+
+    // a second episode on the same seed respawns in the same world and replays the first
+    LanderEnv::Observation start { first.reset(9) };
+    EXPECT_EQ(start, second.reset(9));
+    EXPECT_EQ(first.getStepCount(), 0);
+}
+
+TEST(LanderEnvTest, TestEpisodeEndsWhenTheShipCrashes)
+{
+    // thrusting while spinning flies the ship into the terrain long before the step limit
+    LanderEnv env { CONFIG, 2, 100000 };
+    env.reset(3);
+    LanderEnv::Transition transition {};
+    while (!transition.done)
+    {
+        transition = env.step(env.getStepCount() % 240 < 120 ? 1 : 0);
+    }
+    EXPECT_TRUE(env.getSimulation().isCrashed());
+    EXPECT_LT(transition.reward, LanderEnv::CRASH_REWARD / 2.0f);
+
+    // stepping a finished episode changes nothing
+    int steps { env.getStepCount() };
+    LanderEnv::Transition after { env.step(1) };
+    EXPECT_TRUE(after.done);
+    EXPECT_EQ(after.reward, 0.0f);
+    EXPECT_EQ(env.getStepCount(), steps);
+}
+
+TEST(LanderEnvTest, TestEpisodeEndsAtTheStepLimit)
+{
+    LanderEnv env { CONFIG, 2, 10 };
+    env.reset(3);
+    for (int step = 1; step < 10; step++)
+    {
+        EXPECT_FALSE(env.step(FALL).done);
+    }
+    EXPECT_TRUE(env.step(FALL).done);
+    EXPECT_FALSE(env.getSimulation().isCrashed());
+}
+
+TEST(LanderEnvTest, TestVectorEnvMatchesSingleEnvs)
+{
+    constexpr size_t COUNT { 3 };
+    VectorEnv vector { COUNT, CONFIG, 2, 50 };
+    std::vector<LanderEnv> singles {};
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        singles.emplace_back(CONFIG, 2, 50);
+    }
+    unsigned int seeds[COUNT] { 1, 2, 1 };
+    vector.reset(seeds);
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        LanderEnv::Observation observation { singles[i].reset(seeds[i]) };
+        EXPECT_TRUE(std::equal(observation.begin(), observation.end(), vector.getObservations() + i * LanderEnv::OBSERVATION_SIZE));
+    }
+
+    int actions[COUNT] {};
+    for (int step = 0; step < 80; step++)
+    {
+        for (size_t i = 0; i < COUNT; i++)
+        {
+            actions[i] = (step + static_cast<int>(i)) % LanderEnv::ACTION_COUNT;
+        }
+        vector.step(actions);
+        for (size_t i = 0; i < COUNT; i++)
+        {
+            LanderEnv::Transition transition { singles[i].step(actions[i]) };
+            ASSERT_EQ(vector.getRewards()[i], transition.reward);
+            ASSERT_EQ(vector.getDones()[i] != 0, transition.done);
+            // a finished environment starts over straight away
+            if (transition.done)
+            {
+                transition.observation = singles[i].reset(seeds[i]);
+            }
+            ASSERT_TRUE(std::equal(transition.observation.begin(), transition.observation.end(), vector.getObservations() + i * LanderEnv::OBSERVATION_SIZE));
+        }
+    }
+    EXPECT_EQ(vector.getEnv(0).getStepCount(), 80 - 50);
+}
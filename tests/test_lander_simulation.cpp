@@ -0,0 +1,247 @@
+#include "TestWorlds.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LanderSimulation.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+LanderSimulation makeSimulation()
+{
+    return makeTestSimulation(11, 2048, 2);
+}
+}
+
+TEST(LanderSimulationTest, TestShipStartsAtRestInTheMiddle)
+{
+    LanderSimulation simulation { makeSimulation() };
+    EXPECT_FLOAT_EQ(simulation.getShip().getPosX(), 1024.0f);
+    EXPECT_FLOAT_EQ(simulation.getShip().getPosY(), static_cast<float>(WORLD_HEIGHT / 2));
+    EXPECT_FLOAT_EQ(simulation.getShip().getVelY(), 0.0f);
+    EXPECT_FALSE(simulation.isCrashed());
+    EXPECT_EQ(simulation.getTerrain().getWidth(), 2048u);
+    EXPECT_EQ(simulation.getSpacestation().w, SPACESTATION_WIDTH);
+    EXPECT_EQ(simulation.getTerrainChunks(), nullptr);
+}
+
+TEST(LanderSimulationTest, TestInputsSteerTheShip)
+{
+    LanderSimulation simulation { makeSimulation() };
+    EXPECT_FALSE(simulation.step(ShipInput { 0, false }));
+    // gravity as the physics holds it, GRAVITY itself unless that is fixed point
+    EXPECT_FLOAT_EQ(simulation.getShip().getVelY(), toFloat(fromFloat<PhysicsScalar>(GRAVITY)));
+
+    simulation.step(ShipInput { 1, false });
+    simulation.step(ShipInput { 1, false });
+    EXPECT_FLOAT_EQ(simulation.getShip().getNoseAngle(), 2.0f * ROTATION_SPEED);
+    simulation.step(ShipInput { -1, false });
+    EXPECT_FLOAT_EQ(simulation.getShip().getNoseAngle(), ROTATION_SPEED);
+
+    simulation.step(ShipInput { 0, true });
+    EXPECT_FLOAT_EQ(simulation.getShip().getFlightStats().thrustUnits, toFloat(fromFloat<PhysicsScalar>(THRUST_UNIT)));
+}
+
+TEST(LanderSimulationTest, TestSameInputsFlyTheSameFlight)
+{
+    LanderSimulation first { makeSimulation() };
+    LanderSimulation second { makeSimulation() };
+    std::mt19937 rng { 4 };
+    for (int step = 0; step < 3000; step++)
+    {
+        ShipInput input { static_cast<std::int8_t>(static_cast<int>(rng() % 3) - 1), rng() % 2 == 0 };
+        ASSERT_EQ(first.step(input), second.step(input)) << "step " << step;
+        ASSERT_EQ(first.getShip().getPosX(), second.getShip().getPosX()) << "step " << step;
+        ASSERT_EQ(first.getShip().getPosY(), second.getShip().getPosY()) << "step " << step;
+        ASSERT_EQ(first.getStateHash(), second.getStateHash()) << "step " << step;
+    }
+}
+
+TEST(LanderSimulationTest, TestStateHashFollowsTheShip)
+{
+    LanderSimulation first { makeSimulation() };
+    LanderSimulation second { makeSimulation() };
+    EXPECT_EQ(first.getStateHash(), second.getStateHash());
+
+    // one turn apart, then the same inputs, the flights stay apart
+    first.step(ShipInput { 1, false });
+    second.step(ShipInput { 0, false });
+    EXPECT_NE(first.getStateHash(), second.getStateHash());
+    for (int step = 0; step < 50; step++)
+    {
+        first.step(ShipInput { 0, true });
+        second.step(ShipInput { 0, true });
+        ASSERT_NE(first.getStateHash(), second.getStateHash()) << "step " << step;
+    }
+}
+
+TEST(LanderSimulationTest, TestRestoredFlightFliesTheSame)
+{
+    LanderSimulation simulation { makeSimulation() };
+    std::mt19937 rng { 6 };
+    std::vector<ShipInput> inputs;
+    for (int step = 0; step < 600; step++)
+    {
+        inputs.push_back(ShipInput { static_cast<std::int8_t>(static_cast<int>(rng() % 3) - 1), rng() % 2 == 0 });
+    }
+    for (size_t step = 0; step < 200; step++)
+    {
+        simulation.step(inputs[step]);
+    }
+    LanderSimulation::Snapshot snapshot { simulation.saveState() };
+    EXPECT_EQ(snapshot.tick, 200u);
+
+    std::vector<std::uint64_t> hashes;
+    for (size_t step = 200; step < inputs.size(); step++)
+    {
+        simulation.step(inputs[step]);
+        hashes.push_back(simulation.getStateHash());
+    }
+
+    // the same future, every time it is flown again from the snapshot
+    for (int replay = 0; replay < 3; replay++)
+    {
+        ASSERT_TRUE(simulation.restoreState(snapshot));
+        EXPECT_EQ(simulation.getTick(), 200u);
+        for (size_t step = 200; step < inputs.size(); step++)
+        {
+            simulation.step(inputs[step]);
+            ASSERT_EQ(simulation.getStateHash(), hashes[step - 200]) << "replay " << replay << " step " << step;
+        }
+    }
+}
+
+TEST(LanderSimulationTest, TestRollbackCorrectsAnInput)
+{
+    // one flight with a late input fixed by rolling back, the other flying the fixed inputs from the start
+    LanderSimulation corrected { makeSimulation() };
+    LanderSimulation reference { makeSimulation() };
+    std::vector<ShipInput> inputs(300, ShipInput { 0, true });
+    std::vector<LanderSimulation::Snapshot> history;
+    for (const ShipInput& input : inputs)
+    {
+        history.push_back(corrected.saveState());
+        corrected.step(input);
+    }
+
+    inputs[250] = ShipInput { 1, false };
+    ASSERT_TRUE(corrected.restoreState(history[250]));
+    for (size_t step = 250; step < inputs.size(); step++)
+    {
+        corrected.step(inputs[step]);
+    }
+    for (const ShipInput& input : inputs)
+    {
+        reference.step(input);
+    }
+    EXPECT_EQ(corrected.getStateHash(), reference.getStateHash());
+    EXPECT_EQ(corrected.getTick(), reference.getTick());
+}
+
+TEST(LanderSimulationTest, TestSnapshotsStayInTheirWorld)
+{
+    static_assert(std::is_trivially_copyable_v<LanderSimulation::Snapshot>, "snapshots are plain values");
+    LanderSimulation first { makeSimulation() };
+    LanderSimulation second { makeSimulation() };
+    second.step(ShipInput { 1, true });
+    std::uint64_t hash { second.getStateHash() };
+
+    // the same terrain, but another world
+    EXPECT_FALSE(second.restoreState(first.saveState()));
+    EXPECT_EQ(second.getStateHash(), hash);
+
+    // respawning keeps the world, creating one does not
+    LanderSimulation::Snapshot snapshot { second.saveState() };
+    second.respawn();
+    EXPECT_TRUE(second.restoreState(snapshot));
+    second.createWorld(makeTestWorldConfig(11, 2048), 2);
+    EXPECT_FALSE(second.restoreState(snapshot));
+}
+
+#ifdef LUNAR_LANDER_FIXED_POINT
+// Fixed point flights are the same bits everywhere, so a flight's final hash can be written down.
+// A change to the physics, the terrain or the hash changes it, and it is recorded again here
+TEST(LanderSimulationTest, TestFixedPointFlightIsReproducible)
+{
+    LanderSimulation simulation { makeSimulation() };
+    std::mt19937 rng { 4 };
+    for (int step = 0; step < 3000; step++)
+    {
+        simulation.step(ShipInput { static_cast<std::int8_t>(static_cast<int>(rng() % 3) - 1), rng() % 2 == 0 });
+    }
+    EXPECT_EQ(simulation.getStateHash(), 0x20af44a37ced7435u);
+}
+#endif
+
+TEST(LanderSimulationTest, TestCrashedShipStaysWhereItHit)
+{
+    LanderSimulation simulation { makeSimulation() };
+
+    // nose to the right and thrust away from the space station, then fall
+    bool crashed { false };
+    for (int step = 0; step < 20000 && !crashed; step++)
+    {
+        crashed = simulation.step(ShipInput { static_cast<std::int8_t>(step < 90 ? 1 : 0), step >= 90 && step < 150 });
+    }
+    ASSERT_TRUE(crashed);
+    EXPECT_TRUE(simulation.isCrashed());
+    EXPECT_TRUE(simulation.getShip().isDestroyed());
+
+    float x { simulation.getShip().getPosX() };
+    float y { simulation.getShip().getPosY() };
+    EXPECT_FALSE(simulation.step(ShipInput { 1, true }));
+    EXPECT_EQ(simulation.getShip().getPosX(), x);
+    EXPECT_EQ(simulation.getShip().getPosY(), y);
+}
+
+TEST(LanderSimulationTest, TestShipAFractionAboveAPadHasLanded)
+{
+    // fixed point contact times stop a ship short of a pad by less than a pixel, which its position
+    // truncated to whole pixels would put a pixel above it
+    LanderSimulation simulation { makeSimulation() };
+    ASSERT_FALSE(simulation.getLandingPadIndex().getPads().empty());
+    const LandingPad& pad { simulation.getLandingPadIndex().getPads().front() };
+    float x { static_cast<float>(pad.start + pad.width / 2) - static_cast<float>(SPACESHIP_WIDTH) / 2.0f };
+    float y { static_cast<float>(pad.surface - SPACESHIP_HEIGHT + COLLISION_BOX_MARGIN) - 0.25f };
+
+    LanderSimulation::Snapshot snapshot { simulation.saveState() };
+    snapshot.ship.position = PhysicsVector { fromFloat<PhysicsScalar>(x), fromFloat<PhysicsScalar>(y) };
+    snapshot.ship.previousPosition = snapshot.ship.position;
+    snapshot.ship.velocity = PhysicsVector {};
+    ASSERT_TRUE(simulation.restoreState(snapshot));
+    EXPECT_TRUE(simulation.isLanded());
+
+    // a pixel and a quarter above is still in the air
+    snapshot.ship.position = PhysicsVector { fromFloat<PhysicsScalar>(x), fromFloat<PhysicsScalar>(y - 1.0f) };
+    ASSERT_TRUE(simulation.restoreState(snapshot));
+    EXPECT_FALSE(simulation.isLanded());
+}
+
+TEST(LanderSimulationTest, TestStreamedWorldKeepsTheChunksUnderTheView)
+{
+    LanderSimulation simulation { SPACESHIP_WIDTH, SPACESHIP_HEIGHT, SPACESTATION_WIDTH, SPACESTATION_HEIGHT };
+    simulation.createStreamedWorld(makeTestWorldConfig(11, 512 * 20), 20, 512, 6, 1000, 600);
+    ASSERT_NE(simulation.getTerrainChunks(), nullptr);
+    EXPECT_EQ(simulation.getTerrainChunks()->getResidentChunkCount(), 0u);
+
+    simulation.step(ShipInput { 0, false });
+    Rect view { simulation.getView(1000, 600, 1.0f) };
+    for (size_t chunk = static_cast<size_t>(view.x) / 512; chunk <= static_cast<size_t>(view.x + view.w - 1) / 512; chunk++)
+    {
+        EXPECT_NE(simulation.getTerrainChunks()->findChunk(chunk), nullptr) << "chunk " << chunk;
+    }
+    EXPECT_LE(simulation.getTerrainChunks()->getResidentChunkCount(), 6u);
+}
+
+TEST(LanderSimulationTest, TestViewIsClampedToTheWorld)
+{
+    LanderSimulation simulation { makeSimulation() };
+    Rect view { simulation.getView(1000, 600, 1.0f) };
+    EXPECT_EQ(view.x, 1024 - 500);
+    EXPECT_EQ(view.w, 1000);
+
+    // wider than the world, shown from the left edge
+    view = simulation.getView(4000, 600, 1.0f);
+    EXPECT_EQ(view.x, 0);
+}
@@ -0,0 +1,103 @@
+#include "TestWorlds.h"
+#include "lunar_lander/ChunkManager.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LandingPadIndex.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+// pads at [100, 150), [150, 200) and [400, 460)
+LandingPadIndex makeIndex()
+{
+    return LandingPadIndex({ { 400, 60, 30 }, { 100, 50, 10 }, { 150, 50, 10 } });
+}
+}
+
+TEST(LandingPadIndexTest, TestPadsAreSorted)
+{
+    LandingPadIndex index { makeIndex() };
+    ASSERT_EQ(index.size(), 3u);
+    EXPECT_EQ(index[0].start, 100u);
+    EXPECT_EQ(index[1].start, 150u);
+    EXPECT_EQ(index[2].start, 400u);
+}
+
+TEST(LandingPadIndexTest, TestPadAt)
+{
+    LandingPadIndex index { makeIndex() };
+    EXPECT_EQ(index.padAt(99.5f), nullptr);
+    EXPECT_EQ(index.padAt(100.0f), &index[0]);
+    EXPECT_EQ(index.padAt(149.9f), &index[0]);
+    EXPECT_EQ(index.padAt(150.0f), &index[1]);
+    EXPECT_EQ(index.padAt(200.0f), nullptr);
+    EXPECT_EQ(index.padAt(459.0f), &index[2]);
+    EXPECT_EQ(index.padAt(460.0f), nullptr);
+}
+
+TEST(LandingPadIndexTest, TestNearestAndNext)
+{
+    LandingPadIndex index { makeIndex() };
+    EXPECT_EQ(index.nearest(0.0f), &index[0]);
+    EXPECT_EQ(index.nearest(120.0f), &index[0]);
+    EXPECT_EQ(index.nearest(290.0f), &index[1]);
+    EXPECT_EQ(index.nearest(310.0f), &index[2]);
+    EXPECT_EQ(index.nearest(300.0f), &index[1]); // ties go left
+    EXPECT_EQ(index.nearest(5000.0f), &index[2]);
+
+    EXPECT_EQ(index.next(0.0f), &index[0]);
+    EXPECT_EQ(index.next(120.0f), &index[1]);
+    EXPECT_EQ(index.next(400.0f), nullptr);
+
+    EXPECT_EQ(LandingPadIndex().nearest(10.0f), nullptr);
+}
+
+TEST(LandingPadIndexTest, TestOffsetTo)
+{
+    LandingPadIndex index { makeIndex() };
+    EXPECT_FLOAT_EQ(LandingPadIndex::offsetTo(index[2], 350.0f), 50.0f);
+    EXPECT_FLOAT_EQ(LandingPadIndex::offsetTo(index[2], 420.0f), 0.0f);
+    EXPECT_FLOAT_EQ(LandingPadIndex::offsetTo(index[2], 470.0f), -10.0f);
+}
+
+TEST(LandingPadIndexTest, TestGeneratorIndexMatchesTerrain)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(5, static_cast<size_t>(WORLD_WIDTH)) };
+    TerrainHeightmap terrain {};
+    TerrainGenerator generator { config.seed };
+    generator.generateTerrain(terrain, config, 30);
+    const LandingPadIndex& index { generator.getLandingPadIndex() };
+    ASSERT_GT(index.size(), 0u);
+
+    for (size_t x = 0; x < terrain.getWidth(); x++)
+    {
+        const LandingPad* pad { index.padAt(static_cast<float>(x)) };
+        ASSERT_EQ(pad != nullptr, terrain.isLandingPad(x)) << "x=" << x;
+        if (pad != nullptr)
+        {
+            ASSERT_EQ(pad->surface, terrain.getSurface(x)) << "x=" << x;
+        }
+    }
+}
+
+TEST(LandingPadIndexTest, TestChunkIndexMatchesGeneratedChunks)
+{
+    constexpr size_t CHUNK_WIDTH { 512 };
+    TerrainGenerationConfig config { makeTestWorldConfig(5, CHUNK_WIDTH * 8) };
+    ChunkManager chunks { config, 16, CHUNK_WIDTH, 8 };
+
+    // the surfaces are known before any chunk is generated
+    std::vector<LandingPad> before { chunks.getLandingPadIndex().getPads() };
+    ASSERT_GT(before.size(), 0u);
+    for (size_t i = 0; i < chunks.getChunkCount(); i++)
+    {
+        chunks.requireChunk(i);
+    }
+    for (const LandingPad& pad : before)
+    {
+        for (size_t x = pad.start; x != pad.end(); x++)
+        {
+            ASSERT_TRUE(chunks.isLandingPad(x)) << "x=" << x;
+            ASSERT_EQ(chunks.getSurface(x), pad.surface) << "x=" << x;
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#include "lunar_lander/LatticeNoise1D.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+TEST(LatticeNoiseTest, TestSameSeedSameNoise)
+{
+    LatticeNoise1D first { 42 };
+    LatticeNoise1D second { 42 };
+    LatticeNoise1D other { 43 };
+    int differences { 0 };
+    for (std::uint64_t x = 0; x < 2000; x++)
+    {
+        ASSERT_EQ(first.octaveNoise(x, 6, 0.5, 0.0025), second.octaveNoise(x, 6, 0.5, 0.0025)) << "x=" << x;
+        differences += first.octaveNoise(x, 6, 0.5, 0.0025) != other.octaveNoise(x, 6, 0.5, 0.0025);
+    }
+    EXPECT_GT(differences, 1000);
+}
+
+TEST(LatticeNoiseTest, TestRangeAndSmoothness)
+{
+    LatticeNoise1D noise { 7 };
+    std::int64_t previous { noise.octaveNoise(0, 6, 0.5, 0.0025) };
+    std::int64_t lowest { previous };
+    std::int64_t highest { previous };
+    for (std::uint64_t x = 1; x < 20000; x++)
+    {
+        std::int64_t value { noise.octaveNoise(x, 6, 0.5, 0.0025) };
+        ASSERT_LE(std::llabs(value), LatticeNoise1D::ONE) << "x=" << x;
+        // neighbouring columns differ by a few hundredths at most, as the double noise does
+        ASSERT_LT(std::llabs(value - previous), LatticeNoise1D::ONE / 16) << "x=" << x;
+        lowest = std::min(lowest, value);
+        highest = std::max(highest, value);
+        previous = value;
+    }
+    // the terrain uses a good part of its range
+    EXPECT_LT(lowest, -LatticeNoise1D::ONE / 4);
+    EXPECT_GT(highest, LatticeNoise1D::ONE / 4);
+}
+
+TEST(LatticeNoiseTest, TestZeroOnTheLattice)
+{
+    // gradient noise is zero at whole cells, whichever the gradient, and 1/256 steps onto them exactly
+    LatticeNoise1D noise { 3 };
+    for (std::uint64_t x = 0; x < 4096; x += 256)
+    {
+        EXPECT_EQ(noise.octaveNoise(x, 1, 0.5, 1.0 / 256.0), 0) << "x=" << x;
+    }
+    EXPECT_EQ(noise.octaveNoise(5, 0, 0.5, 0.0025), 0);
+}
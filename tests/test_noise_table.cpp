@@ -0,0 +1,33 @@
+#include "lunar_lander/NoiseTable.h"
+#include <gtest/gtest.h>
+
+TEST(NoiseTableTest, TestWithinErrorBoundOfExactNoise)
+{
+    PerlinNoise1D noise { 11 };
+    NoiseTable table { noise, 3, 0.5, 1.0, 0.0, 10.0 };
+    ASSERT_FALSE(table.isEmpty());
+    EXPECT_LT(table.getErrorBound(), 0.01);
+
+    // the bound holds everywhere in the domain, the only slack is for rounding
+    for (double x = 0.0; x <= 10.0; x += 0.0137)
+    {
+        EXPECT_NEAR(table.sample(x), noise.octaveNoise(x, 3, 0.5, 1.0), table.getErrorBound() + 1e-12);
+    }
+}
+
+TEST(NoiseTableTest, TestHigherResolutionReducesError)
+{
+    PerlinNoise1D noise { 11 };
+    NoiseTable coarse { noise, 2, 0.5, 1.0, 0.0, 20.0, 4.0 };
+    NoiseTable fine { noise, 2, 0.5, 1.0, 0.0, 20.0, 32.0 };
+    EXPECT_GT(fine.getSize(), coarse.getSize());
+    EXPECT_LT(fine.getErrorBound(), coarse.getErrorBound());
+}
+
+TEST(NoiseTableTest, TestQueriesOutsideDomainAreClamped)
+{
+    PerlinNoise1D noise { 3 };
+    NoiseTable table { noise, 1, 0.5, 1.0, 2.0, 6.0 };
+    EXPECT_DOUBLE_EQ(table.sample(-100.0), table.sample(2.0));
+    EXPECT_DOUBLE_EQ(table.sample(100.0), table.sample(6.0));
+}
@@ -0,0 +1,70 @@
+#include "lunar_lander/PerlinNoise1D.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+class PerlinNoiseBatchTest : public ::testing::TestWithParam<size_t>
+{
+protected:
+    PerlinNoise1D noise { 1234 };
+};
+
+TEST_P(PerlinNoiseBatchTest, TestBatchMatchesScalar)
+{
+    // a sample count that exercises whole vectors, partial blocks and the scalar tail
+    size_t count { GetParam() };
+    std::vector<double> xs(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        xs[i] = static_cast<double>(i) * 7.31 + 0.123;
+    }
+
+    for (int octaves : { 1, 4, 6 })
+    {
+        std::vector<double> batch(count);
+        noise.octaveNoiseBatch(xs.data(), batch.data(), count, octaves, 0.5, 0.0025);
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_NEAR(batch[i], noise.octaveNoise(xs[i], octaves, 0.5, 0.0025), 1e-12) << "i=" << i;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SampleCounts,
+    PerlinNoiseBatchTest,
+    ::testing::Values(0u, 1u, 3u, 4u, 9u, 64u, 1001u));
+
+TEST(PerlinNoiseTest, TestBatchMatchesScalarAtLatticePoints)
+{
+    PerlinNoise1D noise { 99 };
+    std::vector<double> xs { 0.0, 1.0, 255.0, 256.0, 257.0, 1000.0, 65536.0 };
+    std::vector<double> batch(xs.size());
+    noise.octaveNoiseBatch(xs.data(), batch.data(), xs.size(), 3, 0.6, 1.0);
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        EXPECT_NEAR(batch[i], noise.octaveNoise(xs[i], 3, 0.6, 1.0), 1e-12);
+    }
+}
+
+TEST(PerlinNoiseTest, TestBatchMatchesScalarPastInt32)
+{
+    // cells from 2^31 on no longer fit the vector path's 32 bit lanes unless they are wrapped first
+    PerlinNoise1D noise { 99 };
+    std::vector<double> xs { 2147483648.0 + 100.3, 3.0e9 + 77.6, 7.0e9 + 201.9, 1.0e12 + 13.4, 35184372088832.0 + 99.5 };
+    std::vector<double> batch(xs.size());
+    noise.octaveNoiseBatch(xs.data(), batch.data(), xs.size(), 3, 0.6, 1.0);
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        EXPECT_NEAR(batch[i], noise.octaveNoise(xs[i], 3, 0.6, 1.0), 1e-12) << "x=" << xs[i];
+    }
+}
+
+TEST(PerlinNoiseTest, TestSameSeedSameNoise)
+{
+    PerlinNoise1D first { 5 };
+    PerlinNoise1D second { 5 };
+    for (double x = 0.0; x < 50.0; x += 0.37)
+    {
+        EXPECT_EQ(first.noise(x), second.noise(x));
+    }
+}
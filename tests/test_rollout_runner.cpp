@@ -0,0 +1,91 @@
+#include "TestWorlds.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/RolloutRunner.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+const TerrainGenerationConfig CONFIG { makeTestWorldConfig(0, 2048) };
+
+// drifts sideways by an amount that depends on the rollout, then falls with the engine off
+ShipInput drift(const LanderSimulation&, const size_t rollout, const int step)
+{
+    if (step < 90)
+    {
+        return ShipInput { static_cast<std::int8_t>(rollout % 2 == 0 ? 1 : -1), false };
+    }
+    return ShipInput { 0, step < 100 + static_cast<int>(rollout % 7) * 10 };
+}
+
+std::vector<unsigned int> makeSeeds()
+{
+    std::vector<unsigned int> seeds {};
+    for (unsigned int seed = 1; seed <= 6; seed++)
+    {
+        seeds.insert(seeds.end(), 5, seed);
+    }
+    return seeds;
+}
+}
+
+TEST(RolloutRunnerTest, TestResultsMatchFlyingEachSimulationAlone)
+{
+    std::vector<unsigned int> seeds { makeSeeds() };
+    RolloutRunner runner { CONFIG, 2, 3 };
+    std::vector<RolloutResult> results { runner.run(seeds, 2000, drift) };
+    ASSERT_EQ(results.size(), seeds.size());
+
+    for (size_t rollout = 0; rollout < seeds.size(); rollout++)
+    {
+        LanderSimulation simulation { makeTestSimulation(seeds[rollout], 2048, 2) };
+        int steps { 0 };
+        float fuel { 0.0f };
+        bool crashed { false };
+        while (steps < 2000 && !crashed && !simulation.isLanded())
+        {
+            crashed = simulation.step(drift(simulation, rollout, steps));
+            fuel += simulation.getShip().getThrust();
+            steps++;
+        }
+
+        EXPECT_EQ(results[rollout].seed, seeds[rollout]);
+        EXPECT_EQ(results[rollout].steps, steps) << "rollout " << rollout;
+        EXPECT_EQ(results[rollout].fuel, fuel) << "rollout " << rollout;
+        EXPECT_EQ(results[rollout].outcome == RolloutOutcome::CRASHED, crashed) << "rollout " << rollout;
+    }
+}
+
+TEST(RolloutRunnerTest, TestSummaryAndCachedWorlds)
+{
+    std::vector<unsigned int> seeds { makeSeeds() };
+    RolloutRunner runner { CONFIG, 2, 2 };
+    std::vector<RolloutResult> results { runner.run(seeds, 2000, drift) };
+
+    RolloutSummary expected {};
+    for (const RolloutResult& result : results)
+    {
+        expected.add(result);
+    }
+    const RolloutSummary& summary { runner.getSummary() };
+    EXPECT_EQ(summary.getRollouts(), seeds.size());
+    EXPECT_EQ(summary.landed, expected.landed);
+    EXPECT_EQ(summary.crashed, expected.crashed);
+    EXPECT_EQ(summary.steps, expected.steps);
+    EXPECT_GT(summary.crashed, 0u);
+
+    // a seed's rollouts are neighbours, so each worker generates a world at most once per seed
+    EXPECT_GE(runner.getWorldsGenerated(), 6u);
+    EXPECT_LE(runner.getWorldsGenerated(), 6u * runner.getThreadCount());
+
+    // the same results whatever the number of threads, and the worlds are still cached
+    RolloutRunner single { CONFIG, 2, 1 };
+    std::vector<RolloutResult> singleResults { single.run(seeds, 2000, drift) };
+    EXPECT_EQ(single.getWorldsGenerated(), 6u);
+    single.run({ 6, 6, 5 }, 10, drift);
+    EXPECT_EQ(single.getWorldsGenerated(), 0u);
+    for (size_t rollout = 0; rollout < seeds.size(); rollout++)
+    {
+        EXPECT_EQ(singleResults[rollout].steps, results[rollout].steps);
+        EXPECT_EQ(singleResults[rollout].outcome, results[rollout].outcome);
+    }
+}
@@ -0,0 +1,185 @@
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/ShipBatch.h"
+#include "lunar_lander/Spaceship.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr size_t SHIPS { 203 }; // not a whole number of SIMD lanes
+constexpr int STEPS { 600 };
+
+// the same random pilot for the batch and for each Spaceship
+std::vector<ShipInput> makeInputs(std::mt19937& rng)
+{
+    std::vector<ShipInput> inputs(SHIPS);
+    for (ShipInput& input : inputs)
+    {
+        input.turn = static_cast<std::int8_t>(static_cast<int>(rng() % 3) - 1);
+        input.thrust = rng() % 3 == 0;
+    }
+    return inputs;
+}
+
+void applyInput(Spaceship& ship, const ShipInput& input)
+{
+    if (input.turn != 0)
+    {
+        ship.rotate(input.turn > 0 ? ROTATION_SPEED : -ROTATION_SPEED);
+    }
+    if (input.thrust)
+    {
+        ship.thrustIncrease();
+    }
+    else
+    {
+        ship.thrustDecay();
+    }
+}
+
+// bit for bit, not just close
+void expectSameShip(const ShipBatch& batch, const size_t index, const Spaceship& ship)
+{
+    EXPECT_EQ(batch.getPosX(index), ship.getPosX()) << index;
+    EXPECT_EQ(batch.getPosY(index), ship.getPosY()) << index;
+    EXPECT_EQ(batch.getVelX(index), ship.getVelX()) << index;
+    EXPECT_EQ(batch.getVelY(index), ship.getVelY()) << index;
+    EXPECT_EQ(batch.getNoseAngle(index), ship.getNoseAngle()) << index;
+}
+}
+
+class ShipBatchTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 rng { 5 };
+        for (size_t i = 0; i < SHIPS; i++)
+        {
+            int x { static_cast<int>(rng() % 900) + 50 };
+            int y { static_cast<int>(rng() % 200) };
+            ships.emplace_back(x, y, 32, 32, GRAVITY, THRUST_UNIT, MAX_THRUST);
+            batch.add(static_cast<float>(x), static_cast<float>(y));
+        }
+    }
+
+    std::vector<Spaceship> ships {};
+    ShipBatch batch { 32, 32, GRAVITY, THRUST_UNIT, MAX_THRUST, ROTATION_SPEED };
+};
+
+TEST_F(ShipBatchTest, TestFreeFlightMatchesSpaceship)
+{
+    if (FIXED_POINT_PHYSICS)
+    {
+        GTEST_SKIP() << "the batch flies in float";
+    }
+    std::mt19937 rng { 11 };
+    for (int step = 0; step < STEPS; step++)
+    {
+        std::vector<ShipInput> inputs { makeInputs(rng) };
+        batch.control(inputs.data());
+        batch.updatePhysics();
+        for (size_t i = 0; i < SHIPS; i++)
+        {
+            applyInput(ships[i], inputs[i]);
+            ships[i].updatePhysics();
+        }
+    }
+    for (size_t i = 0; i < SHIPS; i++)
+    {
+        expectSameShip(batch, i, ships[i]);
+        EXPECT_FALSE(batch.isCrashed(i));
+    }
+}
+
+TEST_F(ShipBatchTest, TestTerrainCollisionMatchesSpaceship)
+{
+    if (FIXED_POINT_PHYSICS)
+    {
+        GTEST_SKIP() << "the batch flies in float";
+    }
+    // rolling hills with a landing pad every 100 columns
+    TerrainHeightmap terrain(1000, 600);
+    for (size_t x = 0; x < terrain.getWidth(); x++)
+    {
+        terrain.setColumn(x, 400 + static_cast<int>(60.0 * std::sin(static_cast<double>(x) / 40.0)), x % 100 < 30);
+    }
+    TerrainQuery query { terrain };
+
+    std::mt19937 rng { 13 };
+    std::vector<bool> crashed(SHIPS, false);
+    size_t crashes { 0 };
+    for (int step = 0; step < STEPS; step++)
+    {
+        std::vector<ShipInput> inputs { makeInputs(rng) };
+        batch.control(inputs.data());
+        crashes += batch.updatePhysics(query);
+        for (size_t i = 0; i < SHIPS; i++)
+        {
+            // a crashed ship is no longer flown
+            if (!crashed[i])
+            {
+                applyInput(ships[i], inputs[i]);
+                crashed[i] = ships[i].updatePhysics(query);
+            }
+        }
+    }
+
+    size_t expectedCrashes { 0 };
+    for (size_t i = 0; i < SHIPS; i++)
+    {
+        expectSameShip(batch, i, ships[i]);
+        EXPECT_EQ(batch.isCrashed(i), crashed[i]) << i;
+        expectedCrashes += crashed[i];
+    }
+    EXPECT_EQ(crashes, expectedCrashes);
+    EXPECT_GT(crashes, 0u);
+}
+
+TEST_F(ShipBatchTest, TestCopiesFlyOnTheSame)
+{
+    if (FIXED_POINT_PHYSICS)
+    {
+        GTEST_SKIP() << "the batch flies in float";
+    }
+    // ships part way through a flight, copied into a new batch from themselves and from the batch
+    std::mt19937 rng { 13 };
+    for (int step = 0; step < 100; step++)
+    {
+        std::vector<ShipInput> inputs { makeInputs(rng) };
+        batch.control(inputs.data());
+        batch.updatePhysics();
+        for (size_t i = 0; i < SHIPS; i++)
+        {
+            applyInput(ships[i], inputs[i]);
+            ships[i].updatePhysics();
+        }
+    }
+    ShipBatch fromShips { 32, 32, GRAVITY, THRUST_UNIT, MAX_THRUST, ROTATION_SPEED };
+    ShipBatch fromBatch { 32, 32, GRAVITY, THRUST_UNIT, MAX_THRUST, ROTATION_SPEED };
+    for (size_t i = 0; i < SHIPS; i++)
+    {
+        fromShips.add(ships[i]);
+        fromBatch.add(batch, i);
+    }
+
+    for (int step = 0; step < 100; step++)
+    {
+        std::vector<ShipInput> inputs { makeInputs(rng) };
+        fromShips.control(inputs.data());
+        fromShips.updatePhysics();
+        fromBatch.control(inputs.data());
+        fromBatch.updatePhysics();
+        for (size_t i = 0; i < SHIPS; i++)
+        {
+            applyInput(ships[i], inputs[i]);
+            ships[i].updatePhysics();
+        }
+    }
+    for (size_t i = 0; i < SHIPS; i++)
+    {
+        expectSameShip(fromShips, i, ships[i]);
+        expectSameShip(fromBatch, i, ships[i]);
+    }
+}
@@ -0,0 +1,56 @@
+#include "engine/SnapshotRing.h"
+#include <gtest/gtest.h>
+
+TEST(SnapshotRingTest, TestNewestFirst)
+{
+    SnapshotRing<int> ring { 4 };
+    EXPECT_TRUE(ring.empty());
+    ring.push(1);
+    ring.push(2);
+    ring.push(3);
+    EXPECT_EQ(ring.size(), 3u);
+    EXPECT_EQ(ring.newest(), 3);
+    EXPECT_EQ(ring.newest(2), 1);
+}
+
+TEST(SnapshotRingTest, TestOldestAreOverwritten)
+{
+    SnapshotRing<int> ring { 4 };
+    for (int i = 0; i < 10; i++)
+    {
+        ring.push(i);
+    }
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring.capacity(), 4u);
+    for (size_t age = 0; age < 4; age++)
+    {
+        EXPECT_EQ(ring.newest(age), 9 - static_cast<int>(age));
+    }
+}
+
+TEST(SnapshotRingTest, TestDropNewest)
+{
+    SnapshotRing<int> ring { 4 };
+    for (int i = 0; i < 6; i++)
+    {
+        ring.push(i);
+    }
+    // back to 3, then on again from there across the wrap
+    ring.dropNewest(2);
+    EXPECT_EQ(ring.size(), 2u);
+    EXPECT_EQ(ring.newest(), 3);
+    ring.push(10);
+    ring.push(11);
+    ring.push(12);
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring.newest(), 12);
+    EXPECT_EQ(ring.newest(3), 3);
+
+    ring.dropNewest(4);
+    EXPECT_TRUE(ring.empty());
+    ring.push(7);
+    EXPECT_EQ(ring.newest(), 7);
+
+    ring.clear();
+    EXPECT_TRUE(ring.empty());
+}
@@ -1,4 +1,4 @@
-#include "engine/Texture.h"
+#include "lunar_lander/Constants.h"
 #include "lunar_lander/Spaceship.h"
 #include <gtest/gtest.h>
 
@@ -7,18 +7,16 @@ class SpaceshipTest : public ::testing::Test
 protected:
     void SetUp() override
     {
-        // Create mock texture with dimensions but nullptr SDL_Texture
-        mockTexture.setTexture(nullptr, 32, 32);
-        testSpaceship = Spaceship(0, 0, &mockTexture, 0.0f, 2.0f, 100.0f); // Zero gravity, high thrust for tests
+        // a 32 x 32 sprite
+        testSpaceship = Spaceship(0, 0, 32, 32, 0.0f, 2.0f, 100.0f); // Zero gravity, high thrust for tests
     }
 
-    Texture mockTexture;
-    Spaceship testSpaceship { 0, 0, nullptr, 0.0f, 2.0f, 100.0f };
+    Spaceship testSpaceship { 0, 0, 32, 32, 0.0f, 2.0f, 100.0f };
 };
 
 TEST_F(SpaceshipTest, TestGetDrawBounds)
 {
-    SDL_Rect bounds = testSpaceship.getDrawBounds();
+    Rect bounds = testSpaceship.getDrawBounds();
     EXPECT_EQ(bounds.x, 0);
     EXPECT_EQ(bounds.y, 0);
     EXPECT_EQ(bounds.w, 32);
@@ -27,13 +25,46 @@ TEST_F(SpaceshipTest, TestGetDrawBounds)
 
 TEST_F(SpaceshipTest, TestGetCollisionBounds)
 {
-    SDL_Rect bounds = testSpaceship.getCollisionBounds();
+    Rect bounds = testSpaceship.getCollisionBounds();
     EXPECT_EQ(bounds.x, 4); // drawBounds.x + COLLISION_BOX_MARGIN
     EXPECT_EQ(bounds.y, 4);
     EXPECT_EQ(bounds.w, 24); // 32 minus margin of 4 on both sides
     EXPECT_EQ(bounds.h, 24);
 }
 
+TEST_F(SpaceshipTest, TestDrawPositionInterpolatesTheLastStep)
+{
+    Spaceship ship(10, 20, 32, 32, 1.0f, 2.0f, 100.0f);
+    EXPECT_FLOAT_EQ(ship.getDrawPosition(0.5f).getY(), 20.0f); // no step yet
+
+    ship.updatePhysics();
+    ship.updatePhysics(); // from 21 to 23
+    EXPECT_FLOAT_EQ(ship.getDrawPosition(0.0f).getY(), 21.0f);
+    EXPECT_FLOAT_EQ(ship.getDrawPosition(0.25f).getY(), 21.5f);
+    EXPECT_EQ(ship.getDrawPosition(1.0f).getY(), ship.getPosY());
+    EXPECT_FLOAT_EQ(ship.getDrawPosition(0.5f).getX(), 10.0f);
+}
+
+TEST_F(SpaceshipTest, TestThrustFollowsTheNose)
+{
+    Spaceship ship(0, 0, 32, 32, 0.0f, 0.5f, 1.0f);
+    ship.thrustIncrease();
+    ship.rotate(90.0f);
+    ship.thrustIncrease();
+    ship.thrustIncrease(); // capped at 1
+    ship.updatePhysics();
+    EXPECT_EQ(ship.getVelX(), 1.0f);
+    EXPECT_EQ(ship.getVelY(), 0.0f);
+    EXPECT_EQ(ship.getFlightStats().thrustUnits, 1.0f);
+
+    // off the table too
+    ship.rotate(-44.5f);
+    ship.thrustDecay();
+    ship.updatePhysics();
+    EXPECT_NEAR(ship.getVelX(), 1.0f + 0.5f * std::sin(45.5f * 3.14159265f / 180.0f), 1e-6f);
+    EXPECT_NEAR(ship.getVelY(), -0.5f * std::cos(45.5f * 3.14159265f / 180.0f), 1e-6f);
+}
+
 TEST_F(SpaceshipTest, TestRotateBasic)
 {
     testSpaceship.rotate(45.0f);
@@ -112,8 +143,8 @@ TEST_F(SpaceshipTest, TestAlignVerticalBoundaryJustOver180)
 
 TEST_F(SpaceshipTest, TestTerrainCollision_TerrainInside)
 {
-    std::vector<std::vector<int>> terrain(50, std::vector<int>(50, 0));
-    terrain[10][10] = 1; // Place terrain within spaceship bounds
+    TerrainGrid terrain(50, 50);
+    terrain.set(10, 10, TERRAIN_ROCK); // Place terrain within spaceship bounds
 
     testSpaceship.rotate(135.0f);
     testSpaceship.thrustIncrease();
@@ -135,7 +166,7 @@ TEST_F(SpaceshipTest, TestTerrainCollision_TerrainInside)
 
 TEST_F(SpaceshipTest, TestTerrainCollision_NoCollision)
 {
-    std::vector<std::vector<int>> terrain(50, std::vector<int>(50, 0));
+    TerrainGrid terrain(50, 50);
 
     testSpaceship.rotate(135.0f);
     testSpaceship.thrustIncrease();
@@ -155,8 +186,8 @@ TEST_F(SpaceshipTest, TestTerrainCollision_NoCollision)
 
 TEST_F(SpaceshipTest, TestTerrainCollision_RightWallNoCollision)
 {
-    std::vector<std::vector<int>> terrain(50, std::vector<int>(50, 0));
-    terrain[10][32] = 1;
+    TerrainGrid terrain(50, 50);
+    terrain.set(32, 10, TERRAIN_ROCK);
     EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
 
     // move vertically down
@@ -177,8 +208,8 @@ TEST_F(SpaceshipTest, TestTerrainCollision_RightWallNoCollision)
 
 TEST_F(SpaceshipTest, TestTerrainCollision_RightWallCollision)
 {
-    std::vector<std::vector<int>> terrain(50, std::vector<int>(50, 0));
-    terrain[10][28] = 1;
+    TerrainGrid terrain(50, 50);
+    terrain.set(28, 10, TERRAIN_ROCK);
     EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
 
     // move right - hit wall
@@ -199,8 +230,8 @@ TEST_F(SpaceshipTest, TestTerrainCollision_RightWallCollision)
 
 TEST_F(SpaceshipTest, TestTerrainCollision_BottomWallNoCollision)
 {
-    std::vector<std::vector<int>> terrain(50, std::vector<int>(50, 0));
-    terrain[28][10] = 1;
+    TerrainGrid terrain(50, 50);
+    terrain.set(10, 28, TERRAIN_ROCK);
     EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
 
     testSpaceship.rotate(90.0f);
@@ -220,8 +251,8 @@ TEST_F(SpaceshipTest, TestTerrainCollision_BottomWallNoCollision)
 
 TEST_F(SpaceshipTest, TestTerrainCollision_BottomWallCollision)
 {
-    std::vector<std::vector<int>> terrain(50, std::vector<int>(50, 0));
-    terrain[28][10] = 1;
+    TerrainGrid terrain(50, 50);
+    terrain.set(10, 28, TERRAIN_ROCK);
     EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
 
     testSpaceship.rotate(180.0f);
@@ -241,8 +272,8 @@ TEST_F(SpaceshipTest, TestTerrainCollision_BottomWallCollision)
 
 TEST_F(SpaceshipTest, TestTerrainCollision_DiagonalWallCollision)
 {
-    std::vector<std::vector<int>> terrain(50, std::vector<int>(50, 0));
-    terrain[28][28] = 1;
+    TerrainGrid terrain(50, 50);
+    terrain.set(28, 28, TERRAIN_ROCK);
     EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
 
     // move right - hit wall
@@ -261,6 +292,214 @@ TEST_F(SpaceshipTest, TestTerrainCollision_DiagonalWallCollision)
     EXPECT_NEAR(testSpaceship.getPosY(), 0.0f, 1e-6);
 }
 
+TEST_F(SpaceshipTest, TestHeightmapCollision_NoCollision)
+{
+    TerrainHeightmap terrain(50, 50);
+    terrain.setColumn(10, 28, false); // just below the collision box
+    EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
+    EXPECT_FLOAT_EQ(testSpaceship.getPosY(), 0.0f);
+}
+
+TEST_F(SpaceshipTest, TestHeightmapCollision_FloorCollision)
+{
+    TerrainHeightmap terrain(50, 50);
+    terrain.setColumn(10, 28, false);
+
+    testSpaceship.rotate(180.0f);
+    testSpaceship.thrustIncrease();
+    testSpaceship.updatePhysics();
+
+    EXPECT_TRUE(testSpaceship.handleTerrainCollision(terrain));
+    EXPECT_NEAR(testSpaceship.getVelX(), 0.0f, 1e-6);
+    EXPECT_NEAR(testSpaceship.getVelY(), 0.0f, 1e-6);
+    EXPECT_NEAR(testSpaceship.getPosY(), 0.0f, 1e-6);
+}
+
+TEST_F(SpaceshipTest, TestHeightmapCollision_RightWallCollision)
+{
+    TerrainHeightmap terrain(50, 50);
+    terrain.setColumn(28, 10, false);
+    EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
+
+    testSpaceship.rotate(90.0f);
+    testSpaceship.thrustIncrease();
+    testSpaceship.updatePhysics();
+
+    EXPECT_TRUE(testSpaceship.handleTerrainCollision(terrain));
+    EXPECT_NEAR(testSpaceship.getPosX(), 0.0f, 1e-6);
+}
+
+TEST_F(SpaceshipTest, TestHeightmapCollision_LandingPadIsNotACrash)
+{
+    TerrainHeightmap terrain(50, 50);
+    for (size_t x = 0; x < 50; x++)
+    {
+        terrain.setColumn(x, 28, true);
+    }
+
+    testSpaceship.rotate(180.0f);
+    testSpaceship.thrustIncrease();
+    testSpaceship.updatePhysics();
+
+    EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
+    EXPECT_NEAR(testSpaceship.getVelY(), 0.0f, 1e-6);
+    EXPECT_NEAR(testSpaceship.getPosY(), 0.0f, 1e-6);
+}
+
+TEST_F(SpaceshipTest, TestHeightmapCollision_RockBesidePadIsACrash)
+{
+    TerrainHeightmap terrain(50, 50);
+    for (size_t x = 0; x < 50; x++)
+    {
+        terrain.setColumn(x, 28, x != 20);
+    }
+
+    testSpaceship.rotate(180.0f);
+    testSpaceship.thrustIncrease();
+    testSpaceship.updatePhysics();
+
+    EXPECT_TRUE(testSpaceship.handleTerrainCollision(terrain));
+}
+
+TEST_F(SpaceshipTest, TestSweptCollision_FastShipCannotTunnelThroughSpike)
+{
+    TerrainHeightmap terrain(400, 50);
+    terrain.setColumn(200, 10, false);
+
+    testSpaceship.rotate(90.0f);
+    for (int i = 0; i < 50; i++)
+    {
+        testSpaceship.thrustIncrease();
+    }
+
+    // stepping discretely the ship is either side of the spike and never inside it
+    Spaceship discrete { testSpaceship };
+    discrete.updatePhysics();
+    EXPECT_FALSE(discrete.handleTerrainCollision(terrain));
+    discrete.updatePhysics();
+    EXPECT_FALSE(discrete.handleTerrainCollision(terrain));
+    EXPECT_GT(discrete.getPosX(), 200.0f);
+
+    EXPECT_FALSE(testSpaceship.updatePhysics(TerrainQuery { terrain }));
+    EXPECT_TRUE(testSpaceship.updatePhysics(TerrainQuery { terrain }));
+    // the right edge of the collision box stops on the spike
+    EXPECT_NEAR(testSpaceship.getPosX() + 32.0f - COLLISION_BOX_MARGIN, 200.0f, 1e-3);
+    EXPECT_NEAR(testSpaceship.getVelX(), 0.0f, 1e-6);
+}
+
+TEST_F(SpaceshipTest, TestSweptCollision_FastDescentStopsOnPad)
+{
+    TerrainHeightmap terrain(50, 50);
+    for (size_t x = 0; x < 50; x++)
+    {
+        terrain.setColumn(x, 40, true);
+    }
+
+    testSpaceship.rotate(180.0f);
+    for (int i = 0; i < 50; i++)
+    {
+        testSpaceship.thrustIncrease();
+    }
+
+    // one step would carry the ship out of the bottom of the world
+    EXPECT_FALSE(testSpaceship.updatePhysics(TerrainQuery { terrain }));
+    EXPECT_NEAR(testSpaceship.getPosY() + 32.0f - COLLISION_BOX_MARGIN, 40.0f, 1e-3);
+    EXPECT_NEAR(testSpaceship.getVelY(), 0.0f, 1e-6);
+
+    // and it stays put while resting on the pad
+    EXPECT_FALSE(testSpaceship.updatePhysics(TerrainQuery { terrain }));
+    EXPECT_NEAR(testSpaceship.getPosY() + 32.0f - COLLISION_BOX_MARGIN, 40.0f, 1e-3);
+}
+
+namespace
+{
+// a 32 x 32 sprite that is only a 2 pixel wide upright bar down its middle
+SpriteMask makeBarMask()
+{
+    std::vector<std::uint8_t> opacity(32 * 32, 0);
+    for (size_t y = 4; y < 28; y++)
+    {
+        opacity[y * 32 + 15] = 1;
+        opacity[y * 32 + 16] = 1;
+    }
+    return SpriteMask(opacity.data(), 32, 32);
+}
+}
+
+TEST_F(SpaceshipTest, TestMaskCollision_EmptyCornerIsNotACrash)
+{
+    SpriteMask mask { makeBarMask() };
+    TerrainHeightmap terrain(50, 50);
+    terrain.setColumn(6, 10, false); // inside the box, beside the bar
+
+    EXPECT_TRUE(Spaceship { testSpaceship }.handleTerrainCollision(terrain));
+    testSpaceship.setCollisionMask(&mask);
+    EXPECT_FALSE(testSpaceship.handleTerrainCollision(terrain));
+    Rect bounds { testSpaceship.getCollisionBounds() };
+    EXPECT_EQ(bounds.x, 15);
+    EXPECT_EQ(bounds.w, 2);
+
+    // turned on its side the bar reaches the rock
+    testSpaceship.rotate(90.0f);
+    EXPECT_TRUE(testSpaceship.handleTerrainCollision(terrain));
+}
+
+TEST_F(SpaceshipTest, TestMaskCollision_GridRowsMatchHeightmapColumns)
+{
+    SpriteMask mask { makeBarMask() };
+    TerrainHeightmap heightmap(80, 50);
+    TerrainGrid grid(80, 50);
+    for (size_t x = 0; x < 80; x++)
+    {
+        int surface { 20 + static_cast<int>(x % 7) };
+        heightmap.setColumn(x, surface, x % 5 == 0);
+        for (size_t y = static_cast<size_t>(surface); y < 50; y++)
+        {
+            grid.set(x, y, x % 5 == 0 ? TERRAIN_LANDING_PAD : TERRAIN_ROCK);
+        }
+    }
+
+    // sweep the ship across the terrain at every angle and height, off both edges
+    for (int angle = 0; angle < 360; angle += 15)
+    {
+        for (int y = -10; y < 30; y += 3)
+        {
+            for (int x = -20; x < 80; x += 3)
+            {
+                Spaceship ship(x, y, 32, 32, 0.0f, 2.0f, 100.0f);
+                ship.setCollisionMask(&mask);
+                ship.rotate(static_cast<float>(angle));
+                Spaceship gridShip { ship };
+                EXPECT_EQ(ship.handleTerrainCollision(heightmap), gridShip.handleTerrainCollision(grid))
+                    << angle << " " << x << ", " << y;
+                EXPECT_EQ(ship.getPosY(), gridShip.getPosY());
+            }
+        }
+    }
+}
+
+TEST_F(SpaceshipTest, TestMaskCollision_SweptBarPassesBesideSpike)
+{
+    SpriteMask mask { makeBarMask() };
+    TerrainHeightmap terrain(50, 50);
+    terrain.setColumn(8, 5, false);
+    testSpaceship.setCollisionMask(&mask);
+    testSpaceship.rotate(180.0f);
+    for (int i = 0; i < 5; i++)
+    {
+        testSpaceship.thrustIncrease();
+    }
+
+    // the box would catch the spike, the bar falls past it
+    EXPECT_FALSE(testSpaceship.updatePhysics(TerrainQuery { terrain }));
+    EXPECT_NEAR(testSpaceship.getPosY(), 10.0f, 1e-3);
+
+    terrain.setColumn(16, 45, false);
+    EXPECT_TRUE(testSpaceship.updatePhysics(TerrainQuery { terrain }));
+    // the bottom of the bar stops on the rock
+    EXPECT_NEAR(testSpaceship.getPosY() + 28.0f, 45.0f, 1e-3);
+}
+
 // Parameterized test for boundary collision at different orientations
 class SpaceshipBoundaryCollisionTest : public SpaceshipTest, public ::testing::WithParamInterface<float>
 {
@@ -271,7 +510,7 @@ TEST_P(SpaceshipBoundaryCollisionTest, TestBoundaryCollisionAtOrientation)
     float angle = GetParam();
 
     // Start spaceship in center of slightly larger world (34x34 vs 32x32 spaceship)
-    testSpaceship = Spaceship(1, 1, &mockTexture, 0.0f, 4.0f, 100.0f);
+    testSpaceship = Spaceship(1, 1, 32, 32, 0.0f, 4.0f, 100.0f);
 
     // Verify no initial collision in 34x34 world
     EXPECT_FALSE(testSpaceship.handleBoundaryCollision(34, 34));
@@ -298,7 +537,7 @@ INSTANTIATE_TEST_SUITE_P(
 
 TEST_F(SpaceshipTest, TestBoundaryCollision_VerticalWall_OnlyXVelocityZeroed)
 {
-    testSpaceship = Spaceship(1, 40, &mockTexture, 0.0f, 4.0f, 100.0f);
+    testSpaceship = Spaceship(1, 40, 32, 32, 0.0f, 4.0f, 100.0f);
     EXPECT_FALSE(testSpaceship.handleBoundaryCollision(100, 100));
 
     // Create velocity in both X and Y directions
@@ -320,7 +559,7 @@ TEST_F(SpaceshipTest, TestBoundaryCollision_VerticalWall_OnlyXVelocityZeroed)
 
 TEST_F(SpaceshipTest, TestBoundaryCollision_HorizontalWall_OnlyYVelocityZeroed)
 {
-    testSpaceship = Spaceship(40, 1, &mockTexture, 0.0f, 4.0f, 100.0f);
+    testSpaceship = Spaceship(40, 1, 32, 32, 0.0f, 4.0f, 100.0f);
     EXPECT_FALSE(testSpaceship.handleBoundaryCollision(100, 100));
 
     // Create velocity in both X and Y directions
@@ -342,7 +581,7 @@ TEST_F(SpaceshipTest, TestBoundaryCollision_HorizontalWall_OnlyYVelocityZeroed)
 
 TEST_F(SpaceshipTest, TestBoundaryCollision_Corner_BothVelocitiesZeroed)
 {
-    testSpaceship = Spaceship(1, 1, &mockTexture, 0.0f, 4.0f, 100.0f);
+    testSpaceship = Spaceship(1, 1, 32, 32, 0.0f, 4.0f, 100.0f);
     EXPECT_FALSE(testSpaceship.handleBoundaryCollision(40, 40));
 
     // Create velocity in both X and Y directions
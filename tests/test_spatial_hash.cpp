@@ -0,0 +1,80 @@
+#include "engine/SpatialHash.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+TEST(SpatialHashTest, TestQueryReportsEachOverlapOnce)
+{
+    SpatialHash hash(16);
+    size_t large { hash.add({ 0, 0, 100, 100 }) }; // spans many cells
+    size_t small { hash.add({ 40, 40, 4, 4 }) };
+    hash.add({ 200, 200, 10, 10 });
+    hash.add({ 10, 10, 0, 5 }); // no area
+    hash.build();
+
+    std::vector<size_t> found {};
+    hash.query({ 30, 30, 50, 50 }, [&](const size_t id) { found.push_back(id); });
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, (std::vector<size_t> { large, small }));
+    EXPECT_FALSE(SpatialHash::overlaps({ 10, 10, 0, 5 }, { 0, 0, 100, 100 }));
+
+    // touching edges do not overlap
+    found.clear();
+    hash.query({ 100, 0, 10, 10 }, [&](const size_t id) { found.push_back(id); });
+    EXPECT_TRUE(found.empty());
+}
+
+TEST(SpatialHashTest, TestNegativeCoordinates)
+{
+    SpatialHash hash(16);
+    hash.add({ -20, -20, 8, 8 });
+    hash.add({ -1, -1, 2, 2 });
+    hash.build();
+
+    size_t count { 0 };
+    hash.query({ -14, -14, 1, 1 }, [&](const size_t) { count++; });
+    EXPECT_EQ(count, 1u);
+    count = 0;
+    hash.query({ 0, 0, 1, 1 }, [&](const size_t) { count++; });
+    EXPECT_EQ(count, 1u);
+}
+
+TEST(SpatialHashTest, TestPairsMatchBruteForce)
+{
+    std::mt19937 rng { 3 };
+    std::uniform_int_distribution<int> position(-500, 500);
+    std::uniform_int_distribution<int> size(0, 80); // some without area
+    SpatialHash hash(32);
+    std::vector<Rect> boxes {};
+    for (int frame = 0; frame < 3; frame++)
+    {
+        // rebuilt each frame, as the engine does
+        hash.clear();
+        boxes.clear();
+        for (int i = 0; i < 300; i++)
+        {
+            boxes.push_back({ position(rng), position(rng), size(rng), size(rng) });
+            EXPECT_EQ(hash.add(boxes.back()), static_cast<size_t>(i));
+        }
+        hash.build();
+
+        std::vector<std::pair<size_t, size_t>> expected {};
+        for (size_t a = 0; a < boxes.size(); a++)
+        {
+            for (size_t b = a + 1; b < boxes.size(); b++)
+            {
+                if (SpatialHash::overlaps(boxes[a], boxes[b]))
+                {
+                    expected.push_back({ a, b });
+                }
+            }
+        }
+        std::vector<std::pair<size_t, size_t>> pairs {};
+        hash.forEachPair([&](const size_t a, const size_t b) { pairs.push_back({ a, b }); });
+        std::sort(pairs.begin(), pairs.end());
+        EXPECT_EQ(pairs, expected);
+        EXPECT_GT(expected.size(), 20u);
+    }
+}
@@ -0,0 +1,83 @@
+#include "engine/SpriteMask.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+// a 10 x 4 sprite, opaque in a horizontal bar along rows 1 and 2
+std::vector<std::uint8_t> makeBar()
+{
+    std::vector<std::uint8_t> opacity(10 * 4, 0);
+    for (int x = 0; x < 10; x++)
+    {
+        opacity[static_cast<size_t>(10 + x)] = 1;
+        opacity[static_cast<size_t>(20 + x)] = 1;
+    }
+    return opacity;
+}
+}
+
+TEST(SpriteMaskTest, TestUnrotatedFrameMatchesSprite)
+{
+    std::vector<std::uint8_t> opacity { makeBar() };
+    SpriteMask mask(opacity.data(), 10, 4);
+    ASSERT_FALSE(mask.isEmpty());
+    EXPECT_GE(mask.getFrameSize(), 11);
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 10; x++)
+        {
+            EXPECT_EQ(mask.isOpaque(0, x - mask.getOffsetX(), y - mask.getOffsetY()), opacity[static_cast<size_t>(y * 10 + x)] != 0)
+                << x << ", " << y;
+        }
+    }
+
+    Rect bounds { mask.getBounds(0) };
+    EXPECT_EQ(bounds.x, 0);
+    EXPECT_EQ(bounds.y, 1);
+    EXPECT_EQ(bounds.w, 10);
+    EXPECT_EQ(bounds.h, 2);
+}
+
+TEST(SpriteMaskTest, TestQuarterTurnStandsTheBarUp)
+{
+    std::vector<std::uint8_t> opacity { makeBar() };
+    SpriteMask mask(opacity.data(), 10, 4);
+
+    // turned about the sprite centre at 5, 2
+    Rect bounds { mask.getBounds(90) };
+    EXPECT_EQ(bounds.x, 4);
+    EXPECT_EQ(bounds.y, -3);
+    EXPECT_EQ(bounds.w, 2);
+    EXPECT_EQ(bounds.h, 10);
+    EXPECT_EQ(mask.getBounds(270).w, 2);
+    EXPECT_EQ(mask.getBounds(270).h, 10);
+}
+
+TEST(SpriteMaskTest, TestColumnsSpanTheOpaquePixels)
+{
+    std::vector<std::uint8_t> opacity { makeBar() };
+    SpriteMask mask(opacity.data(), 10, 4);
+    const MaskColumn* columns { mask.columnData(0) };
+    for (int x = 0; x < mask.getFrameSize(); x++)
+    {
+        int spriteX { x + mask.getOffsetX() };
+        if (spriteX >= 0 && spriteX < 10)
+        {
+            EXPECT_EQ(columns[x].top + mask.getOffsetY(), 1);
+            EXPECT_EQ(columns[x].bottom + mask.getOffsetY(), 3);
+        }
+        else
+        {
+            EXPECT_EQ(columns[x].top, columns[x].bottom);
+        }
+    }
+}
+
+TEST(SpriteMaskTest, TestAngleIndex)
+{
+    EXPECT_EQ(SpriteMask::angleIndex(0.0f), 0);
+    EXPECT_EQ(SpriteMask::angleIndex(44.6f), 45);
+    EXPECT_EQ(SpriteMask::angleIndex(359.7f), 0);
+    EXPECT_EQ(SpriteMask::angleIndex(-1.0f), 359);
+}
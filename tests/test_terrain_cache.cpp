@@ -0,0 +1,133 @@
+#include "TestWorlds.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainCache.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class TerrainCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        mDirectory = (std::filesystem::temp_directory_path() / ("terrain_cache_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()))).string();
+        std::filesystem::remove_all(mDirectory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mDirectory);
+    }
+
+    std::string mDirectory;
+};
+
+TEST_F(TerrainCacheTest, TestRoundTrip)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(11, 2000) };
+    TerrainCache cache { mDirectory };
+
+    TerrainHeightmap generated {};
+    std::vector<TerrainGenerator::PadInterval> generatedPads {};
+    EXPECT_FALSE(cache.loadOrGenerate(config, 8, generated, generatedPads));
+    EXPECT_TRUE(std::filesystem::exists(cache.pathFor(config, 8)));
+
+    TerrainHeightmap loaded {};
+    std::vector<TerrainGenerator::PadInterval> loadedPads {};
+    ASSERT_TRUE(cache.load(config, 8, loaded, loadedPads));
+    ASSERT_EQ(loaded.getWidth(), generated.getWidth());
+    ASSERT_EQ(loaded.getHeight(), generated.getHeight());
+    for (size_t x = 0; x < generated.getWidth(); x++)
+    {
+        ASSERT_EQ(loaded.getSurface(x), generated.getSurface(x)) << "x=" << x;
+        ASSERT_EQ(loaded.isLandingPad(x), generated.isLandingPad(x)) << "x=" << x;
+    }
+    ASSERT_EQ(loadedPads.size(), generatedPads.size());
+    EXPECT_GT(loadedPads.size(), 0u);
+    for (size_t i = 0; i < loadedPads.size(); i++)
+    {
+        EXPECT_EQ(loadedPads[i].start, generatedPads[i].start);
+        EXPECT_EQ(loadedPads[i].width, generatedPads[i].width);
+    }
+}
+
+TEST_F(TerrainCacheTest, TestGeneratesFromTheConfigSeed)
+{
+    // the file is named after config.seed, so what is saved in it must be that seed's world
+    TerrainGenerationConfig config { makeTestWorldConfig(11, 2000) };
+    TerrainCache cache { mDirectory };
+    TerrainHeightmap cached {};
+    std::vector<TerrainGenerator::PadInterval> pads {};
+    cache.loadOrGenerate(config, 8, cached, pads);
+
+    TerrainGenerator generator { config.seed };
+    TerrainHeightmap expected {};
+    generator.generateTerrain(expected, config, 8);
+    ASSERT_EQ(cached.getWidth(), expected.getWidth());
+    for (size_t x = 0; x < expected.getWidth(); x++)
+    {
+        ASSERT_EQ(cached.getSurface(x), expected.getSurface(x)) << "x=" << x;
+    }
+}
+
+TEST_F(TerrainCacheTest, TestConfigChangesMissTheCache)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(11, 2000) };
+    TerrainCache cache { mDirectory };
+    TerrainHeightmap terrain {};
+    std::vector<TerrainGenerator::PadInterval> pads {};
+    cache.loadOrGenerate(config, 8, terrain, pads);
+
+    EXPECT_FALSE(cache.load(config, 9, terrain, pads));
+    EXPECT_FALSE(cache.load(makeTestWorldConfig(12, 2000), 8, terrain, pads));
+    TerrainGenerationConfig rougher { config };
+    rougher.persistence = 0.6;
+    EXPECT_NE(TerrainCache::configHash(rougher, 8), TerrainCache::configHash(config, 8));
+    EXPECT_FALSE(cache.load(rougher, 8, terrain, pads));
+    EXPECT_TRUE(cache.load(config, 8, terrain, pads));
+}
+
+TEST_F(TerrainCacheTest, TestTruncatedFileIsRejected)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(11, 2000) };
+    TerrainCache cache { mDirectory };
+    TerrainHeightmap terrain {};
+    std::vector<TerrainGenerator::PadInterval> pads {};
+    cache.loadOrGenerate(config, 8, terrain, pads);
+
+    std::string path { cache.pathFor(config, 8) };
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(cache.load(config, 8, terrain, pads));
+}
+
+TEST_F(TerrainCacheTest, TestConcurrentSavesOfOneWorld)
+{
+    // as lander_rollouts workers or two games caching the same seed do
+    TerrainGenerationConfig config { makeTestWorldConfig(11, 2000) };
+    TerrainCache cache { mDirectory };
+    TerrainGenerator generator { config.seed };
+    TerrainHeightmap generated {};
+    generator.generateTerrain(generated, config, 8);
+    std::vector<TerrainGenerator::PadInterval> generatedPads { generator.getLandingPads() };
+
+    std::vector<std::thread> savers {};
+    for (int i = 0; i < 8; i++)
+    {
+        savers.emplace_back([&]() { EXPECT_TRUE(cache.save(config, 8, generated, generatedPads)); });
+    }
+    for (std::thread& saver : savers)
+    {
+        saver.join();
+    }
+
+    TerrainHeightmap loaded {};
+    std::vector<TerrainGenerator::PadInterval> loadedPads {};
+    ASSERT_TRUE(cache.load(config, 8, loaded, loadedPads));
+    EXPECT_EQ(loadedPads.size(), generatedPads.size());
+    for (const auto& entry : std::filesystem::directory_iterator(mDirectory))
+    {
+        EXPECT_NE(entry.path().extension(), ".tmp") << entry.path();
+    }
+}
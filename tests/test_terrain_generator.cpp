@@ -0,0 +1,140 @@
+#include "TestWorlds.h"
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/LatticeNoise1D.h"
+#include "lunar_lander/PhysicsScalar.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+
+namespace
+{
+// The original strictly serial column by column walk, kept as the reference for a given seed.
+// Fixed point builds draw from the engine and take the lattice noise instead
+TerrainHeightmap generateSerialReference(const TerrainGenerationConfig& config, const int averageNumberOfLandingPads)
+{
+    PerlinNoise1D noise { config.seed };
+    LatticeNoise1D latticeNoise { config.seed };
+    std::mt19937 rng { config.seed };
+    double padProbability { static_cast<double>(averageNumberOfLandingPads) / static_cast<double>(config.worldWidth) };
+    TerrainHeightmap terrain(config.worldWidth, config.worldHeight);
+    auto surfaceFor = [&](const int height) { return static_cast<int>(config.worldHeight) - height + 1; };
+
+    size_t noiseX { 0 };
+    size_t terrainX { 0 };
+    int terrainHeight { config.startHeight };
+    while (terrainX < config.worldWidth)
+    {
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        double draw { FIXED_POINT_PHYSICS ? static_cast<double>(rng()) / 4294967296.0 : chance(rng) };
+        if (draw < padProbability && terrainX + MAX_LANDING_PAD_WIDTH < config.worldWidth)
+        {
+            std::uniform_int_distribution<int> widthDist(MIN_LANDING_PAD_WIDTH, MAX_LANDING_PAD_WIDTH);
+            size_t padWidth { FIXED_POINT_PHYSICS
+                ? MIN_LANDING_PAD_WIDTH + rng() % (MAX_LANDING_PAD_WIDTH - MIN_LANDING_PAD_WIDTH + 1)
+                : static_cast<size_t>(widthDist(rng)) };
+            for (size_t i = 0; i != padWidth; i++)
+            {
+                terrain.setColumn(terrainX + i, surfaceFor(terrainHeight), true);
+            }
+            terrainX += padWidth;
+        }
+        else
+        {
+            if (FIXED_POINT_PHYSICS)
+            {
+                std::int64_t noiseValue { latticeNoise.octaveNoise(noiseX, config.octaves, config.persistence, config.scale) };
+                terrainHeight = config.startHeight + static_cast<int>(noiseValue * config.heightVariation / LatticeNoise1D::ONE);
+            }
+            else
+            {
+                double noiseValue { noise.octaveNoise(static_cast<double>(noiseX), config.octaves, config.persistence, config.scale) };
+                terrainHeight = config.startHeight + static_cast<int>(noiseValue * config.heightVariation);
+            }
+            terrain.setColumn(terrainX, surfaceFor(terrainHeight), false);
+            terrainX++;
+            noiseX++;
+        }
+    }
+    return terrain;
+}
+}
+
+class TerrainGeneratorSeedTest : public ::testing::TestWithParam<unsigned int>
+{
+};
+
+TEST_P(TerrainGeneratorSeedTest, TestMatchesSerialReference)
+{
+    // plenty of landing pads, including back to back ones
+    TerrainGenerationConfig config { makeTestWorldConfig(GetParam(), static_cast<size_t>(WORLD_WIDTH)) };
+    const int landingPads { 60 };
+
+    TerrainHeightmap expected { generateSerialReference(config, landingPads) };
+    TerrainHeightmap actual {};
+    TerrainGenerator generator { config.seed };
+    generator.generateTerrain(actual, config, landingPads);
+
+    ASSERT_EQ(actual.getWidth(), expected.getWidth());
+    size_t padColumns { 0 };
+    for (size_t x = 0; x < expected.getWidth(); x++)
+    {
+        ASSERT_EQ(actual.getSurface(x), expected.getSurface(x)) << "x=" << x;
+        ASSERT_EQ(actual.isLandingPad(x), expected.isLandingPad(x)) << "x=" << x;
+        padColumns += expected.isLandingPad(x);
+    }
+    EXPECT_GT(padColumns, 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Seeds,
+    TerrainGeneratorSeedTest,
+    ::testing::Values(0u, 1u, 42u, 123456789u));
+
+TEST(TerrainGeneratorTest, TestGridMatchesRasterizedHeightmap)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(7, 500) };
+    TerrainHeightmap heightmap {};
+    TerrainGenerator { config.seed }.generateTerrain(heightmap, config, 2);
+    TerrainGrid grid {};
+    TerrainGenerator { config.seed }.generateTerrain(grid, config, 2);
+
+    for (size_t x = 0; x < heightmap.getWidth(); x++)
+    {
+        size_t surface { static_cast<size_t>(heightmap.getSurface(x)) };
+        EXPECT_EQ(grid.at(x, surface - 1), TERRAIN_VACUUM);
+        EXPECT_EQ(grid.at(x, surface), heightmap.getColumnType(x));
+        EXPECT_EQ(grid.at(x, grid.getHeight() - 1), heightmap.getColumnType(x));
+    }
+}
+
+TEST(TerrainGeneratorTest, TestRasterizeTerrainPixels)
+{
+    TerrainHeightmap terrain(4, 8);
+    terrain.setColumn(0, 3, false);
+    terrain.setColumn(1, 5, true); // odd pad column, single horizon pixel
+    terrain.setColumn(2, 5, true); // even pad column, thick horizon
+    // column 3 is left empty
+
+    std::vector<std::uint32_t> pixels {};
+    TerrainGenerator::rasterizeTerrainPixels(terrain, pixels);
+    ASSERT_EQ(pixels.size(), 32u);
+    auto pixel = [&](const size_t x, const size_t y) { return pixels[y * 4 + x]; };
+
+    EXPECT_EQ(pixel(0, 2), TerrainGenerator::PIXEL_TRANSPARENT);
+    EXPECT_EQ(pixel(0, 3), TerrainGenerator::PIXEL_HORIZON);
+    EXPECT_EQ(pixel(0, 4), TerrainGenerator::PIXEL_FOREGROUND);
+    EXPECT_EQ(pixel(0, 7), TerrainGenerator::PIXEL_FOREGROUND);
+
+    EXPECT_EQ(pixel(1, 5), TerrainGenerator::PIXEL_HORIZON);
+    EXPECT_EQ(pixel(1, 6), TerrainGenerator::PIXEL_FOREGROUND);
+
+    EXPECT_EQ(pixel(2, 4), TerrainGenerator::PIXEL_TRANSPARENT);
+    EXPECT_EQ(pixel(2, 5), TerrainGenerator::PIXEL_HORIZON);
+    EXPECT_EQ(pixel(2, 6), TerrainGenerator::PIXEL_HORIZON);
+    EXPECT_EQ(pixel(2, 7), TerrainGenerator::PIXEL_FOREGROUND);
+
+    for (size_t y = 0; y < 8; y++)
+    {
+        EXPECT_EQ(pixel(3, y), TerrainGenerator::PIXEL_TRANSPARENT);
+    }
+}
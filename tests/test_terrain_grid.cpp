@@ -0,0 +1,124 @@
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainGrid.h"
+#include <gtest/gtest.h>
+
+TEST(TerrainGridTest, TestNewGridIsVacuum)
+{
+    TerrainGrid grid(70, 3);
+    for (size_t y = 0; y < grid.getHeight(); y++)
+    {
+        for (size_t x = 0; x < grid.getWidth(); x++)
+        {
+            EXPECT_EQ(grid.at(x, y), TERRAIN_VACUUM);
+        }
+    }
+}
+
+TEST(TerrainGridTest, TestRowStrideRoundsUpToWholeWords)
+{
+    TerrainGrid grid(70, 3);
+    EXPECT_EQ(grid.getRowStride(), 3u); // 70 cells at 32 cells per word
+    EXPECT_EQ(grid.getMemoryFootprint(), 3u * 3u * sizeof(std::uint64_t));
+}
+
+TEST(TerrainGridTest, TestSetDoesNotDisturbNeighbours)
+{
+    TerrainGrid grid(70, 3);
+    grid.set(31, 1, TERRAIN_LANDING_PAD);
+    grid.set(32, 1, TERRAIN_ROCK);
+    grid.set(33, 1, TERRAIN_LANDING_PAD);
+
+    EXPECT_EQ(grid.at(30, 1), TERRAIN_VACUUM);
+    EXPECT_EQ(grid.at(31, 1), TERRAIN_LANDING_PAD);
+    EXPECT_EQ(grid.at(32, 1), TERRAIN_ROCK);
+    EXPECT_EQ(grid.at(33, 1), TERRAIN_LANDING_PAD);
+    EXPECT_EQ(grid.at(32, 0), TERRAIN_VACUUM);
+    EXPECT_EQ(grid.at(32, 2), TERRAIN_VACUUM);
+
+    // overwrite a cell with a smaller value
+    grid.set(31, 1, TERRAIN_ROCK);
+    EXPECT_EQ(grid.at(31, 1), TERRAIN_ROCK);
+}
+
+TEST(TerrainGridTest, TestResizeClearsCells)
+{
+    TerrainGrid grid(10, 10);
+    grid.set(5, 5, TERRAIN_ROCK);
+    grid.resize(10, 10);
+    EXPECT_EQ(grid.at(5, 5), TERRAIN_VACUUM);
+}
+
+TEST(TerrainGridTest, TestMatchCellsAcrossWords)
+{
+    TerrainGrid grid(70, 2);
+    grid.set(3, 1, TERRAIN_ROCK);
+    grid.set(31, 1, TERRAIN_ROCK);
+    grid.set(32, 1, TERRAIN_LANDING_PAD);
+    grid.set(69, 1, TERRAIN_ROCK);
+
+    EXPECT_EQ(grid.matchCells(0, 1, TERRAIN_ROCK), (std::uint64_t { 1 } << 3) | (std::uint64_t { 1 } << 31));
+    EXPECT_EQ(grid.matchCells(0, 1, TERRAIN_LANDING_PAD), std::uint64_t { 1 } << 32);
+    EXPECT_EQ(grid.matchCells(0, 0, TERRAIN_ROCK), 0u);
+
+    // unaligned, straddling words and running off the end of the row
+    EXPECT_EQ(grid.matchCells(30, 1, TERRAIN_ROCK), (std::uint64_t { 1 } << 1) | (std::uint64_t { 1 } << 39));
+    EXPECT_EQ(grid.matchCells(30, 1, TERRAIN_VACUUM), (~std::uint64_t { 0 } >> 24) & ~std::uint64_t { 0x8000000006 });
+    EXPECT_EQ(grid.matchCells(70, 1, TERRAIN_VACUUM), 0u);
+}
+
+TEST(TerrainGridTest, TestPyramidCountsFollowSet)
+{
+    TerrainGrid grid(70, 20);
+    EXPECT_EQ(grid.getPyramidLevelCount(), 5u); // 9 x 3, 5 x 2, 3 x 1, 2 x 1, 1 x 1 blocks
+    EXPECT_TRUE(grid.isVacuum(0, 0, 70, 20));
+
+    grid.set(65, 17, TERRAIN_ROCK);
+    grid.set(66, 17, TERRAIN_LANDING_PAD);
+    grid.set(66, 17, TERRAIN_ROCK); // solid to solid is not counted again
+    EXPECT_EQ(grid.getSolidCount(0, 8, 2), 2u);
+    EXPECT_EQ(grid.getSolidCount(1, 4, 1), 2u);
+    EXPECT_EQ(grid.getSolidCount(4, 0, 0), 2u);
+    EXPECT_FALSE(grid.isVacuum(0, 0, 70, 20));
+    EXPECT_FALSE(grid.isVacuum(60, 16, 8, 4));
+
+    // rectangles clear of the cells, down to block precision
+    EXPECT_TRUE(grid.isVacuum(0, 0, 64, 20));
+    EXPECT_TRUE(grid.isVacuum(0, 0, 70, 16));
+    EXPECT_TRUE(grid.isVacuum(100, 0, 10, 10));
+
+    grid.set(65, 17, TERRAIN_VACUUM);
+    grid.set(66, 17, TERRAIN_VACUUM);
+    EXPECT_EQ(grid.getSolidCount(4, 0, 0), 0u);
+    EXPECT_TRUE(grid.isVacuum(0, 0, 70, 20));
+}
+
+TEST(TerrainGridTest, TestRebuiltPyramidMatchesIncremental)
+{
+    TerrainGrid incremental(300, 90);
+    TerrainGrid rebuilt(300, 90);
+    for (size_t x = 0; x < 300; x++)
+    {
+        for (size_t y = 40 + x % 37; y < 90; y++)
+        {
+            TerrainCell cell { x % 11 == 0 ? TERRAIN_LANDING_PAD : TERRAIN_ROCK };
+            incremental.set(x, y, cell);
+            rebuilt.rowData(y)[x / TerrainGrid::CELLS_PER_WORD] |= std::uint64_t { cell } << ((x % TerrainGrid::CELLS_PER_WORD) * TerrainGrid::BITS_PER_CELL);
+        }
+    }
+    rebuilt.rebuildPyramid();
+
+    ASSERT_EQ(rebuilt.getPyramidLevelCount(), incremental.getPyramidLevelCount());
+    for (size_t level = 0; level < rebuilt.getPyramidLevelCount(); level++)
+    {
+        size_t side { TerrainGrid::PYRAMID_BLOCK << level };
+        for (size_t y = 0; y < (90 + side - 1) / side; y++)
+        {
+            for (size_t x = 0; x < (300 + side - 1) / side; x++)
+            {
+                EXPECT_EQ(rebuilt.getSolidCount(level, x, y), incremental.getSolidCount(level, x, y)) << level << ": " << x << ", " << y;
+            }
+        }
+    }
+    // every column is solid for 50 - x % 37 rows
+    EXPECT_EQ(rebuilt.getSolidCount(rebuilt.getPyramidLevelCount() - 1, 0, 0), 9666u);
+}
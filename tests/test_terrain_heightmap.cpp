@@ -0,0 +1,90 @@
+#include "lunar_lander/Constants.h"
+#include "lunar_lander/TerrainHeightmap.h"
+#include <gtest/gtest.h>
+
+TEST(TerrainHeightmapTest, TestNewHeightmapIsEmpty)
+{
+    TerrainHeightmap terrain(20, 10);
+    for (size_t x = 0; x < terrain.getWidth(); x++)
+    {
+        EXPECT_EQ(terrain.getSurface(x), 10);
+        EXPECT_FALSE(terrain.isLandingPad(x));
+    }
+}
+
+TEST(TerrainHeightmapTest, TestSetColumnClampsToWorld)
+{
+    TerrainHeightmap terrain(20, 10);
+    terrain.setColumn(0, -5, false);
+    terrain.setColumn(1, 15, false);
+    EXPECT_EQ(terrain.getSurface(0), 0);
+    EXPECT_EQ(terrain.getSurface(1), 10);
+}
+
+TEST(TerrainHeightmapTest, TestRasterizeFillsBelowSurface)
+{
+    TerrainHeightmap terrain(3, 10);
+    terrain.setColumn(0, 4, false);
+    terrain.setColumn(1, 7, true);
+
+    TerrainGrid grid {};
+    terrain.rasterize(grid);
+    ASSERT_EQ(grid.getWidth(), 3u);
+    ASSERT_EQ(grid.getHeight(), 10u);
+    for (size_t y = 0; y < 10; y++)
+    {
+        EXPECT_EQ(grid.at(0, y), y >= 4 ? TERRAIN_ROCK : TERRAIN_VACUUM);
+        EXPECT_EQ(grid.at(1, y), y >= 7 ? TERRAIN_LANDING_PAD : TERRAIN_VACUUM);
+        EXPECT_EQ(grid.at(2, y), TERRAIN_VACUUM);
+    }
+}
+
+TEST(TerrainHeightmapTest, TestRasterizeMatchesColumnsForPartialWords)
+{
+    // a width that is not a whole number of words, with surfaces spread over the full height
+    TerrainHeightmap terrain(77, 40);
+    for (size_t x = 0; x < terrain.getWidth(); x++)
+    {
+        terrain.setColumn(x, static_cast<int>((x * 7) % 41), x % 5 == 0);
+    }
+
+    TerrainGrid grid {};
+    terrain.rasterize(grid);
+    for (size_t x = 0; x < terrain.getWidth(); x++)
+    {
+        for (size_t y = 0; y < terrain.getHeight(); y++)
+        {
+            TerrainCell expected { static_cast<int>(y) >= terrain.getSurface(x) ? terrain.getColumnType(x) : TERRAIN_VACUUM };
+            EXPECT_EQ(grid.at(x, y), expected) << "x=" << x << " y=" << y;
+        }
+    }
+}
+
+TEST(TerrainHeightmapTest, TestMinSurface)
+{
+    TerrainHeightmap terrain(5, 20);
+    EXPECT_EQ(terrain.getMinSurface(), 20);
+    terrain.setColumn(1, 12, false);
+    terrain.setColumn(3, 7, true);
+    EXPECT_EQ(terrain.getMinSurface(), 7);
+    EXPECT_EQ(TerrainHeightmap().getMinSurface(), 0);
+}
+
+TEST(TerrainHeightmapTest, TestRangeMinSurfaceFollowsSetColumn)
+{
+    TerrainHeightmap terrain(200, 100);
+    terrain.setColumn(10, 50, false);
+    terrain.setColumn(70, 30, false);
+    terrain.setColumn(150, 40, false);
+    EXPECT_EQ(terrain.getMinSurface(), 30);
+    EXPECT_EQ(terrain.getMinSurface(0, 64), 50);
+    EXPECT_EQ(terrain.getMinSurface(11, 70), 100);
+    EXPECT_EQ(terrain.getMinSurface(11, 71), 30);
+    EXPECT_EQ(terrain.getMinSurface(128, 200), 40);
+    EXPECT_EQ(terrain.getMinSurface(0, 1000), 30);
+
+    // lowering the column that held a block up rescans the block
+    terrain.setColumn(70, 90, false);
+    EXPECT_EQ(terrain.getMinSurface(64, 128), 90);
+    EXPECT_EQ(terrain.getMinSurface(), 40);
+}
@@ -0,0 +1,261 @@
+#include "TestWorlds.h"
+#include "lunar_lander/TerrainGenerator.h"
+#include "lunar_lander/TerrainQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+namespace
+{
+// surfaces 8, 8, 3, 8, empty, 6 in a 6 x 10 world, column 5 a landing pad
+TerrainHeightmap makeTerrain()
+{
+    TerrainHeightmap terrain(6, 10);
+    terrain.setColumn(0, 8, false);
+    terrain.setColumn(1, 8, false);
+    terrain.setColumn(2, 3, false);
+    terrain.setColumn(3, 8, false);
+    terrain.setColumn(5, 6, true);
+    return terrain;
+}
+
+// marches along the ray in tiny steps
+float marchReference(const TerrainHeightmap& terrain, const Vector2D& origin, const Vector2D& direction, const float maxDistance)
+{
+    float length { std::hypot(direction.getX(), direction.getY()) };
+    constexpr float STEP { 0.01f };
+    for (float t = 0.0f; t <= maxDistance; t += STEP)
+    {
+        float x { origin.getX() + direction.getX() / length * t };
+        float y { origin.getY() + direction.getY() / length * t };
+        if (x >= 0.0f && x < static_cast<float>(terrain.getWidth()) && y < static_cast<float>(terrain.getHeight())
+            && y >= static_cast<float>(terrain.getSurface(static_cast<size_t>(x))))
+        {
+            return t;
+        }
+    }
+    return -1.0f;
+}
+
+// the overlap test the swept box must agree with
+bool boxOverlaps(const TerrainHeightmap& terrain, const float x, const float y, const float width, const float height)
+{
+    size_t first { static_cast<size_t>(std::max(0.0f, std::floor(x))) };
+    size_t last { std::min(terrain.getWidth(), static_cast<size_t>(std::max(0.0f, std::ceil(x + width)))) };
+    for (size_t column = first; column < last; column++)
+    {
+        float surface { static_cast<float>(terrain.getSurface(column)) };
+        if (x < static_cast<float>(column + 1) && x + width > static_cast<float>(column)
+            && y + height > surface && y < static_cast<float>(terrain.getHeight()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+TEST(TerrainQueryTest, TestAltitude)
+{
+    TerrainHeightmap terrain { makeTerrain() };
+    TerrainQuery query { terrain };
+    EXPECT_FLOAT_EQ(query.altitude(0.5f, 2.0f), 6.0f);
+    EXPECT_FLOAT_EQ(query.altitude(2.9f, 5.0f), -2.0f);
+    EXPECT_FLOAT_EQ(query.altitude(4.5f, 2.0f), 8.0f); // empty column, down to the bottom of the world
+    EXPECT_TRUE(std::isnan(query.altitude(-1.0f, 2.0f)));
+    EXPECT_TRUE(std::isnan(query.altitude(6.0f, 2.0f)));
+}
+
+TEST(TerrainQueryTest, TestStraightDown)
+{
+    TerrainHeightmap terrain { makeTerrain() };
+    RayHit hit { TerrainQuery(terrain).raycast(Vector2D { 5.5f, 1.0f }, Vector2D { 0.0f, 2.0f }, 100.0f) };
+    ASSERT_TRUE(hit.hit);
+    EXPECT_FLOAT_EQ(hit.distance, 5.0f);
+    EXPECT_FLOAT_EQ(hit.point.getY(), 6.0f);
+    EXPECT_EQ(hit.column, 5u);
+    EXPECT_TRUE(hit.landingPad);
+
+    // too short to reach
+    EXPECT_FALSE(TerrainQuery(terrain).raycast(Vector2D { 5.5f, 1.0f }, Vector2D { 0.0f, 1.0f }, 4.9f).hit);
+    // straight up never hits
+    EXPECT_FALSE(TerrainQuery(terrain).raycast(Vector2D { 5.5f, 1.0f }, Vector2D { 0.0f, -1.0f }, 100.0f).hit);
+}
+
+TEST(TerrainQueryTest, TestHorizontalRayHitsCliffFace)
+{
+    TerrainHeightmap terrain { makeTerrain() };
+    TerrainQuery query { terrain };
+
+    RayHit hit { query.raycast(Vector2D { 0.25f, 5.0f }, Vector2D { 1.0f, 0.0f }, 100.0f) };
+    ASSERT_TRUE(hit.hit);
+    EXPECT_EQ(hit.column, 2u);
+    EXPECT_FLOAT_EQ(hit.point.getX(), 2.0f);
+    EXPECT_FLOAT_EQ(hit.distance, 1.75f);
+
+    hit = query.raycast(Vector2D { 5.5f, 5.0f }, Vector2D { -1.0f, 0.0f }, 100.0f);
+    ASSERT_TRUE(hit.hit);
+    EXPECT_EQ(hit.column, 2u);
+    EXPECT_FLOAT_EQ(hit.point.getX(), 3.0f);
+
+    // passes over the empty column and out of the world
+    EXPECT_FALSE(query.raycast(Vector2D { 3.5f, 5.5f }, Vector2D { 1.0f, 0.0f }, 100.0f).hit);
+}
+
+TEST(TerrainQueryTest, TestSegmentcast)
+{
+    TerrainHeightmap terrain { makeTerrain() };
+    TerrainQuery query { terrain };
+    EXPECT_FALSE(query.segmentcast(Vector2D { 0.5f, 1.0f }, Vector2D { 1.5f, 7.5f }).hit);
+    RayHit hit { query.segmentcast(Vector2D { 0.5f, 1.0f }, Vector2D { 1.5f, 9.0f }) };
+    ASSERT_TRUE(hit.hit);
+    EXPECT_FLOAT_EQ(hit.point.getY(), 8.0f);
+    EXPECT_FALSE(query.segmentcast(Vector2D { 0.5f, 1.0f }, Vector2D { 0.5f, 1.0f }).hit);
+}
+
+TEST(TerrainQueryTest, TestRaysMatchMarchingOnGeneratedTerrain)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(9, 1000) };
+    TerrainHeightmap terrain {};
+    TerrainGenerator { config.seed }.generateTerrain(terrain, config, 4);
+    TerrainQuery query { terrain };
+
+    std::mt19937 rng { 1 };
+    std::uniform_real_distribution<float> xDist(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> yDist(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    size_t hits { 0 };
+    for (int i = 0; i < 200; i++)
+    {
+        Vector2D origin { xDist(rng), yDist(rng) };
+        float theta { angle(rng) };
+        Vector2D direction { std::cos(theta), std::sin(theta) };
+        float expected { marchReference(terrain, origin, direction, 800.0f) };
+        RayHit hit { query.raycast(origin, direction, 800.0f) };
+        ASSERT_EQ(hit.hit, expected >= 0.0f) << "ray " << i;
+        if (hit.hit)
+        {
+            EXPECT_NEAR(hit.distance, expected, 0.02f) << "ray " << i;
+            hits++;
+        }
+    }
+    EXPECT_GT(hits, 50u);
+}
+
+TEST(TerrainQueryTest, TestSweepBox)
+{
+    TerrainHeightmap terrain { makeTerrain() };
+    TerrainQuery query { terrain };
+
+    BoxHit hit { query.sweepBox(Vector2D { 0.25f, 0.0f }, 1.0f, 1.0f, Vector2D { 0.0f, 10.0f }) };
+    ASSERT_TRUE(hit.hit);
+    EXPECT_FLOAT_EQ(hit.time, 0.7f);
+    EXPECT_EQ(hit.column, 0u);
+    EXPECT_FALSE(hit.landingPad);
+
+    // the empty column can be fallen through, a box straddling it can not
+    EXPECT_FALSE(query.sweepBox(Vector2D { 4.0f, 0.0f }, 1.0f, 1.0f, Vector2D { 0.0f, 10.0f }).hit);
+    hit = query.sweepBox(Vector2D { 3.5f, 0.0f }, 1.0f, 1.0f, Vector2D { 0.0f, 10.0f });
+    ASSERT_TRUE(hit.hit);
+    EXPECT_EQ(hit.column, 3u);
+
+    // the pad is reached before the rock beside it
+    hit = query.sweepBox(Vector2D { 3.5f, 0.0f }, 2.0f, 1.0f, Vector2D { 0.0f, 10.0f });
+    ASSERT_TRUE(hit.hit);
+    EXPECT_FLOAT_EQ(hit.time, 0.5f);
+    EXPECT_TRUE(hit.landingPad);
+
+    // sideways into the spike
+    hit = query.sweepBox(Vector2D { 0.0f, 4.0f }, 1.0f, 1.0f, Vector2D { 5.0f, 0.0f });
+    ASSERT_TRUE(hit.hit);
+    EXPECT_FLOAT_EQ(hit.time, 0.2f);
+    EXPECT_EQ(hit.column, 2u);
+
+    // already touching
+    hit = query.sweepBox(Vector2D { 2.5f, 2.5f }, 1.0f, 1.0f, Vector2D { 0.0f, 0.0f });
+    ASSERT_TRUE(hit.hit);
+    EXPECT_FLOAT_EQ(hit.time, 0.0f);
+}
+
+TEST(TerrainQueryTest, TestSweepBoxInFixedPoint)
+{
+    TerrainHeightmap terrain { makeTerrain() };
+    TerrainQuery query { terrain };
+
+    // the same sweeps as above, exact to the last bit of the fraction
+    BasicBoxHit<Fixed> hit { query.sweepBox(FixedVector2D { Fixed { 0.25 }, 0 }, Fixed { 1 }, Fixed { 1 }, FixedVector2D { 0, 10 }) };
+    ASSERT_TRUE(hit.hit);
+    EXPECT_NEAR(toFloat(hit.time), 0.7f, 1e-6f);
+    EXPECT_EQ(hit.column, 0u);
+
+    EXPECT_FALSE(query.sweepBox(FixedVector2D { 4, 0 }, Fixed { 1 }, Fixed { 1 }, FixedVector2D { 0, 10 }).hit);
+
+    hit = query.sweepBox(FixedVector2D { Fixed { 3.5 }, 0 }, Fixed { 2 }, Fixed { 1 }, FixedVector2D { 0, 10 });
+    ASSERT_TRUE(hit.hit);
+    EXPECT_EQ(hit.time, Fixed { 0.5 });
+    EXPECT_TRUE(hit.landingPad);
+
+    hit = query.sweepBox(FixedVector2D { 0, 4 }, Fixed { 1 }, Fixed { 1 }, FixedVector2D { 5, 0 });
+    ASSERT_TRUE(hit.hit);
+    EXPECT_NEAR(toFloat(hit.time), 0.2f, 1e-6f);
+    EXPECT_EQ(hit.column, 2u);
+
+    // a miss reports the largest time there is
+    hit = query.sweepBox(FixedVector2D { 0, 0 }, Fixed { 1 }, Fixed { 1 }, FixedVector2D { 0, -5 });
+    EXPECT_FALSE(hit.hit);
+    EXPECT_EQ(hit.time, std::numeric_limits<Fixed>::max());
+}
+
+TEST(TerrainQueryTest, TestSweepBoxMatchesDenseSubsteps)
+{
+    TerrainGenerationConfig config { makeTestWorldConfig(9, 500) };
+    TerrainHeightmap terrain {};
+    TerrainGenerator { config.seed }.generateTerrain(terrain, config, 4);
+    TerrainQuery query { terrain };
+
+    std::mt19937 rng { 2 };
+    std::uniform_real_distribution<float> xDist(0.0f, 500.0f);
+    std::uniform_real_distribution<float> yDist(static_cast<float>(terrain.getMinSurface()) - 100.0f, static_cast<float>(terrain.getHeight()));
+    std::uniform_real_distribution<float> step(-200.0f, 200.0f);
+    constexpr int SUBSTEPS { 2000 };
+    size_t hits { 0 };
+    for (int i = 0; i < 400; i++)
+    {
+        Vector2D origin { xDist(rng), yDist(rng) };
+        Vector2D displacement { step(rng), step(rng) };
+        if (boxOverlaps(terrain, origin.getX(), origin.getY(), 24.0f, 24.0f))
+        {
+            continue;
+        }
+
+        float expected { -1.0f };
+        for (int k = 1; k <= SUBSTEPS; k++)
+        {
+            float t { static_cast<float>(k) / SUBSTEPS };
+            Vector2D position { origin + displacement * t };
+            if (boxOverlaps(terrain, position.getX(), position.getY(), 24.0f, 24.0f))
+            {
+                expected = t;
+                break;
+            }
+        }
+
+        BoxHit hit { query.sweepBox(origin, 24.0f, 24.0f, displacement) };
+        ASSERT_EQ(hit.hit, expected >= 0.0f) << "box " << i;
+        if (hit.hit)
+        {
+            // contact begins within the substep that first overlaps, or is a graze shorter than a substep
+            // that the substeps step over, when the box must overlap just after it
+            EXPECT_LE(hit.time, expected + 1e-4f) << "box " << i;
+            if (hit.time < expected - 1.0f / SUBSTEPS - 1e-4f)
+            {
+                Vector2D grazed { origin + displacement * (hit.time + 1e-5f) };
+                EXPECT_TRUE(boxOverlaps(terrain, grazed.getX(), grazed.getY(), 24.0f, 24.0f)) << "box " << i;
+            }
+            hits++;
+        }
+    }
+    EXPECT_GT(hits, 20u);
+}
@@ -0,0 +1,75 @@
+#include "engine/TiledTexture.h"
+#include <gtest/gtest.h>
+
+TEST(TiledTextureTest, TestViewInsideOneTile)
+{
+    std::vector<TileBlit> blits {};
+    TiledTexture::clipToTiles({ 10, 20, 100, 50 }, 1000, 1000, 512, blits);
+    ASSERT_EQ(blits.size(), 1u);
+    EXPECT_EQ(blits[0].tile, 0u);
+    EXPECT_EQ(blits[0].source.x, 10);
+    EXPECT_EQ(blits[0].source.y, 20);
+    EXPECT_EQ(blits[0].source.w, 100);
+    EXPECT_EQ(blits[0].source.h, 50);
+    EXPECT_EQ(blits[0].destination.x, 0);
+    EXPECT_EQ(blits[0].destination.y, 0);
+}
+
+TEST(TiledTextureTest, TestViewAcrossTileCorner)
+{
+    // 3 x 2 tiles, the view straddles the corner between tiles 1, 2, 4 and 5
+    std::vector<TileBlit> blits {};
+    TiledTexture::clipToTiles({ 900, 500, 200, 30 }, 1200, 700, 512, blits);
+    ASSERT_EQ(blits.size(), 4u);
+
+    EXPECT_EQ(blits[0].tile, 1u);
+    EXPECT_EQ(blits[0].source.x, 388);
+    EXPECT_EQ(blits[0].source.y, 500);
+    EXPECT_EQ(blits[0].source.w, 124);
+    EXPECT_EQ(blits[0].source.h, 12);
+
+    EXPECT_EQ(blits[1].tile, 2u);
+    EXPECT_EQ(blits[1].source.x, 0);
+    EXPECT_EQ(blits[1].source.w, 76);
+    EXPECT_EQ(blits[1].destination.x, 124);
+    EXPECT_EQ(blits[1].destination.y, 0);
+
+    EXPECT_EQ(blits[3].tile, 5u);
+    EXPECT_EQ(blits[3].source.x, 0);
+    EXPECT_EQ(blits[3].source.y, 0);
+    EXPECT_EQ(blits[3].source.h, 18);
+    EXPECT_EQ(blits[3].destination.x, 124);
+    EXPECT_EQ(blits[3].destination.y, 12);
+}
+
+TEST(TiledTextureTest, TestBlitsCoverTheVisibleArea)
+{
+    std::vector<TileBlit> blits {};
+    TiledTexture::clipToTiles({ -50, 300, 1350, 900 }, 13500, 1350, 512, blits);
+
+    // the view is clipped to the image on the left, everything else is on screen
+    long area { 0 };
+    for (const TileBlit& blit : blits)
+    {
+        area += static_cast<long>(blit.source.w) * blit.source.h;
+        EXPECT_GE(blit.destination.x, 50);
+    }
+    EXPECT_EQ(area, 1300L * 900L);
+    EXPECT_EQ(blits.size(), 3u * 3u);
+}
+
+TEST(TiledTextureTest, TestViewOutsideImage)
+{
+    std::vector<TileBlit> blits {};
+    TiledTexture::clipToTiles({ 2000, 0, 100, 100 }, 1000, 1000, 512, blits);
+    EXPECT_TRUE(blits.empty());
+}
+
+TEST(TiledTextureTest, TestFailedCreateKeepsNoTiles)
+{
+    // without a renderer no page can be created
+    TiledTexture texture { nullptr, 512 };
+    EXPECT_FALSE(texture.create(1000, 1000));
+    EXPECT_EQ(texture.getTileCount(), 0u);
+    EXPECT_EQ(texture.render({ 0, 0, 1000, 1000 }), 0u);
+}
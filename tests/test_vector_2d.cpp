@@ -1,4 +1,5 @@
 #include "engine/Vector2D.h"
+#include <cmath>
 #include <gtest/gtest.h>
 
 class Vector2DTest : public ::testing::Test
@@ -221,4 +222,46 @@ TEST_F(Vector2DTest, TestInPlaceDivideByFloat)
     otherVector /= 2.0f;
     EXPECT_NEAR(otherVector.getX(), 1.0f, 0.001f);
     EXPECT_NEAR(otherVector.getY(), 1.5f, 0.001f);
-}
\ No newline at end of file
+}
+
+TEST_F(Vector2DTest, TestConstexprArithmetic)
+{
+    constexpr Vector2D sum { Vector2D { 1.0f, 2.0f } + Vector2D { 3.0f, 4.0f } * 2.0f };
+    static_assert(sum.getX() == 7.0f && sum.getY() == 10.0f);
+    static_assert(Vector2D { 3.0f, 4.0f }.getMagnitudeSquared() == 25.0f);
+}
+
+TEST_F(Vector2DTest, TestSetMagnitudeMatchesTrigonometry)
+{
+    // rescaling by the ratio of magnitudes against going through the angle, as setMagnitude used to
+    for (int i = 0; i < 1000; i++)
+    {
+        float angle { static_cast<float>(i) * 0.37f };
+        float radians { angle * 3.14159265f / 180.0f };
+        float magnitude { 0.001f + static_cast<float>(i % 17) * 0.25f };
+        Vector2D vector { 2.0f * std::sin(radians), -2.0f * std::cos(radians) };
+        vector.setMagnitude(magnitude);
+        EXPECT_NEAR(vector.getX(), magnitude * std::sin(radians), 1e-5f * (1.0f + magnitude));
+        EXPECT_NEAR(vector.getY(), -magnitude * std::cos(radians), 1e-5f * (1.0f + magnitude));
+    }
+}
+
+TEST_F(Vector2DTest, TestHeadingMatchesRotateTo)
+{
+    for (int degrees = 0; degrees < 360; degrees++)
+    {
+        Vector2D rotated { 0.0f, -1.0f };
+        rotated.rotateTo(static_cast<float>(degrees));
+        const Vector2D& heading { Vector2D::heading(degrees) };
+        EXPECT_NEAR(heading.getX(), rotated.getX(), 1e-6f) << degrees;
+        EXPECT_NEAR(heading.getY(), rotated.getY(), 1e-6f) << degrees;
+        EXPECT_NEAR(heading.getMagnitude(), 1.0f, 1e-6f) << degrees;
+    }
+
+    // the quarter turns are exact
+    EXPECT_EQ(Vector2D::heading(0).getX(), 0.0f);
+    EXPECT_EQ(Vector2D::heading(0).getY(), -1.0f);
+    EXPECT_EQ(Vector2D::heading(90).getX(), 1.0f);
+    EXPECT_EQ(Vector2D::heading(90).getY(), 0.0f);
+    EXPECT_EQ(Vector2D::heading(270).getX(), -1.0f);
+}
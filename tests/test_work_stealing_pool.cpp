@@ -0,0 +1,85 @@
+#include "engine/ParallelFor.h"
+#include "engine/WorkStealingPool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST(WorkStealingPoolTest, TestEveryIndexRunsOnce)
+{
+    WorkStealingPool pool { 4 };
+    ASSERT_EQ(pool.size(), 4u);
+    for (size_t count : { 0u, 1u, 3u, 1000u })
+    {
+        std::vector<std::atomic<int>> runs(count);
+        std::atomic<bool> badWorker { false };
+        pool.run(count, [&](const size_t index, const size_t worker) {
+            runs[index]++;
+            badWorker = badWorker || worker >= pool.size();
+        });
+        for (size_t i = 0; i < count; i++)
+        {
+            ASSERT_EQ(runs[i].load(), 1) << "count " << count << " index " << i;
+        }
+        EXPECT_FALSE(badWorker);
+    }
+}
+
+TEST(WorkStealingPoolTest, TestIdleWorkersStealFromABusyOne)
+{
+    // every slow item starts in worker 0's share, the others only get them by stealing
+    WorkStealingPool pool { 4 };
+    constexpr size_t COUNT { 64 };
+    std::vector<size_t> ranBy(COUNT);
+    pool.run(COUNT, [&](const size_t index, const size_t worker) {
+        if (index < COUNT / 4)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        ranBy[index] = worker;
+    });
+
+    EXPECT_GT(pool.getStealCount(), 0u);
+    size_t slowOnOthers { 0 };
+    for (size_t i = 0; i < COUNT / 4; i++)
+    {
+        slowOnOthers += ranBy[i] != 0 ? 1u : 0u;
+    }
+    EXPECT_GT(slowOnOthers, 0u);
+}
+
+TEST(WorkStealingPoolTest, TestPerWorkerStateNeedsNoLocks)
+{
+    WorkStealingPool pool { 3 };
+    std::vector<size_t> sums(pool.size());
+    for (int run = 0; run < 20; run++)
+    {
+        pool.run(500, [&](const size_t index, const size_t worker) { sums[worker] += index; });
+    }
+    size_t total { 0 };
+    for (size_t sum : sums)
+    {
+        total += sum;
+    }
+    EXPECT_EQ(total, 20u * (499u * 500u / 2u));
+}
+
+TEST(WorkStealingPoolTest, TestParallelForInsideAnItemStaysOnItsWorker)
+{
+    WorkStealingPool pool { 3 };
+    std::vector<size_t> otherThreads(pool.size());
+    pool.run(6, [&](const size_t, const size_t worker) {
+        std::thread::id self { std::this_thread::get_id() };
+        parallelFor(0, 1 << 16, [&](const size_t, const size_t) {
+            otherThreads[worker] += std::this_thread::get_id() != self ? 1u : 0u;
+        }, 1);
+    });
+    for (size_t count : otherThreads)
+    {
+        EXPECT_EQ(count, 0u);
+    }
+
+    // outside a run parallelFor spreads out again
+    EXPECT_FALSE(tParallelForInline);
+}